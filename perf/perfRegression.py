@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""Performance regression suite over the examples.
+
+Each case of cases.txt is run for a fixed number of steps with a fixed number of OpenMP threads. The
+telemetry of the run and a mass extractor give a normalised record (steps/s, time per step of each phase,
+peak RSS, initial and final mass) which is compared against a stored baseline with tolerance bands.
+
+Must be run from the repository root (the mesh paths of the examples are relative to it):
+    python3 perf/perfRegression.py --pfem build/bin/pfem [--case damBreak2DIncomp] [--update-baseline]
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+PHASES = ["remeshTime", "assemblyTime", "solveTime", "bcTime", "extractionTime"]
+
+DEFAULT_TOLERANCES = {
+    "mass": 1e-3,           # relative difference of the final mass
+    "stepsPerSecond": 0.15, # relative slowdown
+    "phase": 0.25,          # relative increase of the time per step of a phase
+    "phaseFloor": 1e-4,     # absolute increase (s) under which a phase is never flagged
+    "peakRSS": 0.20         # relative increase of the peak memory
+}
+
+
+def readCases(fileName):
+    cases = {}
+    with open(fileName) as file:
+        for line in file:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+
+            name, luaFile, steps = line.split()
+            cases[name] = {"luaFile": luaFile, "steps": int(steps)}
+
+    return cases
+
+
+def ensureMesh(luaFile):
+    """Generate the .msh file of an example from its .geo file if it does not exist yet."""
+    with open(luaFile) as file:
+        match = re.search(r'mshFile\s*=\s*"([^"]+)"', file.read())
+
+    if match is None:
+        raise RuntimeError("no mshFile in " + luaFile)
+
+    mshFile = match.group(1)
+    if os.path.exists(mshFile):
+        return
+
+    geoFile = os.path.splitext(mshFile)[0] + ".geo"
+    if not os.path.exists(geoFile):
+        raise RuntimeError("neither " + mshFile + " nor " + geoFile + " exist")
+
+    gmsh = shutil.which("gmsh")
+    if gmsh is None:
+        raise RuntimeError(mshFile + " does not exist and gmsh is not in the PATH to generate it")
+
+    dim = "-3" if "/3D/" in luaFile.replace("\\", "/") else "-2"
+    subprocess.run([gmsh, geoFile, dim, "-format", "msh41", "-bin", "-o", mshFile],
+                   check=True, stdout=subprocess.DEVNULL)
+
+
+def luaString(text):
+    return json.dumps(text.replace("\\", "/"))
+
+
+def writeWrapper(case, workDir):
+    """Write a lua file which loads the example and overrides its run length, outputs and extractors."""
+    wrapperFile = os.path.join(workDir, "problem.lua")
+    with open(wrapperFile, "w") as file:
+        file.write("dofile(" + luaString(case["luaFile"]) + ")\n"
+                   "Problem.verboseOutput = false\n"
+                   "Problem.maxSteps = " + str(case["steps"]) + "\n"
+                   "Problem.telemetryFile = " + luaString(os.path.join(workDir, "telemetry.ndjson")) + "\n"
+                   "Problem.telemetryFormat = \"NDJSON\"\n"
+                   "Problem.profileFile = " + luaString(os.path.join(workDir, "profile.json")) + "\n"
+                   "Problem.checkpointFile = nil\n"
+                   "Problem.Extractors = {{kind = \"Mass\", outputFile = " +
+                   luaString(os.path.join(workDir, "mass.txt")) + ", timeBetweenWriting = 0}}\n")
+
+    return wrapperFile
+
+
+def readMass(fileName):
+    """Return the first and last mass written by the mass extractor (CSV rows: time,mass)."""
+    with open(fileName) as file:
+        rows = [line.strip().split(",") for line in file if line.strip()]
+
+    if not rows:
+        raise RuntimeError("the mass extractor did not write anything")
+
+    return float(rows[0][1]), float(rows[-1][1])
+
+
+def runCase(name, case, pfem, threads, outputDir):
+    workDir = os.path.abspath(os.path.join(outputDir, name))
+    os.makedirs(workDir, exist_ok=True)
+
+    ensureMesh(case["luaFile"])
+    wrapperFile = writeWrapper(case, workDir)
+
+    env = dict(os.environ)
+    env["OMP_NUM_THREADS"] = str(threads)
+
+    start = time.perf_counter()
+    with open(os.path.join(workDir, "log.txt"), "w") as log:
+        result = subprocess.run([pfem, wrapperFile], stdout=log, stderr=subprocess.STDOUT, env=env)
+    wallTime = time.perf_counter() - start
+
+    if result.returncode != 0:
+        raise RuntimeError("pfem failed with code " + str(result.returncode) + ", see " +
+                           os.path.join(workDir, "log.txt"))
+
+    with open(os.path.join(workDir, "telemetry.ndjson")) as file:
+        records = [json.loads(line) for line in file if line.strip()]
+
+    if not records:
+        raise RuntimeError("the telemetry is empty")
+
+    attempts = len(records)
+    steps = sum(1 for record in records if record["accepted"])
+    stepsTime = sum(record["stepTime"] for record in records)
+    initialMass, finalMass = readMass(os.path.join(workDir, "mass.txt"))
+
+    return {
+        "threads": threads,
+        "steps": steps,
+        "rejectedSteps": attempts - steps,
+        "simulationTime": records[-1]["time"],
+        "wallTime": wallTime,
+        "stepsPerSecond": steps/stepsTime if stepsTime > 0 else 0.0,
+        "phases": {phase: sum(record[phase] for record in records)/attempts for phase in PHASES},
+        "peakRSS": max(record["peakRss"] for record in records),
+        "finalNodes": records[-1]["nodes"],
+        "initialMass": initialMass,
+        "finalMass": finalMass
+    }
+
+
+def compare(record, baseline, tolerances):
+    """Return the list of regressions of a record with respect to its baseline."""
+    failures = []
+
+    if record["steps"] != baseline["steps"]:
+        failures.append("steps: %d vs %d in the baseline" % (record["steps"], baseline["steps"]))
+
+    massDiff = abs(record["finalMass"] - baseline["finalMass"])/max(abs(baseline["finalMass"]), 1e-300)
+    if massDiff > tolerances["mass"]:
+        failures.append("final mass drift: %.6g vs %.6g (%.3g > %.3g)" %
+                        (record["finalMass"], baseline["finalMass"], massDiff, tolerances["mass"]))
+
+    if record["stepsPerSecond"] < baseline["stepsPerSecond"]*(1 - tolerances["stepsPerSecond"]):
+        failures.append("slowdown: %.4g steps/s vs %.4g" % (record["stepsPerSecond"], baseline["stepsPerSecond"]))
+
+    for phase in PHASES:
+        current = record["phases"][phase]
+        reference = baseline["phases"][phase]
+        if current > reference*(1 + tolerances["phase"]) and current - reference > tolerances["phaseFloor"]:
+            failures.append("%s: %.4g s/step vs %.4g" % (phase, current, reference))
+
+    if record["peakRSS"] > baseline["peakRSS"]*(1 + tolerances["peakRSS"]):
+        failures.append("peak RSS: %.1f MB vs %.1f" % (record["peakRSS"]/2**20, baseline["peakRSS"]/2**20))
+
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--pfem", required=True, help="path to the pfem executable")
+    parser.add_argument("--case", action="append", help="case to run (all the cases of cases.txt by default)")
+    parser.add_argument("--threads", type=int, default=4, help="number of OpenMP threads (default: 4)")
+    parser.add_argument("--cases", default=os.path.join(SCRIPT_DIR, "cases.txt"), help="cases file")
+    parser.add_argument("--baseline", default=os.path.join(SCRIPT_DIR, "baseline.json"), help="baseline file")
+    parser.add_argument("--output", default="perfResults", help="directory of the runs outputs and records")
+    parser.add_argument("--update-baseline", action="store_true",
+                        help="store the records of the run cases as the new baseline instead of comparing")
+    args = parser.parse_args()
+
+    cases = readCases(args.cases)
+    names = args.case if args.case else list(cases)
+    for name in names:
+        if name not in cases:
+            sys.exit("unknown case " + name + "!")
+
+    baseline = {"tolerances": DEFAULT_TOLERANCES, "cases": {}}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as file:
+            baseline = json.load(file)
+    tolerances = dict(DEFAULT_TOLERANCES, **baseline.get("tolerances", {}))
+
+    records = {}
+    failed = False
+    for name in names:
+        print("Running " + name + " (" + str(cases[name]["steps"]) + " steps, " + str(args.threads) + " threads)",
+              flush=True)
+        try:
+            records[name] = runCase(name, cases[name], os.path.abspath(args.pfem), args.threads, args.output)
+        except (RuntimeError, OSError, subprocess.CalledProcessError) as e:
+            print("  FAILED: " + str(e))
+            failed = True
+            continue
+
+        record = records[name]
+        print("  %.4g steps/s, peak RSS %.1f MB, final mass %.8g" %
+              (record["stepsPerSecond"], record["peakRSS"]/2**20, record["finalMass"]))
+
+        if args.update_baseline:
+            continue
+
+        reference = baseline["cases"].get(name)
+        if reference is None:
+            print("  no baseline for this case (run with --update-baseline to store one)")
+        elif reference["threads"] != record["threads"]:
+            print("  the baseline was recorded with %d threads, not compared" % reference["threads"])
+        else:
+            failures = compare(record, reference, tolerances)
+            for failure in failures:
+                print("  REGRESSION: " + failure)
+            failed = failed or bool(failures)
+
+    os.makedirs(args.output, exist_ok=True)
+    with open(os.path.join(args.output, "records.json"), "w") as file:
+        json.dump(records, file, indent=4)
+
+    if args.update_baseline:
+        baseline["tolerances"] = tolerances
+        baseline["cases"].update(records)
+        with open(args.baseline, "w") as file:
+            json.dump(baseline, file, indent=4)
+            file.write("\n")
+        print("Baseline written to " + args.baseline)
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,157 @@
+#include "SyntheticSystem.hpp"
+
+#include <algorithm>
+
+template<unsigned short dim>
+static void benchElementMatrices(benchmark::State& state)
+{
+    constexpr unsigned short nodPerEl = dim + 1;
+    SyntheticSystem<dim> system(static_cast<std::size_t>(state.range(0)));
+    const Mesh& mesh = system.getMesh();
+    MatrixBuilder<dim>& matBuilder = system.getMatrixBuilder();
+    const std::size_t nElm = mesh.getElementsCount();
+
+    for(auto _ : state)
+    {
+        double checksum = 0;
+
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared) reduction(+:checksum)
+        for(std::size_t elm = 0 ; elm < nElm ; ++elm)
+        {
+            const Element& element = mesh.getElement(elm);
+            GradNmatType<dim> gradNe = matBuilder.getGradN(element);
+            BmatType<dim> Be = matBuilder.getB(gradNe);
+            Eigen::Matrix<double, nodPerEl, nodPerEl> Me = matBuilder.getM(element);
+            Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Ke = matBuilder.getK(element, Be);
+            Eigen::Matrix<double, nodPerEl, dim*nodPerEl> De = matBuilder.getD(element, Be);
+
+            checksum += Me(0, 0) + Ke(0, 0) + De(0, 0);
+        }
+
+        benchmark::DoNotOptimize(checksum);
+    }
+
+    state.counters["elements"] = static_cast<double>(nElm);
+    state.SetItemsProcessed(state.iterations()*static_cast<std::int64_t>(nElm));
+}
+
+template<unsigned short dim>
+static void benchPSPGTriplets(benchmark::State& state)
+{
+    SyntheticSystem<dim> system(static_cast<std::size_t>(state.range(0)));
+    std::vector<Eigen::Triplet<double>> indexA;
+
+    for(auto _ : state)
+    {
+        system.computePSPGTriplets(indexA);
+        benchmark::DoNotOptimize(indexA.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["elements"] = static_cast<double>(system.getMesh().getElementsCount());
+    state.SetItemsProcessed(state.iterations()*
+                            static_cast<std::int64_t>(system.getMesh().getElementsCount()));
+}
+
+template<unsigned short dim>
+static std::vector<Eigen::Triplet<double>> getPSPGTriplets(SyntheticSystem<dim>& system)
+{
+    std::vector<Eigen::Triplet<double>> indexA;
+    system.computePSPGTriplets(indexA);
+    system.addDirichletTriplets(indexA);
+    return indexA;
+}
+
+/// \brief Reference assembly of the global matrix (what the equations do at each time step).
+template<unsigned short dim>
+static void benchSetFromTriplets(benchmark::State& state)
+{
+    SyntheticSystem<dim> system(static_cast<std::size_t>(state.range(0)));
+    const std::vector<Eigen::Triplet<double>> indexA = getPSPGTriplets(system);
+    Eigen::SparseMatrix<double> A(system.getSystemSize(), system.getSystemSize());
+
+    for(auto _ : state)
+    {
+        A.setFromTriplets(indexA.begin(), indexA.end());
+        benchmark::DoNotOptimize(A.valuePtr());
+    }
+
+    state.counters["triplets"] = static_cast<double>(indexA.size());
+    state.counters["nnz"] = static_cast<double>(A.nonZeros());
+}
+
+/// \brief Assembly by insertion in a matrix whose columns were reserved from the exact number of triplets.
+template<unsigned short dim>
+static void benchReservedInsert(benchmark::State& state)
+{
+    SyntheticSystem<dim> system(static_cast<std::size_t>(state.range(0)));
+    const std::vector<Eigen::Triplet<double>> indexA = getPSPGTriplets(system);
+
+    Eigen::VectorXi tripletsPerColumn = Eigen::VectorXi::Zero(static_cast<Eigen::Index>(system.getSystemSize()));
+    for(const auto& triplet : indexA)
+        tripletsPerColumn[triplet.col()]++;
+
+    Eigen::SparseMatrix<double> A(system.getSystemSize(), system.getSystemSize());
+    for(auto _ : state)
+    {
+        A.setZero();
+        A.reserve(tripletsPerColumn);
+        for(const auto& triplet : indexA)
+            A.coeffRef(triplet.row(), triplet.col()) += triplet.value();
+        A.makeCompressed();
+
+        benchmark::DoNotOptimize(A.valuePtr());
+    }
+
+    state.counters["triplets"] = static_cast<double>(indexA.size());
+    state.counters["nnz"] = static_cast<double>(A.nonZeros());
+}
+
+/// \brief Assembly which reuses the sparsity pattern of the previous step: each triplet is scattered to its
+///        precomputed position in the values array (only valid while the connectivity does not change).
+template<unsigned short dim>
+static void benchPatternReuse(benchmark::State& state)
+{
+    SyntheticSystem<dim> system(static_cast<std::size_t>(state.range(0)));
+    const std::vector<Eigen::Triplet<double>> indexA = getPSPGTriplets(system);
+
+    Eigen::SparseMatrix<double> A(system.getSystemSize(), system.getSystemSize());
+    A.setFromTriplets(indexA.begin(), indexA.end());
+    A.makeCompressed();
+
+    std::vector<Eigen::Index> valueIndex(indexA.size());
+    for(std::size_t t = 0 ; t < indexA.size() ; ++t)
+    {
+        const int* pBegin = A.innerIndexPtr() + A.outerIndexPtr()[indexA[t].col()];
+        const int* pEnd = A.innerIndexPtr() + A.outerIndexPtr()[indexA[t].col() + 1];
+        valueIndex[t] = std::lower_bound(pBegin, pEnd, indexA[t].row()) - A.innerIndexPtr();
+    }
+
+    for(auto _ : state)
+    {
+        double* pValues = A.valuePtr();
+        std::fill(pValues, pValues + A.nonZeros(), 0.0);
+        for(std::size_t t = 0 ; t < indexA.size() ; ++t)
+            pValues[valueIndex[t]] += indexA[t].value();
+
+        benchmark::DoNotOptimize(A.valuePtr());
+    }
+
+    state.counters["triplets"] = static_cast<double>(indexA.size());
+    state.counters["nnz"] = static_cast<double>(A.nonZeros());
+}
+
+void registerAssemblyBenchmarks(const std::vector<std::size_t>& sizes2D, const std::vector<std::size_t>& sizes3D)
+{
+    registerSizedBenchmark("MatrixBuilder/getM_getK_getD/2D", benchElementMatrices<2>, sizes2D);
+    registerSizedBenchmark("MatrixBuilder/getM_getK_getD/3D", benchElementMatrices<3>, sizes3D);
+    registerSizedBenchmark("Assembly/PSPGTriplets/2D", benchPSPGTriplets<2>, sizes2D);
+    registerSizedBenchmark("Assembly/PSPGTriplets/3D", benchPSPGTriplets<3>, sizes3D);
+    registerSizedBenchmark("Assembly/setFromTriplets/2D", benchSetFromTriplets<2>, sizes2D);
+    registerSizedBenchmark("Assembly/setFromTriplets/3D", benchSetFromTriplets<3>, sizes3D);
+    registerSizedBenchmark("Assembly/reservedInsert/2D", benchReservedInsert<2>, sizes2D);
+    registerSizedBenchmark("Assembly/reservedInsert/3D", benchReservedInsert<3>, sizes3D);
+    registerSizedBenchmark("Assembly/patternReuse/2D", benchPatternReuse<2>, sizes2D);
+    registerSizedBenchmark("Assembly/patternReuse/3D", benchPatternReuse<3>, sizes3D);
+}
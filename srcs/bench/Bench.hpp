@@ -0,0 +1,72 @@
+#pragma once
+#ifndef BENCH_HPP_INCLUDED
+#define BENCH_HPP_INCLUDED
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../mesh/Mesh.hpp"
+
+class Problem;
+
+/**
+ * \brief Parameters of the synthetic cloud of the benchmarks: a block of fluid filling a unit box, generated by
+ *        Mesh (shape "box"). The nodes of the walls and of the bottom are fixed boundary nodes.
+ * \param dim The dimension of the cloud (2 or 3).
+ * \param nodesCount The approximate number of nodes.
+ * \return The parameters of the synthetic cloud (same seed for every run so that the results can be compared).
+ */
+SyntheticMeshInfo getSyntheticInfos(unsigned short dim, std::size_t nodesCount);
+
+/// \return The parameters of the mesh of the synthetic cloud (alpha, omega and gamma of a dam break).
+MeshCreateInfo getSyntheticMeshInfos(unsigned short dim, std::size_t nodesCount);
+
+/// \return A mesh triangulated from the synthetic cloud.
+std::unique_ptr<Mesh> makeSyntheticMesh(unsigned short dim, std::size_t nodesCount);
+
+/**
+ * \brief Write a lua file describing an incompressible flow problem (PSPG solver, without extractors) on the
+ *        synthetic cloud (Synthetic table of the Mesh), then load the problem.
+ * \param dim The dimension of the problem (2 or 3).
+ * \param nodesCount The approximate number of nodes.
+ * \return The problem.
+ */
+std::unique_ptr<Problem> makeSyntheticProblem(unsigned short dim, std::size_t nodesCount);
+
+/// \brief Remove the files written by makeSyntheticProblem.
+void removeSyntheticFiles();
+
+/**
+ * \brief Register a benchmark run once per cloud size (the size is available as state.range(0)).
+ * \param name The name of the benchmark.
+ * \param func The benchmark function.
+ * \param sizes The approximate numbers of nodes of the clouds.
+ */
+template<typename Func>
+void registerSizedBenchmark(const std::string& name, Func func, const std::vector<std::size_t>& sizes)
+{
+    benchmark::internal::Benchmark* pBenchmark = benchmark::RegisterBenchmark(name.c_str(), func);
+    for(std::size_t size : sizes)
+        pBenchmark->Arg(static_cast<std::int64_t>(size));
+
+    //The kernels are parallelised with OpenMP, the CPU time of the main thread is meaningless
+    pBenchmark->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+/// \brief Register the Mesh benchmarks (remesh, triangulation, nodes update).
+void registerMeshBenchmarks(const std::vector<std::size_t>& sizes2D, const std::vector<std::size_t>& sizes3D);
+
+/// \brief Register the element matrices and global assembly benchmarks.
+void registerAssemblyBenchmarks(const std::vector<std::size_t>& sizes2D, const std::vector<std::size_t>& sizes3D);
+
+/// \brief Register the sparse linear solvers benchmarks.
+void registerSolverBenchmarks(const std::vector<std::size_t>& sizes2D, const std::vector<std::size_t>& sizes3D);
+
+/// \brief Register the benchmarks which require a full problem (mesh smoothing, extraction).
+void registerProblemBenchmarks(const std::vector<std::size_t>& sizes2D, const std::vector<std::size_t>& sizes3D);
+
+#endif // BENCH_HPP_INCLUDED
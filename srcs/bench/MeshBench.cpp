@@ -0,0 +1,73 @@
+#include "Bench.hpp"
+
+/// \brief Generation, triangulation and alpha-shape of the synthetic cloud (building a mesh is dominated by the
+///        triangulation).
+template<unsigned short dim>
+static void benchTriangulateAlphaShape(benchmark::State& state)
+{
+    const std::size_t nodesCount = static_cast<std::size_t>(state.range(0));
+    const SyntheticMeshInfo syntheticInfos = getSyntheticInfos(dim, nodesCount);
+    const MeshCreateInfo meshInfos = getSyntheticMeshInfos(dim, nodesCount);
+
+    std::size_t elementsCount = 0;
+    for(auto _ : state)
+    {
+        Mesh mesh(meshInfos, syntheticInfos);
+        elementsCount = mesh.getElementsCount();
+        benchmark::DoNotOptimize(elementsCount);
+    }
+
+    state.counters["elements"] = static_cast<double>(elementsCount);
+    state.SetItemsProcessed(state.iterations()*static_cast<std::int64_t>(elementsCount));
+}
+
+template<unsigned short dim>
+static void benchRemesh(benchmark::State& state)
+{
+    const std::size_t nodesCount = static_cast<std::size_t>(state.range(0));
+
+    std::size_t remeshedNodesCount = 0;
+    for(auto _ : state)
+    {
+        //The remeshing modifies the mesh, each iteration starts from the same one
+        state.PauseTiming();
+        std::unique_ptr<Mesh> pMesh = makeSyntheticMesh(dim, nodesCount);
+        state.ResumeTiming();
+
+        pMesh->remesh(false);
+        remeshedNodesCount = pMesh->getNodesCount();
+    }
+
+    state.counters["nodes"] = static_cast<double>(remeshedNodesCount);
+}
+
+template<unsigned short dim>
+static void benchUpdateNodesPosition(benchmark::State& state)
+{
+    std::unique_ptr<Mesh> pMesh = makeSyntheticMesh(dim, static_cast<std::size_t>(state.range(0)));
+
+    //The nodes go back and forth so that the mesh does not degenerate
+    const double delta = 1e-3*pMesh->getHchar();
+    std::vector<double> forward(dim*pMesh->getNodesCount(), delta);
+    std::vector<double> backward(dim*pMesh->getNodesCount(), -delta);
+
+    bool isForward = true;
+    for(auto _ : state)
+    {
+        pMesh->updateNodesPosition(isForward ? forward : backward);
+        isForward = !isForward;
+    }
+
+    state.counters["nodes"] = static_cast<double>(pMesh->getNodesCount());
+    state.SetItemsProcessed(state.iterations()*static_cast<std::int64_t>(pMesh->getNodesCount()));
+}
+
+void registerMeshBenchmarks(const std::vector<std::size_t>& sizes2D, const std::vector<std::size_t>& sizes3D)
+{
+    registerSizedBenchmark("Mesh/triangulateAlphaShape/2D", benchTriangulateAlphaShape<2>, sizes2D);
+    registerSizedBenchmark("Mesh/triangulateAlphaShape/3D", benchTriangulateAlphaShape<3>, sizes3D);
+    registerSizedBenchmark("Mesh/remesh/2D", benchRemesh<2>, sizes2D);
+    registerSizedBenchmark("Mesh/remesh/3D", benchRemesh<3>, sizes3D);
+    registerSizedBenchmark("Mesh/updateNodesPosition/2D", benchUpdateNodesPosition<2>, sizes2D);
+    registerSizedBenchmark("Mesh/updateNodesPosition/3D", benchUpdateNodesPosition<3>, sizes3D);
+}
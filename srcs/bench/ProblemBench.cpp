@@ -0,0 +1,62 @@
+#include "Bench.hpp"
+
+#include <cstdio>
+
+#include "../simulation/Problem.hpp"
+#include "../simulation/extractors/GMSHExtractor.hpp"
+#include "../simulation/meshSmoother/GETMe.hpp"
+
+template<unsigned short dim>
+static void benchGETMe(benchmark::State& state)
+{
+    const std::size_t nodesCount = static_cast<std::size_t>(state.range(0));
+    std::unique_ptr<Problem> pProblem = makeSyntheticProblem(dim, nodesCount);
+
+    for(auto _ : state)
+    {
+        //The smoothing moves the nodes, each iteration starts from the same mesh
+        state.PauseTiming();
+        std::unique_ptr<Mesh> pMesh = makeSyntheticMesh(dim, nodesCount);
+        GETMe<dim> smoother(pProblem.get(), *pMesh, 20, 0.01);
+        state.ResumeTiming();
+
+        smoother.smooth(false);
+    }
+
+    state.counters["nodes"] = static_cast<double>(pProblem->getMesh().getNodesCount());
+}
+
+static const char* const resultFileName = "pfem_bench_results_0.000000.msh";
+
+/// \brief Synchronous write of the velocity, pressure and kinetic energy of every node (mesh and data).
+template<unsigned short dim>
+static void benchGMSHExtractor(benchmark::State& state)
+{
+    std::unique_ptr<Problem> pProblem = makeSyntheticProblem(dim, static_cast<std::size_t>(state.range(0)));
+
+    std::vector<std::string> whatToWrite = {"u", "v", "p", "ke"};
+    if(dim == 3)
+        whatToWrite.push_back("w");
+
+    GMSHExtractor extractor(pProblem.get(), "pfem_bench_results.msh", 1, whatToWrite, "NodesElements", false);
+    for(auto _ : state)
+    {
+        extractor.update(true);
+
+        //The views are appended to the file of the current time, which would grow at each iteration
+        state.PauseTiming();
+        std::remove(resultFileName);
+        state.ResumeTiming();
+    }
+
+    state.counters["nodes"] = static_cast<double>(pProblem->getMesh().getNodesCount());
+    state.counters["elements"] = static_cast<double>(pProblem->getMesh().getElementsCount());
+}
+
+void registerProblemBenchmarks(const std::vector<std::size_t>& sizes2D, const std::vector<std::size_t>& sizes3D)
+{
+    registerSizedBenchmark("GETMe/smooth/2D", benchGETMe<2>, sizes2D);
+    registerSizedBenchmark("GETMe/smooth/3D", benchGETMe<3>, sizes3D);
+    registerSizedBenchmark("GMSHExtractor/update/2D", benchGMSHExtractor<2>, sizes2D);
+    registerSizedBenchmark("GMSHExtractor/update/3D", benchGMSHExtractor<3>, sizes3D);
+}
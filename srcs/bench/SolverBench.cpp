@@ -0,0 +1,68 @@
+#include "SyntheticSystem.hpp"
+
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseLU>
+
+//Same solvers as the incompressible equations
+typedef Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> EigenSparseSolver;
+typedef Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper> EigenIterativeSolver;
+
+/// \brief Symbolic analysis, factorization and solve of the PSPG system, as done at each non-linear iteration.
+template<unsigned short dim>
+static void benchSparseLU(benchmark::State& state)
+{
+    SyntheticSystem<dim> system(static_cast<std::size_t>(state.range(0)));
+    Eigen::SparseMatrix<double> A = system.buildPSPGMatrix();
+    A.makeCompressed();
+    const Eigen::VectorXd b = Eigen::VectorXd::Ones(A.rows());
+
+    EigenSparseSolver solver;
+    for(auto _ : state)
+    {
+        solver.analyzePattern(A);
+        solver.factorize(A);
+        Eigen::VectorXd x = solver.solve(b);
+        benchmark::DoNotOptimize(x.data());
+    }
+
+    if(solver.info() != Eigen::Success)
+        state.SkipWithError("the factorization of the PSPG matrix failed");
+
+    state.counters["rows"] = static_cast<double>(A.rows());
+    state.counters["nnz"] = static_cast<double>(A.nonZeros());
+}
+
+/// \brief Preconditioned conjugate gradient on the pressure Laplacian (fractional step equations).
+template<unsigned short dim>
+static void benchConjugateGradient(benchmark::State& state)
+{
+    SyntheticSystem<dim> system(static_cast<std::size_t>(state.range(0)));
+    const Eigen::SparseMatrix<double> L = system.buildLaplacianMatrix();
+    const Eigen::VectorXd b = Eigen::VectorXd::Ones(L.rows());
+
+    EigenIterativeSolver solver;
+    solver.setTolerance(1e-9);
+
+    long iterations = 0;
+    for(auto _ : state)
+    {
+        solver.compute(L);
+        Eigen::VectorXd x = solver.solve(b);
+        iterations = solver.iterations();
+        benchmark::DoNotOptimize(x.data());
+    }
+
+    if(solver.info() != Eigen::Success)
+        state.SkipWithError("the conjugate gradient did not converge");
+
+    state.counters["rows"] = static_cast<double>(L.rows());
+    state.counters["iterations"] = static_cast<double>(iterations);
+}
+
+void registerSolverBenchmarks(const std::vector<std::size_t>& sizes2D, const std::vector<std::size_t>& sizes3D)
+{
+    registerSizedBenchmark("Solver/SparseLU/2D", benchSparseLU<2>, sizes2D);
+    registerSizedBenchmark("Solver/SparseLU/3D", benchSparseLU<3>, sizes3D);
+    registerSizedBenchmark("Solver/ConjugateGradient/2D", benchConjugateGradient<2>, sizes2D);
+    registerSizedBenchmark("Solver/ConjugateGradient/3D", benchConjugateGradient<3>, sizes3D);
+}
@@ -0,0 +1,131 @@
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../simulation/physics/Problems.hpp"
+
+static const char* const luaFileName = "pfem_bench_problem.lua";
+
+/// \return The values as the content of a lua table.
+static std::string toLuaList(const std::vector<double>& values)
+{
+    std::ostringstream list;
+    list.precision(17);
+    for(std::size_t i = 0 ; i < values.size() ; ++i)
+        list << (i == 0 ? "" : ", ") << values[i];
+
+    return list.str();
+}
+
+SyntheticMeshInfo getSyntheticInfos(unsigned short dim, std::size_t nodesCount)
+{
+    SyntheticMeshInfo syntheticInfos;
+    syntheticInfos.shape = "box";
+    syntheticInfos.dim = dim;
+    syntheticInfos.nodesCount = nodesCount;
+    syntheticInfos.tankSize = std::vector<double>(dim, 1.0);
+    syntheticInfos.fluidSize = {1.0};
+    syntheticInfos.jitter = 0.1;
+    syntheticInfos.seed = 42;
+
+    return syntheticInfos;
+}
+
+MeshCreateInfo getSyntheticMeshInfos(unsigned short dim, std::size_t nodesCount)
+{
+    MeshCreateInfo meshInfos;
+    meshInfos.hchar = Mesh::getSyntheticSpacing(getSyntheticInfos(dim, nodesCount));
+    meshInfos.alpha = 1.2;
+    meshInfos.omega = 0.7;
+    meshInfos.gamma = 0.2;
+    meshInfos.addOnFS = false;
+    meshInfos.deleteFlyingNodes = true;
+
+    if(dim == 2)
+        meshInfos.boundingBox = {-0.1, -0.1, 1.1, 10};
+    else
+        meshInfos.boundingBox = {-0.1, -0.1, -0.1, 1.1, 1.1, 10};
+
+    return meshInfos;
+}
+
+std::unique_ptr<Mesh> makeSyntheticMesh(unsigned short dim, std::size_t nodesCount)
+{
+    return std::make_unique<Mesh>(getSyntheticMeshInfos(dim, nodesCount), getSyntheticInfos(dim, nodesCount));
+}
+
+std::unique_ptr<Problem> makeSyntheticProblem(unsigned short dim, std::size_t nodesCount)
+{
+    const SyntheticMeshInfo syntheticInfos = getSyntheticInfos(dim, nodesCount);
+    const MeshCreateInfo meshInfos = getSyntheticMeshInfos(dim, nodesCount);
+
+    const std::string zeros = (dim == 2) ? "0, 0" : "0, 0, 0";
+
+    {
+        std::ofstream luaFile(luaFileName);
+        if(!luaFile.is_open())
+            throw std::runtime_error("cannot open file to write the synthetic problem: " + std::string(luaFileName));
+
+        luaFile.precision(17);
+        luaFile << "Problem = {\n"
+                << "    id = \"IncompNewtonNoT\",\n"
+                << "    simulationTime = 1,\n"
+                << "    verboseOutput = false,\n"
+                << "    Mesh = {\n"
+                << "        alpha = " << meshInfos.alpha << ",\n"
+                << "        omega = " << meshInfos.omega << ",\n"
+                << "        gamma = " << meshInfos.gamma << ",\n"
+                << "        addOnFS = false,\n"
+                << "        deleteFlyingNodes = true,\n"
+                << "        laplacianSmoothingBoundaries = false,\n"
+                << "        boundingBox = {" << toLuaList(meshInfos.boundingBox) << "},\n"
+                << "        exclusionZones = {},\n"
+                << "        Synthetic = {\n"
+                << "            shape = \"" << syntheticInfos.shape << "\",\n"
+                << "            dim = " << syntheticInfos.dim << ",\n"
+                << "            nodesCount = " << syntheticInfos.nodesCount << ",\n"
+                << "            tankSize = {" << toLuaList(syntheticInfos.tankSize) << "},\n"
+                << "            fluidSize = {" << toLuaList(syntheticInfos.fluidSize) << "},\n"
+                << "            jitter = " << syntheticInfos.jitter << ",\n"
+                << "            seed = " << syntheticInfos.seed << "\n"
+                << "        }\n"
+                << "    },\n"
+                << "    Extractors = {},\n"
+                << "    Material = {mu = 1e-3, rho = 1000, gamma = 0},\n"
+                << "    IC = {BoundaryFixed = true},\n"
+                << "    Solver = {\n"
+                << "        id = \"PSPG\",\n"
+                << "        adaptDT = true,\n"
+                << "        coeffDTincrease = 1.5,\n"
+                << "        coeffDTDecrease = 2,\n"
+                << "        maxDT = 0.001,\n"
+                << "        maxRemeshDT = -1,\n"
+                << "        initialDT = 0.001,\n"
+                << "        MomContEq = {\n"
+                << "            minRes = 1e-6,\n"
+                << "            maxIter = 10,\n"
+                << "            gammaFS = 1,\n"
+                << "            bodyForce = {" << (dim == 2 ? "0, -9.81" : "0, 0, -9.81") << "},\n"
+                << "            residual = \"Ax_f\",\n"
+                << "            BC = {}\n"
+                << "        }\n"
+                << "    }\n"
+                << "}\n\n"
+                << "function Problem.IC:initStates(pos)\n"
+                << "    return {" << zeros << ", 0}\n"
+                << "end\n\n"
+                << "function Problem.Solver.MomContEq.BC:BoundaryV(pos, t)\n"
+                << "    return {" << zeros << "}\n"
+                << "end\n";
+    }
+
+    return std::make_unique<ProbIncompNewton>(luaFileName, "");
+}
+
+void removeSyntheticFiles()
+{
+    std::remove(luaFileName);
+}
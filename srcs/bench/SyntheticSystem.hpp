@@ -0,0 +1,222 @@
+#pragma once
+#ifndef SYNTHETICSYSTEM_HPP_INCLUDED
+#define SYNTHETICSYSTEM_HPP_INCLUDED
+
+#include <Eigen/Sparse>
+
+#include "Bench.hpp"
+#include "../simulation/matricesBuilder/MatricesBuilder.hpp"
+
+/**
+ * \class SyntheticSystem
+ * \brief Linear systems of an incompressible flow on the synthetic cloud, assembled the same way as the
+ *        PSPG momentum-continuity equation (with constant material parameters and stabilization).
+ */
+template<unsigned short dim>
+class SyntheticSystem
+{
+    public:
+        static constexpr unsigned short nodPerEl = dim + 1;
+        static constexpr unsigned int tripletPerElm = (dim + 1)*nodPerEl*(dim + 1)*nodPerEl;
+
+        explicit SyntheticSystem(std::size_t nodesCount) :
+        m_pMesh(makeSyntheticMesh(dim, nodesCount)),
+        m_matBuilder(*m_pMesh, dim == 2 ? 3 : 4, dim == 2 ? 3 : 4)
+        {
+            DdevMatType<dim> ddev;
+            mVecType<dim> m;
+            if constexpr (dim == 2)
+            {
+                ddev << 2, 0, 0,
+                        0, 2, 0,
+                        0, 0, 1;
+
+                m << 1, 1, 0;
+            }
+            else
+            {
+                ddev << 2, 0, 0, 0, 0, 0,
+                        0, 2, 0, 0, 0, 0,
+                        0, 0, 2, 0, 0, 0,
+                        0, 0, 0, 1, 0, 0,
+                        0, 0, 0, 0, 1, 0,
+                        0, 0, 0, 0, 0, 1;
+
+                m << 1, 1, 1, 0, 0, 0;
+            }
+            m_matBuilder.setddev(ddev);
+            m_matBuilder.setm(m);
+
+            m_matBuilder.setMcomputeFactor([](const Element& /** element **/, const NmatTypeHD<dim>& /** N **/) -> double {
+                return rho;
+            });
+            m_matBuilder.setKcomputeFactor([](const Element& /** element **/, const NmatTypeHD<dim>& /** N **/,
+                                              const BmatType<dim>& /** B **/, const DdevMatType<dim>& /** ddev **/) -> double {
+                return mu;
+            });
+            m_matBuilder.setDcomputeFactor([](const Element& /** element **/, const NmatTypeHD<dim>& /** N **/,
+                                              const BmatType<dim>& /** B **/) -> double {
+                return 1;
+            });
+            m_matBuilder.setCcomputeFactor([](const Element& /** element **/, const NmatTypeHD<dim>& /** N **/,
+                                              const BmatType<dim>& /** B **/) -> double {
+                return 1;
+            });
+            m_matBuilder.setLcomputeFactor([](const Element& /** element **/, const NmatTypeHD<dim>& /** N **/,
+                                              const BmatType<dim>& /** B **/) -> double {
+                return 1/rho;
+            });
+        }
+
+        const Mesh& getMesh() const noexcept
+        {
+            return *m_pMesh;
+        }
+
+        MatrixBuilder<dim>& getMatrixBuilder() noexcept
+        {
+            return m_matBuilder;
+        }
+
+        /// \return The size of the PSPG system (dim velocities and the pressure per node).
+        std::size_t getSystemSize() const noexcept
+        {
+            return (dim + 1)*m_pMesh->getNodesCount();
+        }
+
+        /// \brief Compute the element contributions of the PSPG system in parallel (boundary rows are left empty).
+        /// \param indexA The triplets, resized to tripletPerElm per element.
+        void computePSPGTriplets(std::vector<Eigen::Triplet<double>>& indexA)
+        {
+            const std::size_t nElm = m_pMesh->getElementsCount();
+            const std::size_t nNodes = m_pMesh->getNodesCount();
+            indexA.assign(tripletPerElm*nElm, Eigen::Triplet<double>());
+
+            Eigen::setNbThreads(1);
+            #pragma omp parallel for default(shared)
+            for(std::size_t elm = 0 ; elm < nElm ; ++elm)
+            {
+                const Element& element = m_pMesh->getElement(elm);
+                Eigen::Matrix<double, (dim + 1)*nodPerEl, (dim + 1)*nodPerEl> Ae;
+
+                GradNmatType<dim> gradNe = m_matBuilder.getGradN(element);
+                BmatType<dim> Be = m_matBuilder.getB(gradNe);
+                Eigen::Matrix<double, nodPerEl, nodPerEl> Me_dt_s = (1/dt)*m_matBuilder.getM(element);
+                Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me_dt = MatrixBuilder<dim>::diagBlock(Me_dt_s);
+                Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Ke = m_matBuilder.getK(element, Be);
+                Eigen::Matrix<double, nodPerEl, dim*nodPerEl> De = m_matBuilder.getD(element, Be);
+                Eigen::Matrix<double, nodPerEl, dim*nodPerEl> Ce_dt = (tau/dt)*m_matBuilder.getC(element, Be, gradNe);
+                Eigen::Matrix<double, nodPerEl, nodPerEl> Le = tau*m_matBuilder.getL(element, Be, gradNe);
+
+                Ae << Me_dt + Ke, -De.transpose(), Ce_dt + De, Le;
+
+                std::size_t countA = 0;
+                for(unsigned short i = 0 ; i < nodPerEl ; ++i)
+                {
+                    const Node& ni = m_pMesh->getNode(element.getNodeIndex(i));
+
+                    for(unsigned short j = 0 ; j < nodPerEl ; ++j)
+                    {
+                        for(unsigned short d1 = 0 ; d1 <= dim ; ++d1)
+                        {
+                            for(unsigned short d2 = 0 ; d2 <= dim ; ++d2)
+                            {
+                                if(d1 == dim || !ni.isBound())
+                                {
+                                    indexA[tripletPerElm*elm + countA] =
+                                        Eigen::Triplet<double>(element.getNodeIndex(i) + d1*nNodes,
+                                                               element.getNodeIndex(j) + d2*nNodes,
+                                                               Ae(i + d1*nodPerEl, j + d2*nodPerEl));
+                                }
+                                countA++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        /// \brief Add the identity rows of the boundary velocities and of the free nodes.
+        void addDirichletTriplets(std::vector<Eigen::Triplet<double>>& indexA) const
+        {
+            const std::size_t nNodes = m_pMesh->getNodesCount();
+            for(std::size_t n = 0 ; n < nNodes ; ++n)
+            {
+                const Node& node = m_pMesh->getNode(n);
+
+                if(node.isFree())
+                    indexA.push_back(Eigen::Triplet<double>(n + dim*nNodes, n + dim*nNodes, 1));
+
+                if(node.isBound() || node.isFree())
+                {
+                    for(unsigned short d = 0 ; d < dim ; ++d)
+                        indexA.push_back(Eigen::Triplet<double>(n + d*nNodes, n + d*nNodes, 1));
+                }
+            }
+        }
+
+        /// \return The PSPG matrix.
+        Eigen::SparseMatrix<double> buildPSPGMatrix()
+        {
+            std::vector<Eigen::Triplet<double>> indexA;
+            computePSPGTriplets(indexA);
+            addDirichletTriplets(indexA);
+
+            Eigen::SparseMatrix<double> A(getSystemSize(), getSystemSize());
+            A.setFromTriplets(indexA.begin(), indexA.end());
+            return A;
+        }
+
+        /// \return The pressure Laplacian, with a null pressure imposed on the free surface and free nodes (SPD).
+        Eigen::SparseMatrix<double> buildLaplacianMatrix()
+        {
+            const std::size_t nElm = m_pMesh->getElementsCount();
+            const std::size_t nNodes = m_pMesh->getNodesCount();
+            std::vector<Eigen::Triplet<double>> indexL;
+            indexL.reserve(nodPerEl*nodPerEl*nElm + nNodes);
+
+            for(std::size_t elm = 0 ; elm < nElm ; ++elm)
+            {
+                const Element& element = m_pMesh->getElement(elm);
+                GradNmatType<dim> gradNe = m_matBuilder.getGradN(element);
+                BmatType<dim> Be = m_matBuilder.getB(gradNe);
+                Eigen::Matrix<double, nodPerEl, nodPerEl> Le = m_matBuilder.getL(element, Be, gradNe);
+
+                for(unsigned short i = 0 ; i < nodPerEl ; ++i)
+                {
+                    for(unsigned short j = 0 ; j < nodPerEl ; ++j)
+                    {
+                        if(!isDirichletPressure(element.getNodeIndex(i)) && !isDirichletPressure(element.getNodeIndex(j)))
+                            indexL.push_back(Eigen::Triplet<double>(element.getNodeIndex(i), element.getNodeIndex(j), Le(i, j)));
+                    }
+                }
+            }
+
+            for(std::size_t n = 0 ; n < nNodes ; ++n)
+            {
+                if(isDirichletPressure(n))
+                    indexL.push_back(Eigen::Triplet<double>(n, n, 1));
+            }
+
+            Eigen::SparseMatrix<double> L(nNodes, nNodes);
+            L.setFromTriplets(indexL.begin(), indexL.end());
+            return L;
+        }
+
+    private:
+        static constexpr double rho = 1000;
+        static constexpr double mu = 1e-3;
+        static constexpr double dt = 1e-3;
+        static constexpr double tau = 1e-4;
+
+        std::unique_ptr<Mesh> m_pMesh;
+        MatrixBuilder<dim> m_matBuilder;
+
+        bool isDirichletPressure(std::size_t nodeIndex) const
+        {
+            const Node& node = m_pMesh->getNode(nodeIndex);
+            return node.isOnFreeSurface() || node.isFree();
+        }
+};
+
+#endif // SYNTHETICSYSTEM_HPP_INCLUDED
@@ -0,0 +1,72 @@
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "Bench.hpp"
+
+/// \return The sizes given as a comma separated list.
+static std::vector<std::size_t> parseSizes(const std::string& list)
+{
+    std::vector<std::size_t> sizes;
+    std::istringstream stream(list);
+    std::string size;
+    while(std::getline(stream, size, ','))
+    {
+        if(size.empty() || size.find_first_not_of("0123456789") != std::string::npos)
+            throw std::runtime_error("invalid size in the list " + list + ": " + size);
+
+        sizes.push_back(std::stoul(size));
+    }
+
+    return sizes;
+}
+
+/**
+ * \brief Micro-benchmarks of the mesh, assembly and solver kernels on synthetic point clouds.
+ *
+ * Besides the Google Benchmark options (e.g. --benchmark_filter=Mesh/ --benchmark_out=results.json
+ * --benchmark_out_format=json for a machine-readable output), accepts --sizes2D=n1,n2,... and --sizes3D=n1,n2,...
+ * giving the approximate numbers of nodes of the clouds.
+ */
+int main(int argc, char** argv)
+{
+    std::vector<std::size_t> sizes2D = {1000, 10000, 100000};
+    std::vector<std::size_t> sizes3D = {1000, 10000, 50000};
+
+    try
+    {
+        //Our options are removed before Google Benchmark parses the remaining ones
+        int benchmarkArgc = 0;
+        for(int i = 0 ; i < argc ; ++i)
+        {
+            if(std::strncmp(argv[i], "--sizes2D=", 10) == 0)
+                sizes2D = parseSizes(argv[i] + 10);
+            else if(std::strncmp(argv[i], "--sizes3D=", 10) == 0)
+                sizes3D = parseSizes(argv[i] + 10);
+            else
+                argv[benchmarkArgc++] = argv[i];
+        }
+        argc = benchmarkArgc;
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "Something went wrong while parsing the arguments: " << e.what() << std::endl;
+        return 1;
+    }
+
+    registerMeshBenchmarks(sizes2D, sizes3D);
+    registerAssemblyBenchmarks(sizes2D, sizes3D);
+    registerSolverBenchmarks(sizes2D, sizes3D);
+    registerProblemBenchmarks(sizes2D, sizes3D);
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    removeSyntheticFiles();
+
+    return 0;
+}
@@ -1,9 +1,11 @@
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <stdexcept>
 
 #include "simulation/physics/Problems.hpp"
+#include "simulation/ScalingStudy.hpp"
 #include "simulation/utility/Utility.hpp"
 #include "simulation/utility/SolTable.hpp"
 #include "simulation/utility/Clock.hpp"
@@ -11,15 +13,22 @@
 
 /**
  * \param  argv[1] .lua file that contains the parameters.
+ * \param  argv[2] (optional) --restart followed by the checkpoint file to restart from, or --scaling
+ *                 followed by the number of time steps of each run (and optionally a JSON report file).
  */
 int main(int argc, char **argv)
 {
-    if (argc < 2)
+    const bool restart = (argc == 4 && std::string(argv[2]) == "--restart");
+    const bool scaling = ((argc == 4 || argc == 5) && std::string(argv[2]) == "--scaling");
+    if (argc != 2 && !restart && !scaling)
     {
-        std::cerr   << "Usage: " << argv[0] << " params.lua" <<  std::endl;
+        std::cerr   << "Usage: " << argv[0] << " params.lua [--restart checkpoint | --scaling steps [report.json]]"
+                    <<  std::endl;
         return 1;
     }
 
+    const std::string restartFile = restart ? argv[3] : "";
+
     Clock myClock;
     myClock.start();
 
@@ -47,28 +56,52 @@ int main(int argc, char **argv)
 
         std::string problemType = table.checkAndGet<std::string>("id");
 
-        if(problemType == "IncompNewtonNoT" || problemType == "Bingham" || problemType == "Boussinesq" || problemType == "Conduction")
-            pProblem = std::make_unique<ProbIncompNewton>(argv[1]);
-        else if(problemType == "WCompNewtonNoT" || problemType == "BoussinesqWC")
-            pProblem = std::make_unique<ProbWCompNewton>(argv[1]);
-        else
-            throw std::runtime_error("unknown problem type " + problemType + "!");
+        auto createProblem = [&]() -> std::unique_ptr<Problem>
+        {
+            if(problemType == "IncompNewtonNoT" || problemType == "Bingham" || problemType == "Boussinesq" || problemType == "Conduction")
+                return std::make_unique<ProbIncompNewton>(argv[1], restartFile);
+            else if(problemType == "WCompNewtonNoT" || problemType == "BoussinesqWC")
+                return std::make_unique<ProbWCompNewton>(argv[1], restartFile);
+            else
+                throw std::runtime_error("unknown problem type " + problemType + "!");
+        };
+
+        if(scaling)
+        {
+            const int stepsCount = std::atoi(argv[3]);
+            if(stepsCount <= 0)
+                throw std::runtime_error("the number of time steps of the scaling study should be positive!");
+
+            ScalingStudy study(createProblem, static_cast<std::size_t>(stepsCount));
+            study.run();
+            std::cout << "======================================" << std::endl;
+            study.writeReport(std::cout);
+            if(argc == 5)
+                study.writeJSONReport(argv[4]);
+
+            return 0;
+        }
 
+        pProblem = createProblem();
         pProblem->simulate();
         std::cout << "======================================" << std::endl;
         std::cout << "======================================" << std::endl;
         pProblem->displayTimeStats();
+        std::cout << "======================================" << std::endl;
+        pProblem->displayMemoryStats();
     }
     catch(const std::exception& e)
     {
         std::cerr << std::endl << "\nSomething went wrong while running the program: " << e.what() << std::endl;
-        pProblem->dump();
+        if(pProblem)
+            pProblem->dump();
         return -1;
     }
     catch(...)
     {
         std::cerr << std::endl << "\nAn unknown exception has occurred." << std::endl;
-        pProblem->dump();
+        if(pProblem)
+            pProblem->dump();
         return -1;
     }
 
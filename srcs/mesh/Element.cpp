@@ -12,11 +12,11 @@ m_pMesh(&mesh)
 
 }
 
-void Element::computeJ()
+std::array<std::array<double, 3>, 3> Element::computeJ() const noexcept
 {
-    m_J = {{{0, 0, 0},
-            {0, 0, 0},
-            {0, 0, 0}}};
+    std::array<std::array<double, 3>, 3> J = {{{0, 0, 0},
+                                               {0, 0, 0},
+                                               {0, 0, 0}}};
 
     if(m_nodesIndexes.size() == 3)
     {
@@ -31,10 +31,10 @@ void Element::computeJ()
         double y1 = n1.getCoordinate(1);
         double y2 = n2.getCoordinate(1);
 
-        m_J[0][0] = x1 - x0;
-        m_J[0][1] = x2 - x0;
-        m_J[1][0] = y1 - y0;
-        m_J[1][1] = y2 - y0;
+        J[0][0] = x1 - x0;
+        J[0][1] = x2 - x0;
+        J[1][0] = y1 - y0;
+        J[1][1] = y2 - y0;
     }
     else
     {
@@ -56,82 +56,86 @@ void Element::computeJ()
         double z2 = n2.getCoordinate(2);
         double z3 = n3.getCoordinate(2);
 
-        m_J[0][0] = x1 - x0;
-        m_J[0][1] = x2 - x0;
-        m_J[0][2] = x3 - x0;
-        m_J[1][0] = y1 - y0;
-        m_J[1][1] = y2 - y0;
-        m_J[1][2] = y3 - y0;
-        m_J[2][0] = z1 - z0;
-        m_J[2][1] = z2 - z0;
-        m_J[2][2] = z3 - z0;
+        J[0][0] = x1 - x0;
+        J[0][1] = x2 - x0;
+        J[0][2] = x3 - x0;
+        J[1][0] = y1 - y0;
+        J[1][1] = y2 - y0;
+        J[1][2] = y3 - y0;
+        J[2][0] = z1 - z0;
+        J[2][1] = z2 - z0;
+        J[2][2] = z3 - z0;
     }
+
+    return J;
 }
 
-void Element::computeDetJ()
+double Element::computeDetJ(const std::array<std::array<double, 3>, 3>& J) const noexcept
 {
     if(m_nodesIndexes.size() == 3)
     {
-        m_detJ = m_J[0][0]*m_J[1][1] - m_J[1][0]*m_J[0][1];
+        return J[0][0]*J[1][1] - J[1][0]*J[0][1];
     }
     else
     {
-        m_detJ = m_J[0][0]*m_J[1][1]*m_J[2][2]
-               + m_J[0][1]*m_J[1][2]*m_J[2][0]
-               + m_J[0][2]*m_J[1][0]*m_J[2][1]
-               - m_J[2][0]*m_J[1][1]*m_J[0][2]
-               - m_J[2][1]*m_J[1][2]*m_J[0][0]
-               - m_J[2][2]*m_J[1][0]*m_J[0][1];
+        return J[0][0]*J[1][1]*J[2][2]
+             + J[0][1]*J[1][2]*J[2][0]
+             + J[0][2]*J[1][0]*J[2][1]
+             - J[2][0]*J[1][1]*J[0][2]
+             - J[2][1]*J[1][2]*J[0][0]
+             - J[2][2]*J[1][0]*J[0][1];
     }
 }
 
-void Element::computeInvJ()
+std::array<std::array<double, 3>, 3> Element::computeInvJ(const std::array<std::array<double, 3>, 3>& J, double detJ) const noexcept
 {
-    assert(m_detJ != 0);
+    assert(detJ != 0);
 
-    m_invJ = {{{0, 0, 0},
-               {0, 0, 0},
-               {0, 0, 0}}};
+    std::array<std::array<double, 3>, 3> invJ = {{{0, 0, 0},
+                                                  {0, 0, 0},
+                                                  {0, 0, 0}}};
 
     if(m_nodesIndexes.size() == 3)
     {
-        m_invJ[0][0] = m_J[1][1]/m_detJ;
+        invJ[0][0] = J[1][1]/detJ;
 
-        m_invJ[0][1] = - m_J[0][1]/m_detJ;
+        invJ[0][1] = - J[0][1]/detJ;
 
-        m_invJ[1][0] = - m_J[1][0]/m_detJ;
+        invJ[1][0] = - J[1][0]/detJ;
 
-        m_invJ[1][1] = m_J[0][0]/m_detJ;
+        invJ[1][1] = J[0][0]/detJ;
     }
     else
     {
-        m_invJ[0][0] = (m_J[1][1]*m_J[2][2]
-                     - m_J[1][2]*m_J[2][1])/m_detJ;
+        invJ[0][0] = (J[1][1]*J[2][2]
+                   - J[1][2]*J[2][1])/detJ;
 
-        m_invJ[0][1] = (m_J[2][1]*m_J[0][2]
-                     - m_J[2][2]*m_J[0][1])/m_detJ;
+        invJ[0][1] = (J[2][1]*J[0][2]
+                   - J[2][2]*J[0][1])/detJ;
 
-        m_invJ[0][2] = (m_J[0][1]*m_J[1][2]
-                     - m_J[0][2]*m_J[1][1])/m_detJ;
+        invJ[0][2] = (J[0][1]*J[1][2]
+                   - J[0][2]*J[1][1])/detJ;
 
-        m_invJ[1][0] = (m_J[2][0]*m_J[1][2]
-                     - m_J[1][0]*m_J[2][2])/m_detJ;
+        invJ[1][0] = (J[2][0]*J[1][2]
+                   - J[1][0]*J[2][2])/detJ;
 
-        m_invJ[1][1] = (m_J[0][0]*m_J[2][2]
-                     - m_J[2][0]*m_J[0][2])/m_detJ;
+        invJ[1][1] = (J[0][0]*J[2][2]
+                   - J[2][0]*J[0][2])/detJ;
 
-        m_invJ[1][2] = (m_J[1][0]*m_J[0][2]
-                     - m_J[0][0]*m_J[1][2])/m_detJ;
+        invJ[1][2] = (J[1][0]*J[0][2]
+                   - J[0][0]*J[1][2])/detJ;
 
-        m_invJ[2][0] = (m_J[1][0]*m_J[2][1]
-                     - m_J[2][0]*m_J[1][1])/m_detJ;
+        invJ[2][0] = (J[1][0]*J[2][1]
+                   - J[2][0]*J[1][1])/detJ;
 
-        m_invJ[2][1] = (m_J[2][0]*m_J[0][1]
-                     - m_J[0][0]*m_J[2][1])/m_detJ;
+        invJ[2][1] = (J[2][0]*J[0][1]
+                   - J[0][0]*J[2][1])/detJ;
 
-        m_invJ[2][2] = (m_J[0][0]*m_J[1][1]
-                     - m_J[1][0]*m_J[0][1])/m_detJ;
+        invJ[2][2] = (J[0][0]*J[1][1]
+                   - J[1][0]*J[0][1])/detJ;
     }
+
+    return invJ;
 }
 
 const Element& Element::getNeighbourElement(unsigned int neighbourElmIndex) const noexcept
@@ -144,21 +148,30 @@ const Node& Element::getNode(unsigned int nodeIndex) const noexcept
     return m_pMesh->getNode(m_nodesIndexes[nodeIndex]);
 }
 
+double Element::getJ(unsigned int i, unsigned int j) const noexcept
+{
+    if(i >= m_pMesh->getDim() || j >= m_pMesh->getDim())
+        return 0;
+
+    return getNode(j + 1).getCoordinate(i) - getNode(0).getCoordinate(i);
+}
+
 std::array<double, 3> Element::getPosFromGP(const std::array<double, 3>& gp) const noexcept
 {
     const Node& n0 = m_pMesh->getNode(m_nodesIndexes[0]);
+    const std::array<std::array<double, 3>, 3> J = computeJ();
 
     std::array<double, 3> pos;
-    pos[0] = m_J[0][0]*gp[0] + m_J[0][1]*gp[1] + m_J[0][2]*gp[2] + n0.getCoordinate(0);
-    pos[1] = m_J[1][0]*gp[0] + m_J[1][1]*gp[1] + m_J[1][2]*gp[2] + n0.getCoordinate(1);
-    pos[2] = m_J[2][0]*gp[0] + m_J[2][1]*gp[1] + m_J[2][2]*gp[2] + n0.getCoordinate(2);
+    pos[0] = J[0][0]*gp[0] + J[0][1]*gp[1] + J[0][2]*gp[2] + n0.getCoordinate(0);
+    pos[1] = J[1][0]*gp[0] + J[1][1]*gp[1] + J[1][2]*gp[2] + n0.getCoordinate(1);
+    pos[2] = J[2][0]*gp[0] + J[2][1]*gp[1] + J[2][2]*gp[2] + n0.getCoordinate(2);
 
     return pos;
 }
 
 double Element::getSize() const noexcept
 {
-    return m_detJ*m_pMesh->getRefElementSize(m_pMesh->getDim());
+    return getDetJ()*m_pMesh->getRefElementSize(m_pMesh->getDim());
 }
 
 double Element::getMinNodeDist() const noexcept
@@ -48,7 +48,7 @@ class MESH_API Element
         /// \return A vector containing the considered state for each node of the element.
         std::vector<double> getState(unsigned int stateIndex) const noexcept;
 
-        /// \return The determinant of the Jacobian matrix of the change of variable to the reference space.
+        /// \return The determinant of the Jacobian matrix of the change of variable to the reference space (computed lazily by the mesh).
         inline double getDetJ() const noexcept;
 
         /**
@@ -68,7 +68,7 @@ class MESH_API Element
          * \param j The column index inside the Jacobian matrix.
          * \return The element (i,j) of the Jacobian matrix.
          */
-        inline double getJ(unsigned int i, unsigned int j) const noexcept;
+        double getJ(unsigned int i, unsigned int j) const noexcept;
 
         /**
          * \brief Get an element of the inverse of the Jacobian matrix of the change of variable to the reference space:
@@ -85,7 +85,7 @@ class MESH_API Element
          * \f}
          * \param i The row index inside the inverse of the Jacobian matrix.
          * \param j The column index inside the inverse of the Jacobian matrix.
-         * \return The element (i,j) of the inverse of the Jacobian matrix.
+         * \return The element (i,j) of the inverse of the Jacobian matrix (computed lazily by the mesh).
          */
         inline double getInvJ(unsigned int i, unsigned int j) const noexcept;
 
@@ -121,18 +121,14 @@ class MESH_API Element
         std::vector<std::size_t> m_nodesIndexes;        /**< Indexes of the nodes in the nodes list which compose this element. */
         std::vector<std::size_t> m_neighbourElements;
 
-        double m_detJ;                                  /**< Determinant of the Jacobian matrix of the element. */
-        std::array<std::array<double, 3>, 3> m_J;       /**< Jacobian matrix of the element. */
-        std::array<std::array<double, 3>, 3> m_invJ;    /**< Inverse Jacobian matrix of the element. */
-
         /// Compute the Jacobian matrix of the change of variable to the reference space.
-        void computeJ();
+        std::array<std::array<double, 3>, 3> computeJ() const noexcept;
 
         /// Compute the determinant of Jacobian matrix of the change of variable to the reference space.
-        void computeDetJ();
+        double computeDetJ(const std::array<std::array<double, 3>, 3>& J) const noexcept;
 
         /// Compute the inverse of Jacobian matrix of the change of variable to the reference space.
-        void computeInvJ();
+        std::array<std::array<double, 3>, 3> computeInvJ(const std::array<std::array<double, 3>, 3>& J, double detJ) const noexcept;
 
         friend class Mesh;
 };
@@ -1,10 +1,5 @@
 #include "Element.hpp"
 
-inline double Element::getDetJ() const noexcept
-{
-    return m_detJ;
-}
-
 inline std::size_t Element::getNeighbourElementsCount() const noexcept
 {
     return m_neighbourElements.size();
@@ -20,15 +15,7 @@ inline std::size_t Element::getNodeIndex(unsigned int node) const noexcept
     return m_nodesIndexes[node];
 }
 
-inline double Element::getJ(unsigned int i, unsigned int j) const noexcept
-{
-    return m_J[i][j];
-}
-
-inline double Element::getInvJ(unsigned int i, unsigned int j) const noexcept
-{
-    return m_invJ[i][j];
-}
+//getDetJ and getInvJ are defined in Mesh.inl as they read the geometry cache of the mesh
 
 inline bool operator==(const Element& a, const Element& b) noexcept
 {
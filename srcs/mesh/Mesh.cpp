@@ -2,12 +2,26 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <set>
 
 #include <gmsh.h>
 
+template<typename T>
+static void writeBinary(std::ostream& file, const T* pData, std::size_t count)
+{
+    file.write(reinterpret_cast<const char*>(pData), static_cast<std::streamsize>(count*sizeof(T)));
+}
+
+template<typename T>
+static void readBinary(std::istream& file, T* pData, std::size_t count)
+{
+    file.read(reinterpret_cast<char*>(pData), static_cast<std::streamsize>(count*sizeof(T)));
+    if(!file)
+        throw std::runtime_error("unexpected end of the checkpoint file!");
+}
 
 Mesh::Mesh(const MeshCreateInfo& meshInfos) :
 m_hchar(meshInfos.hchar),
@@ -19,11 +33,59 @@ m_exclusionZones(meshInfos.exclusionZones),
 m_addOnFS(meshInfos.addOnFS),
 m_deleteFlyingNodes(meshInfos.deleteFlyingNodes),
 m_laplacianSmoothingBoundaries(meshInfos.laplacianSmoothingBoundaries),
-m_computeNormalCurvature(true)
+m_computeNormalCurvature(true),
+m_nodesCountSave(0),
+m_geometryCacheSize(0),
+m_geometryEpoch(1),
+m_addedNodesCount(0),
+m_removedNodesCount(0),
+m_triangulationMemory(0)
 {
     loadFromFile(meshInfos.mshFile);
 }
 
+Mesh::Mesh(const MeshCreateInfo& meshInfos, std::istream& checkpoint) :
+m_hchar(meshInfos.hchar),
+m_alpha(meshInfos.alpha),
+m_omega(meshInfos.omega),
+m_gamma(meshInfos.gamma),
+m_boundingBox(meshInfos.boundingBox),
+m_exclusionZones(meshInfos.exclusionZones),
+m_addOnFS(meshInfos.addOnFS),
+m_deleteFlyingNodes(meshInfos.deleteFlyingNodes),
+m_laplacianSmoothingBoundaries(meshInfos.laplacianSmoothingBoundaries),
+m_computeNormalCurvature(true),
+m_nodesCountSave(0),
+m_geometryCacheSize(0),
+m_geometryEpoch(1),
+m_addedNodesCount(0),
+m_removedNodesCount(0),
+m_triangulationMemory(0)
+{
+    loadFromCheckpoint(checkpoint);
+}
+
+Mesh::Mesh(const MeshCreateInfo& meshInfos, const SyntheticMeshInfo& syntheticInfos) :
+m_hchar(meshInfos.hchar),
+m_alpha(meshInfos.alpha),
+m_omega(meshInfos.omega),
+m_gamma(meshInfos.gamma),
+m_boundingBox(meshInfos.boundingBox),
+m_exclusionZones(meshInfos.exclusionZones),
+m_addOnFS(meshInfos.addOnFS),
+m_deleteFlyingNodes(meshInfos.deleteFlyingNodes),
+m_laplacianSmoothingBoundaries(meshInfos.laplacianSmoothingBoundaries),
+m_computeNormalCurvature(true),
+m_nodesCountSave(0),
+m_geometryCacheSize(0),
+m_geometryEpoch(1),
+m_addedNodesCount(0),
+m_removedNodesCount(0),
+m_triangulationMemory(0)
+{
+    loadSynthetic(syntheticInfos);
+}
+
 bool Mesh::addNodes(bool verboseOutput)
 {
     assert(!m_elementsList.empty() && !m_nodesList.empty() && "There is no mesh!");
@@ -143,9 +205,58 @@ bool Mesh::addNodes(bool verboseOutput)
             return false;
     }), m_elementsList.end());
 
+    resetGeometryCache();
+
     return addedNodes;
 }
 
+void Mesh::addPhysicalGroupNodes(const std::string& name, bool isBound,
+                                 const std::vector<std::size_t>& nodesTags,
+                                 const std::vector<double>& coord,
+                                 std::vector<bool>& isNodeAdded)
+{
+    int tag;
+    auto posBCinTagNames = std::find(m_tagNames.begin(), m_tagNames.end(), name);
+    if(posBCinTagNames == std::end(m_tagNames))
+    {
+        m_tagNames.push_back(name);
+        tag = static_cast<int>(m_tagNames.size() - 1);
+    }
+    else
+    {
+        tag = static_cast<int>(std::distance(m_tagNames.begin(), posBCinTagNames));
+    }
+
+    //If the nodes is already in the list (e.g. on the boundary), we do not add it twice
+    std::vector<std::size_t> newNodes;
+    newNodes.reserve(nodesTags.size());
+    for(std::size_t i = 0 ; i < nodesTags.size() ; ++i)
+    {
+        if(nodesTags[i] >= isNodeAdded.size())
+            isNodeAdded.resize(std::max(nodesTags[i] + 1, 2*isNodeAdded.size()), false);
+
+        if(!isNodeAdded[nodesTags[i]])
+        {
+            isNodeAdded[nodesTags[i]] = true;
+            newNodes.push_back(i);
+        }
+    }
+
+    const std::size_t firstNode = m_nodesList.size();
+    m_nodesList.resize(firstNode + newNodes.size(), Node(*this));
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t i = 0 ; i < newNodes.size() ; ++i)
+    {
+        Node& node = m_nodesList[firstNode + i];
+        for(unsigned short d = 0 ; d < m_dim ; ++d)
+            node.m_position[d] = coord[3*newNodes[i] + d];
+
+        node.m_isBound = isBound;
+        node.m_tag = tag;
+    }
+}
+
 bool Mesh::checkBoundingBox(bool verboseOutput) noexcept
 {
     assert(!m_elementsList.empty() && !m_nodesList.empty() && "There is no mesh !");
@@ -759,27 +870,16 @@ void Mesh::laplacianSmoothingBoundaries()
     }
 }
 
-void Mesh::loadFromFile(const std::string& fileName)
+void Mesh::loadFromCheckpoint(std::istream& file)
 {
-    m_nodesList.clear();
-
-    gmsh::initialize();
-#ifndef NDEBUG
-    gmsh::option::setNumber("General.Terminal", 1);
-#else
-    gmsh::option::setNumber("General.Terminal", 0);
-#endif
-
-    std::ifstream file(fileName);
-    if(file.is_open())
-        file.close();
-    else
-        throw std::runtime_error("the input .msh file does not exist!");
+    char magic[4];
+    readBinary(file, magic, 4);
+    if(std::string(magic, 4) != "MESH")
+        throw std::runtime_error("the checkpoint does not contain a mesh section!");
 
-    gmsh::open(fileName);
-
-    // Check that the mesh is not 3D
-    computeMeshDim();
+    readBinary(file, &m_dim, 1);
+    if(m_dim != 2 && m_dim != 3)
+        throw std::runtime_error("invalid mesh dimension in the checkpoint: " + std::to_string(m_dim));
 
     if(m_boundingBox.size() != 2*m_dim)
         throw std::runtime_error("Invalid bounding box size: " + std::to_string(m_boundingBox.size()));
@@ -790,91 +890,203 @@ void Mesh::loadFromFile(const std::string& fileName)
             throw std::runtime_error("Invalid exclusion zone size: " + std::to_string(exclusionZone.size()));
     }
 
-    // We retrieve the tags of the physical groups of dimension m_dim and
-    // m_dim-1
-    std::vector<std::pair<int, int>> physGroupHandlesHD;
-    gmsh::model::getPhysicalGroups(physGroupHandlesHD, m_dim);
+    std::uint64_t tagsCount;
+    readBinary(file, &tagsCount, 1);
+    m_tagNames.resize(tagsCount);
+    for(auto& tagName : m_tagNames)
+    {
+        std::uint64_t size;
+        readBinary(file, &size, 1);
+        tagName.resize(size);
+        readBinary(file, &tagName[0], size);
+    }
 
-    std::vector<std::pair<int, int>> physGroupHandlesLD;
-    gmsh::model::getPhysicalGroups(physGroupHandlesLD, m_dim - 1);
+    std::uint64_t nodesCount, statesCount;
+    readBinary(file, &nodesCount, 1);
+    readBinary(file, &statesCount, 1);
+    if(nodesCount == 0)
+        throw std::runtime_error("no nodes in the checkpoint!");
 
-    //The file should contain physical group for the boundary, the free surface and the fluid
+    std::vector<double> positions(m_dim*nodesCount);
+    std::vector<double> states(statesCount*nodesCount);
+    std::vector<std::int32_t> tags(nodesCount);
+    std::vector<std::uint8_t> flags(nodesCount);
+    readBinary(file, positions.data(), positions.size());
+    readBinary(file, states.data(), states.size());
+    readBinary(file, tags.data(), tags.size());
+    readBinary(file, flags.data(), flags.size());
 
-    for(auto physGroupLD : physGroupHandlesLD)
+    m_nodesList.assign(nodesCount, Node(*this));
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
     {
-        std::string name;
-        gmsh::model::getPhysicalName(m_dim - 1, physGroupLD.second, name);
-        if(name != "FreeSurface" && name != "Fluid")
-        {
-            std::vector<double> coord;
-            std::vector<std::size_t> dummyNodesTagsBoundary;
-            gmsh::model::mesh::getNodesForPhysicalGroup(m_dim - 1, physGroupLD.second,
-                                                        dummyNodesTagsBoundary, coord);
+        Node& node = m_nodesList[n];
+        for(unsigned short d = 0 ; d < 3 ; ++d)
+            node.m_position[d] = (d < m_dim) ? positions[n + d*nodesCount] : 0.0;
 
-            for(std::size_t i = 0 ; i < dummyNodesTagsBoundary.size() ; ++i)
-            {
-                Node node(*this);
-                for(unsigned short d = 0 ; d < m_dim ; ++d)
-                {
-                    node.m_position[d] = coord[3*i + d];
-                }
+        node.m_states.resize(statesCount);
+        for(std::size_t st = 0 ; st < statesCount ; ++st)
+            node.m_states[st] = states[n + st*nodesCount];
 
-                //If the nodes is already on the boundary, we do not add it twice
-                if(std::find(m_nodesList.begin(), m_nodesList.end(), node) != m_nodesList.end())
-                    continue;
+        node.m_tag = tags[n];
+        node.m_isBound = flags[n] & 1;
+        node.m_isFixed = flags[n] & 2;
+    }
 
-                node.m_isBound = true;
+    //Captured time steps also contain the connectivity, which is not a Delaunay one between two remeshings
+    if(file.peek() == std::char_traits<char>::eof())
+    {
+        triangulateAlphaShape();
+        return;
+    }
 
-                auto posBCinTagNames = std::find(m_tagNames.begin(), m_tagNames.end(), name);
-                if(posBCinTagNames == std::end(m_tagNames))
-                {
-                    m_tagNames.push_back(name);
-                    node.m_tag = static_cast<int>(m_tagNames.size() - 1);
-                }
-                else
-                {
-                    node.m_tag = static_cast<int>(std::distance(m_tagNames.begin(), posBCinTagNames));
-                }
-                m_nodesList.push_back(std::move(node));
+    char section[4];
+    readBinary(file, section, 4);
+    if(std::string(section, 4) != "CONN")
+        throw std::runtime_error("unknown section in the checkpoint mesh: " + std::string(section, 4));
+
+    loadConnectivity(file);
+}
+
+void Mesh::loadConnectivity(std::istream& file)
+{
+    const std::size_t nodesCount = m_nodesList.size();
+    const std::size_t nodesPerElm = m_dim + 1u;
+
+    std::uint64_t elementsCount;
+    readBinary(file, &elementsCount, 1);
+    std::vector<std::uint64_t> elementsNodes(nodesPerElm*elementsCount);
+    std::vector<std::uint64_t> neighboursCount(elementsCount);
+    readBinary(file, elementsNodes.data(), elementsNodes.size());
+    readBinary(file, neighboursCount.data(), neighboursCount.size());
+
+    std::uint64_t neighboursSize;
+    readBinary(file, &neighboursSize, 1);
+    std::vector<std::uint64_t> neighbours(neighboursSize);
+    readBinary(file, neighbours.data(), neighbours.size());
+
+    std::uint64_t facetsCount;
+    readBinary(file, &facetsCount, 1);
+    std::vector<std::uint64_t> facets((m_dim + 2u)*facetsCount);
+    readBinary(file, facets.data(), facets.size());
+
+    std::vector<std::uint8_t> freeSurface(nodesCount);
+    readBinary(file, freeSurface.data(), freeSurface.size());
+
+    auto checkIndex = [](std::uint64_t index, std::size_t count)
+    {
+        if(index >= count)
+            throw std::runtime_error("invalid index in the checkpoint connectivity: " + std::to_string(index));
+    };
+
+    for(std::uint64_t index : elementsNodes)
+        checkIndex(index, nodesCount);
+
+    for(std::uint64_t index : neighbours)
+        checkIndex(index, elementsCount);
+
+    m_elementsList.assign(elementsCount, Element(*this));
+    m_facetsList.assign(facetsCount, Facet(*this));
+
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        m_nodesList[n].m_isOnFreeSurface = freeSurface[n] != 0;
+        m_nodesList[n].m_neighbourNodes.clear();
+        m_nodesList[n].m_elements.clear();
+        m_nodesList[n].m_facets.clear();
+    }
+
+    //Same adjacency as the one built by the triangulation
+    std::size_t neighbourIndex = 0;
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+    {
+        Element& element = m_elementsList[elm];
+        element.m_nodesIndexes.assign(elementsNodes.begin() + static_cast<std::ptrdiff_t>(elm*nodesPerElm),
+                                      elementsNodes.begin() + static_cast<std::ptrdiff_t>((elm + 1)*nodesPerElm));
+
+        if(neighbourIndex + neighboursCount[elm] > neighbours.size())
+            throw std::runtime_error("invalid neighbour elements count in the checkpoint connectivity!");
+
+        element.m_neighbourElements.assign(neighbours.begin() + static_cast<std::ptrdiff_t>(neighbourIndex),
+                                           neighbours.begin() + static_cast<std::ptrdiff_t>(neighbourIndex + neighboursCount[elm]));
+        neighbourIndex += neighboursCount[elm];
+
+        for(std::size_t n : element.m_nodesIndexes)
+        {
+            m_nodesList[n].m_elements.push_back(elm);
+            for(std::size_t neighbour : element.m_nodesIndexes)
+            {
+                if(neighbour != n)
+                    m_nodesList[n].m_neighbourNodes.push_back(neighbour);
             }
         }
     }
 
-    for(auto physGroupHD : physGroupHandlesHD)
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
     {
-        std::string name;
-        gmsh::model::getPhysicalName(m_dim, physGroupHD.second, name);
+        std::sort(m_nodesList[n].m_neighbourNodes.begin(), m_nodesList[n].m_neighbourNodes.end());
+        m_nodesList[n].m_neighbourNodes.erase(
+        std::unique(m_nodesList[n].m_neighbourNodes.begin(), m_nodesList[n].m_neighbourNodes.end()),
+        m_nodesList[n].m_neighbourNodes.end());
+    }
 
-        std::vector<std::size_t> dummyNodesTags;
-        std::vector<double> coord;
-        gmsh::model::mesh::getNodesForPhysicalGroup(m_dim, physGroupHD.second,
-                                                    dummyNodesTags, coord);
+    for(std::size_t f = 0 ; f < facetsCount ; ++f)
+    {
+        Facet& facet = m_facetsList[f];
+        const std::uint64_t* pFacet = &facets[f*(m_dim + 2u)];
 
-        for(std::size_t i = 0 ; i < dummyNodesTags.size() ; ++i)
-        {
-            Node node(*this);
-            for(unsigned short d = 0 ; d < m_dim ; ++d)
-                node.m_position[d] = coord[3*i + d];
+        for(unsigned short d = 0 ; d < m_dim + 1 ; ++d)
+            checkIndex(pFacet[d], nodesCount);
+        checkIndex(pFacet[m_dim + 1], elementsCount);
 
-            //If the nodes is already on the boundary, we do not add it twice
-            if(std::find(m_nodesList.begin(), m_nodesList.end(), node) != m_nodesList.end())
-                continue;
+        facet.m_nodesIndexes.assign(pFacet, pFacet + m_dim);
+        facet.m_outNodeIndex = pFacet[m_dim];
+        facet.m_elementIndex = pFacet[m_dim + 1];
 
-            node.m_isBound = false;
+        facet.computeJ();
+        facet.computeDetJ();
+        facet.computeInvJ();
+        if(m_computeNormalCurvature)
+            facet.computeNormal();
 
-            auto posBCinTagNames = std::find(m_tagNames.begin(), m_tagNames.end(), name);
-            if(posBCinTagNames == std::end(m_tagNames))
-            {
-                m_tagNames.push_back(name);
-                node.m_tag = m_tagNames.size() - 1;
-            }
-            else
-            {
-                node.m_tag = static_cast<uint16_t>(std::distance(m_tagNames.begin(), posBCinTagNames));
-            }
+        for(std::size_t n : facet.m_nodesIndexes)
+            m_nodesList[n].m_facets.push_back(f);
+    }
 
-            m_nodesList.push_back(std::move(node));
-        }
+    m_triangulationMemory = 0;
+    resetGeometryCache();
+}
+
+void Mesh::loadFromFile(const std::string& fileName)
+{
+    m_nodesList.clear();
+
+    std::ifstream file(fileName, std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("the input .msh file does not exist!");
+
+    // Point clouds share the mesh section of the checkpoints
+    char magic[8] = {};
+    file.read(magic, 8);
+    if(file.gcount() == 8 && std::string(magic, 8) == "PFEMPTS1")
+    {
+        loadFromCheckpoint(file);
+        return;
+    }
+    file.close();
+
+    if(!loadFromMSH41Binary(fileName))
+        loadFromGmsh(fileName);
+
+    if(m_boundingBox.size() != 2*m_dim)
+        throw std::runtime_error("Invalid bounding box size: " + std::to_string(m_boundingBox.size()));
+
+    for(auto& exclusionZone : m_exclusionZones)
+    {
+        if(exclusionZone.size() != 2*m_dim)
+            throw std::runtime_error("Invalid exclusion zone size: " + std::to_string(exclusionZone.size()));
     }
 
 #ifndef NDEBUG
@@ -911,17 +1123,166 @@ void Mesh::loadFromFile(const std::string& fileName)
     if(m_nodesList.empty())
         throw std::runtime_error("no nodes loaded! Did you add the physical groups in the .geo file?");
 
+    triangulateAlphaShape();
+}
+
+void Mesh::loadFromGmsh(const std::string& fileName)
+{
+    gmsh::initialize();
+#ifndef NDEBUG
+    gmsh::option::setNumber("General.Terminal", 1);
+#else
+    gmsh::option::setNumber("General.Terminal", 0);
+#endif
+
+    gmsh::open(fileName);
+
+    // Check that the mesh is not 3D
+    computeMeshDim();
+
+    // We retrieve the tags of the physical groups of dimension m_dim and
+    // m_dim-1
+    std::vector<std::pair<int, int>> physGroupHandlesHD;
+    gmsh::model::getPhysicalGroups(physGroupHandlesHD, m_dim);
+
+    std::vector<std::pair<int, int>> physGroupHandlesLD;
+    gmsh::model::getPhysicalGroups(physGroupHandlesLD, m_dim - 1);
+
+    //The file should contain physical group for the boundary, the free surface and the fluid
+    std::vector<bool> isNodeAdded;
+
+    for(auto physGroupLD : physGroupHandlesLD)
+    {
+        std::string name;
+        gmsh::model::getPhysicalName(m_dim - 1, physGroupLD.second, name);
+        if(name != "FreeSurface" && name != "Fluid")
+        {
+            std::vector<double> coord;
+            std::vector<std::size_t> nodesTags;
+            gmsh::model::mesh::getNodesForPhysicalGroup(m_dim - 1, physGroupLD.second,
+                                                        nodesTags, coord);
+
+            addPhysicalGroupNodes(name, true, nodesTags, coord, isNodeAdded);
+        }
+    }
+
+    for(auto physGroupHD : physGroupHandlesHD)
+    {
+        std::string name;
+        gmsh::model::getPhysicalName(m_dim, physGroupHD.second, name);
+
+        std::vector<std::size_t> nodesTags;
+        std::vector<double> coord;
+        gmsh::model::mesh::getNodesForPhysicalGroup(m_dim, physGroupHD.second,
+                                                    nodesTags, coord);
+
+        addPhysicalGroupNodes(name, false, nodesTags, coord, isNodeAdded);
+    }
+
     gmsh::finalize();
+}
 
-    triangulateAlphaShape();
+std::size_t Mesh::getMemoryUsage() const noexcept
+{
+    std::size_t memory = m_nodesList.capacity()*sizeof(Node) +
+                         m_elementsList.capacity()*sizeof(Element) +
+                         m_facetsList.capacity()*sizeof(Facet);
+
+    #pragma omp parallel for default(shared) reduction(+:memory)
+    for(std::size_t n = 0 ; n < m_nodesList.size() ; ++n)
+    {
+        const Node& node = m_nodesList[n];
+        memory += node.m_states.capacity()*sizeof(double) +
+                  (node.m_neighbourNodes.capacity() + node.m_elements.capacity() + node.m_facets.capacity())*sizeof(std::size_t);
+    }
+
+    #pragma omp parallel for default(shared) reduction(+:memory)
+    for(std::size_t elm = 0 ; elm < m_elementsList.size() ; ++elm)
+        memory += (m_elementsList[elm].m_nodesIndexes.capacity() + m_elementsList[elm].m_neighbourElements.capacity())*sizeof(std::size_t);
+
+    #pragma omp parallel for default(shared) reduction(+:memory)
+    for(std::size_t f = 0 ; f < m_facetsList.size() ; ++f)
+        memory += m_facetsList[f].m_nodesIndexes.capacity()*sizeof(std::size_t);
+
+    memory += (m_nodesPositionSave.capacity() + m_nodesStatesSave.capacity())*sizeof(double);
+    memory += (m_elementsDetJ.capacity() + m_elementsInvJ.capacity())*sizeof(double) +
+              m_geometryCacheSize*sizeof(std::atomic<unsigned int>);
+
+    //Each node of a std::map holds about three pointers and a color besides its value
+    memory += m_boundFSNormal.size()*(sizeof(std::pair<const std::size_t, std::array<double, 3>>) + 4*sizeof(void*)) +
+              m_freeSurfaceCurvature.size()*(sizeof(std::pair<const std::size_t, double>) + 4*sizeof(void*));
+
+    return memory;
+}
+
+void Mesh::invalidateGeometry() noexcept
+{
+    constexpr unsigned int geometryBusy = std::numeric_limits<unsigned int>::max();
+
+    ++m_geometryEpoch;
+
+    //On wrap around, old stamps could match again: start over from a clean cache
+    if(m_geometryEpoch == geometryBusy)
+    {
+        m_geometryEpoch = 1;
+        for(std::size_t elm = 0 ; elm < m_geometryCacheSize ; ++elm)
+            m_elementsGeometryEpoch[elm].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Mesh::invalidateMovingElementsGeometry() noexcept
+{
+    #pragma omp parallel for default(shared)
+    for(std::size_t elm = 0 ; elm < m_geometryCacheSize ; ++elm)
+    {
+        for(std::size_t n : m_elementsList[elm].m_nodesIndexes)
+        {
+            if(!m_nodesList[n].m_isFixed)
+            {
+                m_elementsGeometryEpoch[elm].store(0, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+}
+
+void Mesh::invalidateNodesGeometry(const std::vector<std::size_t>& nodesIndexes) noexcept
+{
+    #pragma omp parallel for default(shared)
+    for(std::size_t i = 0 ; i < nodesIndexes.size() ; ++i)
+    {
+        for(std::size_t elm : m_nodesList[nodesIndexes[i]].m_elements)
+        {
+            if(elm < m_geometryCacheSize)
+                m_elementsGeometryEpoch[elm].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Mesh::resetGeometryCache()
+{
+    m_geometryCacheSize = m_elementsList.size();
+    m_elementsDetJ.resize(m_geometryCacheSize);
+    m_elementsInvJ.resize(m_dim*m_dim*m_geometryCacheSize);
+
+    m_elementsGeometryEpoch = std::make_unique<std::atomic<unsigned int>[]>(m_geometryCacheSize);
+    for(std::size_t elm = 0 ; elm < m_geometryCacheSize ; ++elm)
+        m_elementsGeometryEpoch[elm].store(0, std::memory_order_relaxed);
 }
 
 void Mesh::remesh(bool verboseOutput)
 {
     laplacianSmoothingBoundaries();
+    invalidateGeometry();
+    const std::size_t nodesCount = m_nodesList.size();
     addNodes(verboseOutput);
+    const std::size_t addedNodesCount = m_nodesList.size() - nodesCount;
+    m_addedNodesCount += addedNodesCount;
     removeNodes(verboseOutput);
+    invalidateGeometry();
     checkBoundingBox(verboseOutput);
+    invalidateGeometry();
+    m_removedNodesCount += nodesCount + addedNodesCount - m_nodesList.size();
     triangulateAlphaShape();
 }
 
@@ -1018,19 +1379,29 @@ bool Mesh::removeNodes(bool verboseOutput) noexcept
 
 void Mesh::restoreNodesList()
 {
-    if(m_nodesListSave.empty())
+    if(m_nodesCountSave == 0)
         throw std::runtime_error("the nodes list was not saved before or does not exist!");
 
-    m_nodesList = std::move(m_nodesListSave);
+    if(m_nodesCountSave != m_nodesList.size())
+        throw std::runtime_error("the nodes list changed since it was saved!");
+
+    const std::size_t nodesCount = m_nodesList.size();
+    const std::size_t statesCount = m_nodesStatesSave.size()/nodesCount;
 
     #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < m_elementsList.size() ; ++elm)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
     {
-        m_elementsList[elm].computeJ();
-        m_elementsList[elm].computeDetJ();
-        m_elementsList[elm].computeInvJ();
+        for(unsigned short d = 0 ; d < m_dim ; ++d)
+            m_nodesList[n].m_position[d] = m_nodesPositionSave[n + d*nodesCount];
+
+        for(std::size_t s = 0 ; s < statesCount ; ++s)
+            m_nodesList[n].m_states[s] = m_nodesStatesSave[n + s*nodesCount];
     }
 
+    m_nodesCountSave = 0;
+
+    invalidateMovingElementsGeometry();
+
     #pragma omp parallel for default(shared)
     for(std::size_t facet = 0 ; facet < m_facetsList.size() ; ++facet)
     {
@@ -1049,21 +1420,148 @@ void Mesh::saveNodesList()
     if(m_nodesList.empty())
         throw std::runtime_error("the nodes list does not exist!");
 
-    m_nodesListSave = m_nodesList;
+    const std::size_t nodesCount = m_nodesList.size();
+    const std::size_t statesCount = m_nodesList[0].m_states.size();
+
+    //The buffers keep their capacity from one step to the next
+    m_nodesPositionSave.resize(m_dim*nodesCount);
+    m_nodesStatesSave.resize(statesCount*nodesCount);
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        for(unsigned short d = 0 ; d < m_dim ; ++d)
+            m_nodesPositionSave[n + d*nodesCount] = m_nodesList[n].m_position[d];
+
+        for(std::size_t s = 0 ; s < statesCount ; ++s)
+            m_nodesStatesSave[n + s*nodesCount] = m_nodesList[n].m_states[s];
+    }
+
+    m_nodesCountSave = nodesCount;
+}
+
+void Mesh::savePointCloud(const std::string& fileName) const
+{
+    std::ofstream file(fileName, std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("cannot open the point cloud file " + fileName + "!");
+
+    writeBinary(file, "PFEMPTS1", 8);
+    writeCheckpoint(file);
+
+    if(!file)
+        throw std::runtime_error("error while writing the point cloud file " + fileName + "!");
+}
+
+void Mesh::writeCheckpoint(std::ostream& file, bool writeConnectivity) const
+{
+    const std::uint64_t nodesCount = m_nodesList.size();
+    const std::uint64_t statesCount = m_nodesList.empty() ? 0 : m_nodesList[0].m_states.size();
+
+    std::vector<double> positions(m_dim*nodesCount);
+    std::vector<double> states(statesCount*nodesCount);
+    std::vector<std::int32_t> tags(nodesCount);
+    std::vector<std::uint8_t> flags(nodesCount);
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        const Node& node = m_nodesList[n];
+        for(unsigned short d = 0 ; d < m_dim ; ++d)
+            positions[n + d*nodesCount] = node.m_position[d];
+
+        for(std::size_t st = 0 ; st < statesCount ; ++st)
+            states[n + st*nodesCount] = node.m_states[st];
+
+        tags[n] = node.m_tag;
+        flags[n] = static_cast<std::uint8_t>((node.m_isBound ? 1 : 0) | (node.m_isFixed ? 2 : 0));
+    }
+
+    writeBinary(file, "MESH", 4);
+    writeBinary(file, &m_dim, 1);
+
+    const std::uint64_t tagsCount = m_tagNames.size();
+    writeBinary(file, &tagsCount, 1);
+    for(const auto& tagName : m_tagNames)
+    {
+        const std::uint64_t size = tagName.size();
+        writeBinary(file, &size, 1);
+        writeBinary(file, tagName.data(), tagName.size());
+    }
+
+    //One large sequential write per array
+    writeBinary(file, &nodesCount, 1);
+    writeBinary(file, &statesCount, 1);
+    writeBinary(file, positions.data(), positions.size());
+    writeBinary(file, states.data(), states.size());
+    writeBinary(file, tags.data(), tags.size());
+    writeBinary(file, flags.data(), flags.size());
+
+    if(!writeConnectivity)
+        return;
+
+    const std::uint64_t elementsCount = m_elementsList.size();
+    const std::uint64_t facetsCount = m_facetsList.size();
+    const std::size_t nodesPerElm = m_dim + 1u;
+
+    std::vector<std::uint64_t> elementsNodes(nodesPerElm*elementsCount);
+    std::vector<std::uint64_t> neighboursCount(elementsCount);
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+    {
+        std::copy(m_elementsList[elm].m_nodesIndexes.begin(), m_elementsList[elm].m_nodesIndexes.end(),
+                  elementsNodes.begin() + static_cast<std::ptrdiff_t>(elm*nodesPerElm));
+        neighboursCount[elm] = m_elementsList[elm].m_neighbourElements.size();
+    }
+
+    std::vector<std::uint64_t> neighbours;
+    for(const Element& element : m_elementsList)
+        neighbours.insert(neighbours.end(), element.m_neighbourElements.begin(), element.m_neighbourElements.end());
+
+    //Nodes, node in front of the facet and element of each facet
+    std::vector<std::uint64_t> facets((m_dim + 2u)*facetsCount);
+    for(std::size_t f = 0 ; f < facetsCount ; ++f)
+    {
+        const Facet& facet = m_facetsList[f];
+        std::copy(facet.m_nodesIndexes.begin(), facet.m_nodesIndexes.end(),
+                  facets.begin() + static_cast<std::ptrdiff_t>(f*(m_dim + 2u)));
+        facets[f*(m_dim + 2u) + m_dim] = facet.m_outNodeIndex;
+        facets[f*(m_dim + 2u) + m_dim + 1] = facet.m_elementIndex;
+    }
+
+    std::vector<std::uint8_t> freeSurface(nodesCount);
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+        freeSurface[n] = m_nodesList[n].m_isOnFreeSurface ? 1 : 0;
+
+    const std::uint64_t neighboursSize = neighbours.size();
+
+    writeBinary(file, "CONN", 4);
+    writeBinary(file, &elementsCount, 1);
+    writeBinary(file, elementsNodes.data(), elementsNodes.size());
+    writeBinary(file, neighboursCount.data(), neighboursCount.size());
+    writeBinary(file, &neighboursSize, 1);
+    writeBinary(file, neighbours.data(), neighbours.size());
+    writeBinary(file, &facetsCount, 1);
+    writeBinary(file, facets.data(), facets.size());
+    writeBinary(file, freeSurface.data(), freeSurface.size());
 }
 
 void Mesh::triangulateAlphaShape()
 {
+    //The elements list is rebuilt: geometry is computed on the fly until the cache is reset
+    m_geometryCacheSize = 0;
+
     if(m_dim == 2)
         triangulateAlphaShape2D();
     else
         triangulateAlphaShape3D();
+
+    resetGeometryCache();
 }
 
 void Mesh::updateNodesPosition(const std::vector<double>& deltaPos)
 {
     if(deltaPos.size() != m_nodesList.size()*m_dim)
-        throw std::runtime_error("invalid size of the deltaPos vector: " + std::to_string(deltaPos.size()) + " VS " + std::to_string(m_nodesListSave.size()*m_dim));
+        throw std::runtime_error("invalid size of the deltaPos vector: " + std::to_string(deltaPos.size()) + " VS " + std::to_string(m_nodesList.size()*m_dim));
 
     #pragma omp parallel for default(shared)
     for(std::size_t n = 0 ; n < m_nodesList.size() ; ++n)
@@ -1077,13 +1575,7 @@ void Mesh::updateNodesPosition(const std::vector<double>& deltaPos)
         }
     }
 
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < m_elementsList.size() ; ++elm)
-    {
-        m_elementsList[elm].computeJ();
-        m_elementsList[elm].computeDetJ();
-        m_elementsList[elm].computeInvJ();
-    }
+    invalidateMovingElementsGeometry();
 
     #pragma omp parallel for default(shared)
     for(std::size_t facet = 0 ; facet < m_facetsList.size() ; ++facet)
@@ -1101,7 +1593,7 @@ void Mesh::updateNodesPosition(const std::vector<double>& deltaPos)
 void Mesh::updateNodesPosition(const Eigen::VectorXd& deltaPos)
 {
     if(static_cast<std::size_t>(deltaPos.rows()) < m_nodesList.size()*m_dim)
-        throw std::runtime_error("invalid size of the deltaPos vector: " + std::to_string(deltaPos.rows()) + " VS " + std::to_string(m_nodesListSave.size()*m_dim));
+        throw std::runtime_error("invalid size of the deltaPos vector: " + std::to_string(deltaPos.rows()) + " VS " + std::to_string(m_nodesList.size()*m_dim));
 
     #pragma omp parallel for default(shared)
     for(std::size_t n = 0 ; n < m_nodesList.size() ; ++n)
@@ -1115,13 +1607,7 @@ void Mesh::updateNodesPosition(const Eigen::VectorXd& deltaPos)
         }
     }
 
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < m_elementsList.size() ; ++elm)
-    {
-        m_elementsList[elm].computeJ();
-        m_elementsList[elm].computeDetJ();
-        m_elementsList[elm].computeInvJ();
-    }
+    invalidateMovingElementsGeometry();
 
     #pragma omp parallel for default(shared)
     for(std::size_t facet = 0 ; facet < m_facetsList.size() ; ++facet)
@@ -1142,17 +1628,10 @@ void Mesh::updateNodesPosition(const Eigen::VectorXd& deltaPos,
     if(static_cast<std::size_t>(deltaPos.rows()/m_dim) != nodesIndexes.size())
         throw std::runtime_error("size of deltaPos and nodesIndexes vector must be dim*x and x!");
 
-    std::set<std::size_t> elementModified;
     std::set<std::size_t> facetModified;
     for(std::size_t n : nodesIndexes)
     {
         const Node& node = m_nodesList[n];
-        for(unsigned int e = 0 ; e < node.getElementCount() ; ++e)
-        {
-            elementModified.insert(node.getElementMeshIndex(e));
-
-        }
-
         for(unsigned int f = 0 ; f < node.getFacetCount() ; ++f)
         {
             facetModified.insert(node.getFacetMeshIndex(f));
@@ -1174,12 +1653,7 @@ void Mesh::updateNodesPosition(const Eigen::VectorXd& deltaPos,
         }
     }
 
-    for(auto it = elementModified.begin() ; it != elementModified.end() ; ++it)
-    {
-        m_elementsList[*it].computeJ();
-        m_elementsList[*it].computeDetJ();
-        m_elementsList[*it].computeInvJ();
-    }
+    invalidateNodesGeometry(nodesIndexes);
 
     for(auto it = facetModified.begin() ; it != facetModified.end() ; ++it)
     {
@@ -1196,11 +1670,11 @@ void Mesh::updateNodesPosition(const Eigen::VectorXd& deltaPos,
 
 void Mesh::updateNodesPositionFromSave(const std::vector<double>& deltaPos)
 {
-    if(m_nodesListSave.empty())
+    if(m_nodesCountSave != m_nodesList.size())
         throw std::runtime_error("you did not save the nodes list!");
 
-    if(deltaPos.size() != m_nodesListSave.size()*m_dim)
-        throw std::runtime_error("invalid size of the deltaPos vector: " + std::to_string(deltaPos.size()) + " VS " + std::to_string(m_nodesListSave.size()*m_dim));
+    if(deltaPos.size() != m_nodesCountSave*m_dim)
+        throw std::runtime_error("invalid size of the deltaPos vector: " + std::to_string(deltaPos.size()) + " VS " + std::to_string(m_nodesCountSave*m_dim));
 
     #pragma omp parallel for default(shared)
     for(std::size_t n = 0 ; n < m_nodesList.size() ; ++n)
@@ -1209,18 +1683,12 @@ void Mesh::updateNodesPositionFromSave(const std::vector<double>& deltaPos)
         {
             for(unsigned short d = 0 ; d < m_dim ; ++d)
             {
-                m_nodesList[n].m_position[d] = m_nodesListSave[n].m_position[d] + deltaPos[n + d*m_nodesList.size()];
+                m_nodesList[n].m_position[d] = m_nodesPositionSave[n + d*m_nodesCountSave] + deltaPos[n + d*m_nodesList.size()];
             }
         }
     }
 
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < m_elementsList.size() ; ++elm)
-    {
-        m_elementsList[elm].computeJ();
-        m_elementsList[elm].computeDetJ();
-        m_elementsList[elm].computeInvJ();
-    }
+    invalidateMovingElementsGeometry();
 
     #pragma omp parallel for default(shared)
     for(std::size_t facet = 0 ; facet < m_facetsList.size() ; ++facet)
@@ -1237,11 +1705,11 @@ void Mesh::updateNodesPositionFromSave(const std::vector<double>& deltaPos)
 
 void Mesh::updateNodesPositionFromSave(const Eigen::VectorXd& deltaPos)
 {
-    if(m_nodesListSave.empty())
+    if(m_nodesCountSave != m_nodesList.size())
         throw std::runtime_error("you did not save the nodes list!");
 
-    if(static_cast<std::size_t>(deltaPos.rows()) < m_nodesListSave.size()*m_dim)
-        throw std::runtime_error("invalid size of the deltaPos vector: " + std::to_string(deltaPos.rows()) + " VS " + std::to_string(m_nodesListSave.size()*m_dim));
+    if(static_cast<std::size_t>(deltaPos.rows()) < m_nodesCountSave*m_dim)
+        throw std::runtime_error("invalid size of the deltaPos vector: " + std::to_string(deltaPos.rows()) + " VS " + std::to_string(m_nodesCountSave*m_dim));
 
     #pragma omp parallel for default(shared)
     for(std::size_t n = 0 ; n < m_nodesList.size() ; ++n)
@@ -1250,18 +1718,12 @@ void Mesh::updateNodesPositionFromSave(const Eigen::VectorXd& deltaPos)
         {
             for(unsigned short d = 0 ; d < m_dim ; ++d)
             {
-                m_nodesList[n].m_position[d] = m_nodesListSave[n].m_position[d] + deltaPos[n + d*m_nodesList.size()];
+                m_nodesList[n].m_position[d] = m_nodesPositionSave[n + d*m_nodesCountSave] + deltaPos[n + d*m_nodesList.size()];
             }
         }
     }
 
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < m_elementsList.size() ; ++elm)
-    {
-        m_elementsList[elm].computeJ();
-        m_elementsList[elm].computeDetJ();
-        m_elementsList[elm].computeInvJ();
-    }
+    invalidateMovingElementsGeometry();
 
     #pragma omp parallel for default(shared)
     for(std::size_t facet = 0 ; facet < m_facetsList.size() ; ++facet)
@@ -1279,23 +1741,16 @@ void Mesh::updateNodesPositionFromSave(const Eigen::VectorXd& deltaPos)
 void Mesh::updateNodesPositionFromSave(const Eigen::VectorXd& deltaPos,
                                        const std::vector<std::size_t> nodesIndexes)
 {
-    if(m_nodesListSave.empty())
+    if(m_nodesCountSave != m_nodesList.size())
         throw std::runtime_error("you did not save the nodes list!");
 
     if(static_cast<std::size_t>(deltaPos.rows()/m_dim) != nodesIndexes.size())
         throw std::runtime_error("size of deltaPos and nodesIndexes vector must be dim*x and x!");
 
-    std::set<std::size_t> elementModified;
     std::set<std::size_t> facetModified;
     for(std::size_t n : nodesIndexes)
     {
         const Node& node = m_nodesList[n];
-        for(unsigned int e = 0 ; e < node.getElementCount() ; ++e)
-        {
-            elementModified.insert(node.getElementMeshIndex(e));
-
-        }
-
         for(unsigned int f = 0 ; f < node.getFacetCount() ; ++f)
         {
             facetModified.insert(node.getFacetMeshIndex(f));
@@ -1312,17 +1767,12 @@ void Mesh::updateNodesPositionFromSave(const Eigen::VectorXd& deltaPos,
         {
             for(unsigned short d = 0 ; d < m_dim ; ++d)
             {
-                m_nodesList[n].m_position[d] = m_nodesListSave[n].m_position[d] + deltaPos[i + d*nodesIndexes.size()];
+                m_nodesList[n].m_position[d] = m_nodesPositionSave[n + d*m_nodesCountSave] + deltaPos[i + d*nodesIndexes.size()];
             }
         }
     }
 
-    for(auto it = elementModified.begin() ; it != elementModified.end() ; ++it)
-    {
-        m_elementsList[*it].computeJ();
-        m_elementsList[*it].computeDetJ();
-        m_elementsList[*it].computeInvJ();
-    }
+    invalidateNodesGeometry(nodesIndexes);
 
     for(auto it = facetModified.begin() ; it != facetModified.end() ; ++it)
     {
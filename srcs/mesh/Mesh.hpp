@@ -2,6 +2,11 @@
 #ifndef MESH_HPP_INCLUDED
 #define MESH_HPP_INCLUDED
 
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <memory>
 #include <string>
 #include <map>
 #include <Eigen/Dense>
@@ -25,12 +30,37 @@ struct MeshCreateInfo
     std::vector<double> boundingBox = {}; /**< Nodes and elements outised bounding box are deleted. Format:
                                                \f$ [x_{min}, y_{min}, (z_{min}, )x_{max}, y_{max}, (z_{max}) ] \f$ */
     std::vector<std::vector<double>> exclusionZones = {};
-    std::string mshFile = {}; /**< The path to the .msh file to load */
+    std::string mshFile = {}; /**< The path to the .msh (or point cloud) file to load */
     bool addOnFS = true;
     bool deleteFlyingNodes = false;
     bool laplacianSmoothingBoundaries = false;
 };
 
+/**
+ * \struct SyntheticMeshInfo
+ * \brief Structure containing the parameters of a point cloud generated on a jittered lattice instead of
+ * being loaded from a .msh file.
+ *
+ * The fluid lies in a tank with a corner at the origin, the last dimension being the vertical one. The
+ * nodes of the walls (the bottom and the sides up to the tank height, the top being open) are tagged
+ * "Boundary" and the fluid nodes are tagged "Fluid".
+ */
+struct SyntheticMeshInfo
+{
+    std::string shape = "box";          /**< "box" (the fluid fills the tank up to a height), "damBreak" (fluid column in
+                                             the corner of the tank) or "cylinder" (vertical cylinder standing at the
+                                             center of the tank in 3D, disc above the center of the tank in 2D). */
+    unsigned short dim = 2;             /**< The dimension of the cloud (2 or 3). */
+    std::size_t nodesCount = 10000;     /**< The approximate number of nodes, walls included. */
+    std::vector<double> tankSize = {};  /**< Format: \f$ [L_x, (L_y, ) H] \f$ */
+    std::vector<double> fluidSize = {}; /**< Format: \f$ [h] \f$ (box), \f$ [l_x, (l_y, ) h] \f$ (damBreak), or
+                                             \f$ [r, h] \f$ (cylinder, h being the height of the center of the
+                                             disc in 2D). */
+    double jitter = 0.1;                /**< Amplitude of the random displacement of the fluid nodes which are not on
+                                             the free surface, relative to the lattice spacing. */
+    std::uint64_t seed = 0;             /**< Seed of the displacements (the cloud does not depend on the threads count). */
+};
+
 /**
  * \class Mesh
  * \brief Represents a Lagrangian mesh.
@@ -49,6 +79,17 @@ class MESH_API Mesh
         Mesh()                              = delete;
         /// \param meshInfos a reference to a MeshCreateInfo structure
         Mesh(const MeshCreateInfo& meshInfos);
+        /**
+         * \param meshInfos a reference to a MeshCreateInfo structure (the .msh file is not used).
+         * \param checkpoint a stream positioned at the mesh section of a checkpoint (see writeCheckpoint).
+         */
+        Mesh(const MeshCreateInfo& meshInfos, std::istream& checkpoint);
+        /**
+         * \param meshInfos a reference to a MeshCreateInfo structure (the .msh file is not used, hchar should be
+         *                  the lattice spacing, see getSyntheticSpacing).
+         * \param syntheticInfos a reference to the parameters of the generated point cloud.
+         */
+        Mesh(const MeshCreateInfo& meshInfos, const SyntheticMeshInfo& syntheticInfos);
         Mesh(const Mesh& mesh)              = delete;
         Mesh& operator=(const Mesh& mesh)   = delete;
         Mesh(Mesh&& mesh)                   = delete;
@@ -58,6 +99,12 @@ class MESH_API Mesh
         /// \brief Display the mesh parameters to console.
         void displayToConsole() const noexcept;
 
+        /**
+         * \param syntheticInfos The parameters of a generated point cloud.
+         * \return The lattice spacing giving about syntheticInfos.nodesCount nodes (to be used as hchar).
+         */
+        static double getSyntheticSpacing(const SyntheticMeshInfo& syntheticInfos);
+
         void deleteFlyingNodes(bool verboseOutput) noexcept;
 
         /// \return The mesh dimension.
@@ -77,6 +124,18 @@ class MESH_API Mesh
         /// \return The number of boundary face in the mesh.
         inline std::size_t getFacetsCount() const noexcept;
 
+        /// \return The total number of nodes added by remesh.
+        inline std::size_t getAddedNodesCount() const noexcept;
+
+        /// \return The total number of nodes removed by remesh.
+        inline std::size_t getRemovedNodesCount() const noexcept;
+
+        /// \return The memory allocated for the nodes, elements, facets, saved states and geometry cache, in bytes.
+        std::size_t getMemoryUsage() const noexcept;
+
+        /// \return The memory allocated by the CGAL structures during the last triangulation, in bytes.
+        inline std::size_t getTriangulationMemory() const noexcept;
+
         /// \param facetIndex The index of the facet in the facets list.
         /// \return The physical group of that facet.
         inline std::string getFacetType(std::size_t facetIndex) const noexcept;
@@ -118,6 +177,9 @@ class MESH_API Mesh
         /// \return The physical group of that node.
         inline std::string getNodeType(std::size_t nodeIndex) const noexcept;
 
+        /// \return The names of the physical groups, indexed by node tag (see Node::getTag).
+        inline const std::vector<std::string>& getTagNames() const noexcept;
+
 
         /// \param dimension The dimension of the reference element on which you want the weights.
         /// \return The size of the element in the reference coordinate system.
@@ -144,12 +206,28 @@ class MESH_API Mesh
         /// \brief Perform remeshing on the mesh.
         void remesh(bool verboseOutput);
 
-        /// \brief Restore the current nodes list from the list saved in saveNodesList.
+        /// \brief Restore the nodes positions and states saved in saveNodesList.
         void restoreNodesList();
 
-        /// \brief Save the current nodes list in another variable.
+        /// \brief Save the nodes positions and states in a reusable buffer (the connectivity is not saved).
         void saveNodesList();
 
+        /**
+         * \brief Write the nodes (positions, states, tags and flags) and the tag names in a binary checkpoint
+         *        (the connectivity is recomputed at restart unless it is written too).
+         * \param file The stream in which the mesh section is written.
+         * \param writeConnectivity Should the elements and facets be written, so that the exact same mesh is
+         *        loaded back instead of being triangulated again (used to capture a time step) ?
+         */
+        void writeCheckpoint(std::ostream& file, bool writeConnectivity = false) const;
+
+        /**
+         * \brief Save the nodes in a point cloud file which can be given instead of a .msh file
+         *        (it is loaded directly, without gmsh).
+         * \param fileName The name of the point cloud file.
+         */
+        void savePointCloud(const std::string& fileName) const;
+
         /**
          * \brief Activate or not the computation of normals and curvature (default is true).
          * \param activate should the computation be activated
@@ -209,10 +287,22 @@ class MESH_API Mesh
         unsigned short m_dim;               /**< The mesh dimension. */
 
         std::vector<Node> m_nodesList;      /**< List of nodes of the mesh. */
-        std::vector<Node> m_nodesListSave;  /**< A copy of the nodes list (usefull for non-linear algorithm). */
+        std::vector<double> m_nodesPositionSave;    /**< Saved coordinates, coordinate d of node n at n + d*nodesCount (usefull for non-linear algorithm). */
+        std::vector<double> m_nodesStatesSave;      /**< Saved states, state s of node n at n + s*nodesCount. */
+        std::size_t m_nodesCountSave;               /**< Number of nodes in the saved snapshot (0 if nothing is saved). */
         std::vector<Element> m_elementsList;    /**< The list of elements. */
         std::vector<Facet> m_facetsList;        /**< The list of boundary facets. */
 
+        mutable std::vector<double> m_elementsDetJ; /**< Cached determinant of the Jacobian matrix of each element. */
+        mutable std::vector<double> m_elementsInvJ; /**< Cached dim*dim entries of the inverse Jacobian matrices, entry (i,j) of element elm at (i*dim + j)*count + elm. */
+        mutable std::unique_ptr<std::atomic<unsigned int>[]> m_elementsGeometryEpoch; /**< Epoch at which the cached geometry of each element was computed. */
+        std::size_t m_geometryCacheSize;    /**< Number of elements covered by the geometry cache. */
+        unsigned int m_geometryEpoch;       /**< Current geometry epoch (bumped when every element becomes outdated). */
+
+        std::size_t m_addedNodesCount;      /**< Total number of nodes added by remeshing. */
+        std::size_t m_removedNodesCount;    /**< Total number of nodes removed by remeshing. */
+        std::size_t m_triangulationMemory;  /**< Memory allocated by the CGAL structures during the last triangulation. */
+
         std::vector<std::string> m_tagNames; /**< The name of the tag of the nodes. */
         std::map<std::size_t, std::array<double, 3>> m_boundFSNormal;   /**< Free surface and boundary normals normals */
         std::map<std::size_t, double> m_freeSurfaceCurvature;               /**< Free surface curvatures */
@@ -229,9 +319,48 @@ class MESH_API Mesh
          */
         bool checkBoundingBox(bool verboseOutput) noexcept;
 
+        /**
+         * \brief Add the nodes of a physical group which are not already in the nodes list.
+         * \param name The name of the physical group.
+         * \param isBound Should the nodes be boundary nodes.
+         * \param nodesTags The tags of the nodes of the physical group.
+         * \param coord The coordinates of the nodes (3 per node, in the order of nodesTags).
+         * \param isNodeAdded Flags indexed by node tag, updated with the added nodes.
+         */
+        void addPhysicalGroupNodes(const std::string& name, bool isBound,
+                                   const std::vector<std::size_t>& nodesTags,
+                                   const std::vector<double>& coord,
+                                   std::vector<bool>& isNodeAdded);
+
         /// \brief Compute the mesh dimension from the .msh file.
         void computeMeshDim();
 
+        /// \param element The element (which should be inside the elements list).
+        /// \return The determinant of the Jacobian matrix of the element, computed if outdated.
+        inline double getElementDetJ(const Element& element) const noexcept;
+
+        /// \param element The element (which should be inside the elements list).
+        /// \return The element (i,j) of the inverse of the Jacobian matrix of the element, computed if outdated.
+        inline double getElementInvJ(const Element& element, unsigned int i, unsigned int j) const noexcept;
+
+        /// \return The index of the element in the geometry cache, or the cache size if it is not covered.
+        inline std::size_t getGeometryCacheIndex(const Element& element) const noexcept;
+
+        /// \brief Mark the geometry of every element as outdated (O(1)).
+        void invalidateGeometry() noexcept;
+
+        /// \brief Mark the geometry of the elements which contain at least one moving node as outdated.
+        void invalidateMovingElementsGeometry() noexcept;
+
+        /// \brief Mark the geometry of the elements around the given nodes as outdated.
+        void invalidateNodesGeometry(const std::vector<std::size_t>& nodesIndexes) noexcept;
+
+        /// \brief Resize the geometry cache to the current elements list and mark everything as outdated.
+        void resetGeometryCache();
+
+        /// \brief Compute the geometry of the element elm if it is outdated (thread-safe).
+        inline void updateElementGeometry(std::size_t elm) const noexcept;
+
         /// \brief Compute the normal and curvature of each boundary and free surface.
         void computeFSNormalCurvature();
 
@@ -244,11 +373,46 @@ class MESH_API Mesh
         void laplacianSmoothingBoundaries();
 
         /**
-         * \brief Load the nodes from a file using gmsh.
-         * \param fileName The name of the .msh file.
+         * \brief Load the nodes from a checkpoint written by writeCheckpoint and triangulate them (or load
+         *        the connectivity if the checkpoint contains it).
+         * \param file The stream positioned at the mesh section.
+         */
+        void loadFromCheckpoint(std::istream& file);
+
+        /**
+         * \brief Load the elements and facets written by writeCheckpoint and rebuild the nodes adjacency.
+         * \param file The stream positioned after the connectivity section tag.
+         */
+        void loadConnectivity(std::istream& file);
+
+        /**
+         * \brief Load the nodes from a file and triangulate them. Binary MSH 4.1 files are parsed directly,
+         *        point clouds (see savePointCloud) are read as a checkpoint mesh section and other
+         *        formats are loaded through gmsh.
+         * \param fileName The name of the .msh or point cloud file.
          */
         void loadFromFile(const std::string& fileName);
 
+        /**
+         * \brief Generate the nodes of a synthetic point cloud.
+         * \param syntheticInfos The parameters of the point cloud.
+         */
+        void loadSynthetic(const SyntheticMeshInfo& syntheticInfos);
+
+        /**
+         * \brief Load the nodes of the physical groups using gmsh.
+         * \param fileName The name of the .msh file.
+         */
+        void loadFromGmsh(const std::string& fileName);
+
+        /**
+         * \brief Load the nodes of the physical groups by parsing a binary MSH 4.1 file
+         *        (the entity blocks are decoded in parallel).
+         * \param fileName The name of the .msh file.
+         * \return false if the file is not a binary MSH 4.1 file, in which case nothing is loaded.
+         */
+        bool loadFromMSH41Binary(const std::string& fileName);
+
         /// \brief Remesh the nodes in nodesList using CGAL (Delaunay triangulation and alpha-shape).
         void triangulateAlphaShape();
 
@@ -264,6 +428,8 @@ class MESH_API Mesh
          * \return true if at least one node was deleted, false otherwise.
          */
         bool removeNodes(bool verboseOutput) noexcept;
+
+        friend class Element;
 };
 
 #include "Mesh.inl"
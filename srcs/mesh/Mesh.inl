@@ -1,6 +1,7 @@
 #include "Mesh.hpp"
 
 #include <array>
+#include <functional>
 #include <iostream>
 
 inline unsigned short Mesh::getDim() const noexcept
@@ -28,6 +29,21 @@ inline std::size_t Mesh::getFacetsCount() const noexcept
     return m_facetsList.size();
 }
 
+inline std::size_t Mesh::getAddedNodesCount() const noexcept
+{
+    return m_addedNodesCount;
+}
+
+inline std::size_t Mesh::getRemovedNodesCount() const noexcept
+{
+    return m_removedNodesCount;
+}
+
+inline std::size_t Mesh::getTriangulationMemory() const noexcept
+{
+    return m_triangulationMemory;
+}
+
 inline std::string Mesh::getFacetType(std::size_t facetIndex) const noexcept
 {
     std::size_t nodeIndex = m_facetsList[facetIndex].m_nodesIndexes[0];
@@ -101,6 +117,11 @@ inline std::string Mesh::getNodeType(std::size_t nodeIndex) const noexcept
     return m_tagNames[m_nodesList[nodeIndex].m_tag];
 }
 
+inline const std::vector<std::string>& Mesh::getTagNames() const noexcept
+{
+    return m_tagNames;
+}
+
 inline bool Mesh::isNormalCurvComputed() const noexcept
 {
     return m_computeNormalCurvature;
@@ -128,3 +149,82 @@ void Mesh::setStatesNumber(unsigned int statesNumber)
         m_nodesList[n].m_states.resize(statesNumber);
     }
 }
+
+inline std::size_t Mesh::getGeometryCacheIndex(const Element& element) const noexcept
+{
+    std::less<const Element*> lessThan;
+    const Element* pFirst = m_elementsList.data();
+    if(lessThan(&element, pFirst) || !lessThan(&element, pFirst + m_geometryCacheSize))
+        return m_geometryCacheSize;
+
+    return static_cast<std::size_t>(&element - pFirst);
+}
+
+inline void Mesh::updateElementGeometry(std::size_t elm) const noexcept
+{
+    constexpr unsigned int geometryBusy = std::numeric_limits<unsigned int>::max();
+
+    std::atomic<unsigned int>& elementEpoch = m_elementsGeometryEpoch[elm];
+    unsigned int epoch = elementEpoch.load(std::memory_order_acquire);
+    if(epoch == m_geometryEpoch)
+        return;
+
+    //Only one thread computes the geometry, the others wait for it to be published
+    if(epoch != geometryBusy && elementEpoch.compare_exchange_strong(epoch, geometryBusy, std::memory_order_acquire))
+    {
+        const Element& element = m_elementsList[elm];
+        const std::array<std::array<double, 3>, 3> J = element.computeJ();
+        const double detJ = element.computeDetJ(J);
+        const std::array<std::array<double, 3>, 3> invJ = element.computeInvJ(J, detJ);
+
+        m_elementsDetJ[elm] = detJ;
+        for(unsigned short i = 0 ; i < m_dim ; ++i)
+        {
+            for(unsigned short j = 0 ; j < m_dim ; ++j)
+                m_elementsInvJ[(i*m_dim + j)*m_geometryCacheSize + elm] = invJ[i][j];
+        }
+
+        elementEpoch.store(m_geometryEpoch, std::memory_order_release);
+    }
+    else
+    {
+        while(elementEpoch.load(std::memory_order_acquire) != m_geometryEpoch)
+            continue;
+    }
+}
+
+inline double Mesh::getElementDetJ(const Element& element) const noexcept
+{
+    std::size_t elm = getGeometryCacheIndex(element);
+    if(elm == m_geometryCacheSize)
+        return element.computeDetJ(element.computeJ());
+
+    updateElementGeometry(elm);
+    return m_elementsDetJ[elm];
+}
+
+inline double Mesh::getElementInvJ(const Element& element, unsigned int i, unsigned int j) const noexcept
+{
+    if(i >= m_dim || j >= m_dim)
+        return 0;
+
+    std::size_t elm = getGeometryCacheIndex(element);
+    if(elm == m_geometryCacheSize)
+    {
+        const std::array<std::array<double, 3>, 3> J = element.computeJ();
+        return element.computeInvJ(J, element.computeDetJ(J))[i][j];
+    }
+
+    updateElementGeometry(elm);
+    return m_elementsInvJ[(i*m_dim + j)*m_geometryCacheSize + elm];
+}
+
+inline double Element::getDetJ() const noexcept
+{
+    return m_pMesh->getElementDetJ(*this);
+}
+
+inline double Element::getInvJ(unsigned int i, unsigned int j) const noexcept
+{
+    return m_pMesh->getElementInvJ(*this, i, j);
+}
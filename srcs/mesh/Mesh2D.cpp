@@ -54,6 +54,11 @@ void Mesh::triangulateAlphaShape2D()
     const Alpha_shape_2 as(pointsList.begin(), pointsList.end(), m_alpha*m_alpha*m_hchar*m_hchar,
                            Alpha_shape_2::GENERAL);
 
+    //The alpha shape interval maps are not accounted, the triangulation dominates
+    m_triangulationMemory = pointsList.capacity()*sizeof(std::pair<Point_2, std::size_t>) +
+                            as.tds().vertices().capacity()*sizeof(Alpha_shape_2::Vertex) +
+                            as.tds().faces().capacity()*sizeof(Alpha_shape_2::Face);
+
     auto checkFaceDeletion = [&](Alpha_shape_2::Face_handle face) -> bool
     {
         std::size_t in0 = face->vertex(0)->info(), in1 = face->vertex(1)->info(), in2 = face->vertex(2)->info();
@@ -168,10 +173,6 @@ void Mesh::triangulateAlphaShape2D()
         element.m_neighbourElements.resize(neighborElements.size());
         std::copy(neighborElements.begin(), neighborElements.end(), element.m_neighbourElements.begin());
 
-        element.computeJ();
-        element.computeDetJ();
-        element.computeInvJ();
-
         // Those nodes are not free (flying nodes and not wetted boundary nodes)
         m_nodesList[in0].m_neighbourNodes.push_back(in1);
         m_nodesList[in0].m_neighbourNodes.push_back(in2);
@@ -59,6 +59,10 @@ void Mesh::triangulateAlphaShape3D()
 
     const Alpha_shape_3 as(pointsList.begin(), pointsList.end(), m_alpha*m_alpha*m_hchar*m_hchar);
 
+    m_triangulationMemory = pointsList.capacity()*sizeof(std::pair<Point_3, std::size_t>) +
+                            as.tds().vertices().capacity()*sizeof(Alpha_shape_3::Vertex) +
+                            as.tds().cells().capacity()*sizeof(Alpha_shape_3::Cell);
+
     auto checkCellDeletion = [&](Alpha_shape_3::Cell_handle cell) -> bool
     {
         std::size_t in0 = cell->vertex(0)->info(), in1 = cell->vertex(1)->info(),
@@ -168,9 +172,6 @@ void Mesh::triangulateAlphaShape3D()
 
         Element element(*this);
         element.m_nodesIndexes = {in0, in1, in2, in3};
-        element.computeJ();
-        element.computeDetJ();
-        element.computeInvJ();
 
         std::set<std::size_t> neighborElements;
         for(unsigned short i = 0 ; i < 4 ; ++i)
@@ -0,0 +1,376 @@
+#include "Mesh.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+
+/// \return The next line of the buffer (without the end of line), starting at pos.
+static std::string readLine(const std::vector<char>& data, std::size_t& pos)
+{
+    const std::size_t start = pos;
+    while(pos < data.size() && data[pos] != '\n')
+        ++pos;
+
+    std::size_t end = pos;
+    if(pos < data.size())
+        ++pos;
+
+    if(end > start && data[end - 1] == '\r')
+        --end;
+
+    return std::string(data.data() + start, end - start);
+}
+
+/// \return The (possibly unaligned) binary value at pos in the buffer.
+template<typename T>
+static T readValue(const std::vector<char>& data, std::size_t& pos)
+{
+    if(pos + sizeof(T) > data.size())
+        throw std::runtime_error("unexpected end of the .msh file!");
+
+    T value;
+    std::memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+/// \brief Move pos past count bytes of the buffer.
+static void skipBytes(const std::vector<char>& data, std::size_t& pos, std::size_t count)
+{
+    if(count > data.size() - pos)
+        throw std::runtime_error("unexpected end of the .msh file!");
+
+    pos += count;
+}
+
+/// \brief Move pos after the line endTag.
+static void skipSection(const std::vector<char>& data, std::size_t& pos, const std::string& endTag)
+{
+    while(pos < data.size())
+    {
+        if(readLine(data, pos) == endTag)
+            return;
+    }
+
+    throw std::runtime_error("missing " + endTag + " in the .msh file!");
+}
+
+/// \return The number of nodes of an element type of the MSH format (0 if it is not supported).
+static std::size_t getMSHNodesPerElement(int elementType)
+{
+    switch(elementType)
+    {
+        case 1: return 2;   // 2-node line
+        case 2: return 3;   // 3-node triangle
+        case 3: return 4;   // 4-node quadrangle
+        case 4: return 4;   // 4-node tetrahedron
+        case 5: return 8;   // 8-node hexahedron
+        case 6: return 6;   // 6-node prism
+        case 7: return 5;   // 5-node pyramid
+        case 8: return 3;   // 3-node line
+        case 9: return 6;   // 6-node triangle
+        case 10: return 9;  // 9-node quadrangle
+        case 11: return 10; // 10-node tetrahedron
+        case 15: return 1;  // 1-node point
+        default: return 0;
+    }
+}
+
+bool Mesh::loadFromMSH41Binary(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+        throw std::runtime_error("the input .msh file does not exist!");
+
+    const std::streamoff fileSize = file.tellg();
+    file.seekg(0);
+
+    // Check the header before reading the whole file
+    std::string line;
+    std::getline(file, line);
+    if(!line.empty() && line.back() == '\r')
+        line.pop_back();
+    if(line != "$MeshFormat")
+        return false;
+
+    std::getline(file, line);
+    std::istringstream header(line);
+    std::string version;
+    int fileType = 0;
+    std::size_t dataSize = 0;
+    header >> version >> fileType >> dataSize;
+    if(version != "4.1" || fileType != 1 || dataSize != sizeof(std::size_t))
+        return false;
+
+    // Files written with another endianness are left to gmsh
+    int one = 0;
+    file.read(reinterpret_cast<char*>(&one), sizeof(int));
+    if(!file || one != 1)
+        return false;
+
+    // One large read of the whole file, which is then decoded in memory
+    std::vector<char> data(static_cast<std::size_t>(fileSize));
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if(!file)
+        throw std::runtime_error("error while reading the .msh file!");
+    file.close();
+
+    std::map<std::pair<int, int>, std::string> physicalNames;
+    std::map<std::pair<int, int>, std::vector<int>> entitiesPhysicalTags;
+
+    struct NodeBlock
+    {
+        std::size_t count;
+        std::size_t tagsOffset;
+        std::size_t coordOffset;
+        std::size_t valuesPerNode;
+    };
+    std::vector<NodeBlock> nodeBlocks;
+    std::size_t maxNodeTag = 0;
+
+    struct ElementBlock
+    {
+        int entityDim;
+        int entityTag;
+        int elementType;
+        std::size_t count;
+        std::size_t offset;
+    };
+    std::vector<ElementBlock> elementBlocks;
+
+    std::size_t pos = 0;
+    while(pos < data.size())
+    {
+        const std::string section = readLine(data, pos);
+        if(section.empty())
+            continue;
+        else if(section[0] != '$')
+            throw std::runtime_error("unexpected line in the .msh file: " + section);
+
+        if(section == "$PhysicalNames")
+        {
+            const std::size_t physicalNamesCount = std::stoul(readLine(data, pos));
+            for(std::size_t i = 0 ; i < physicalNamesCount ; ++i)
+            {
+                const std::string nameLine = readLine(data, pos);
+                std::istringstream nameStream(nameLine);
+                int dim, tag;
+                nameStream >> dim >> tag;
+
+                const std::size_t first = nameLine.find('"');
+                const std::size_t last = nameLine.rfind('"');
+                if(!nameStream || first == std::string::npos || last == first)
+                    throw std::runtime_error("invalid physical name in the .msh file: " + nameLine);
+
+                physicalNames[{dim, tag}] = nameLine.substr(first + 1, last - first - 1);
+            }
+        }
+        else if(section == "$Entities")
+        {
+            std::size_t entitiesCount[4];
+            for(unsigned short d = 0 ; d < 4 ; ++d)
+                entitiesCount[d] = readValue<std::size_t>(data, pos);
+
+            for(int d = 0 ; d < 4 ; ++d)
+            {
+                for(std::size_t i = 0 ; i < entitiesCount[d] ; ++i)
+                {
+                    const int tag = readValue<int>(data, pos);
+                    skipBytes(data, pos, (d == 0 ? 3 : 6)*sizeof(double));
+
+                    const std::size_t physicalTagsCount = readValue<std::size_t>(data, pos);
+                    std::vector<int>& physicalTags = entitiesPhysicalTags[{d, tag}];
+                    physicalTags.resize(physicalTagsCount);
+                    for(auto& physicalTag : physicalTags)
+                        physicalTag = readValue<int>(data, pos);
+
+                    if(d > 0)
+                    {
+                        const std::size_t boundingCount = readValue<std::size_t>(data, pos);
+                        skipBytes(data, pos, boundingCount*sizeof(int));
+                    }
+                }
+            }
+        }
+        else if(section == "$Nodes")
+        {
+            const std::size_t blocksCount = readValue<std::size_t>(data, pos);
+            readValue<std::size_t>(data, pos);
+            readValue<std::size_t>(data, pos);
+            maxNodeTag = readValue<std::size_t>(data, pos);
+
+            // The blocks are located sequentially, then decoded in parallel
+            nodeBlocks.resize(blocksCount);
+            for(auto& block : nodeBlocks)
+            {
+                const int entityDim = readValue<int>(data, pos);
+                readValue<int>(data, pos);
+                const int parametric = readValue<int>(data, pos);
+                block.count = readValue<std::size_t>(data, pos);
+                block.valuesPerNode = 3 + static_cast<std::size_t>(parametric ? entityDim : 0);
+                block.tagsOffset = pos;
+                skipBytes(data, pos, block.count*sizeof(std::size_t));
+                block.coordOffset = pos;
+                skipBytes(data, pos, block.count*block.valuesPerNode*sizeof(double));
+            }
+        }
+        else if(section == "$Elements")
+        {
+            const std::size_t blocksCount = readValue<std::size_t>(data, pos);
+            readValue<std::size_t>(data, pos);
+            readValue<std::size_t>(data, pos);
+            readValue<std::size_t>(data, pos);
+
+            elementBlocks.resize(blocksCount);
+            for(auto& block : elementBlocks)
+            {
+                block.entityDim = readValue<int>(data, pos);
+                block.entityTag = readValue<int>(data, pos);
+                block.elementType = readValue<int>(data, pos);
+                block.count = readValue<std::size_t>(data, pos);
+                block.offset = pos;
+
+                const std::size_t nodesPerElement = getMSHNodesPerElement(block.elementType);
+                if(nodesPerElement == 0)
+                    return false;
+
+                skipBytes(data, pos, block.count*(1 + nodesPerElement)*sizeof(std::size_t));
+            }
+        }
+
+        skipSection(data, pos, "$End" + section.substr(1));
+    }
+
+    // Check that the mesh is not hybrid, as in computeMeshDim
+    int elementDim = -1;
+    for(int d = 2 ; d <= 3 ; ++d)
+    {
+        std::set<int> elementTypes;
+        for(const auto& block : elementBlocks)
+        {
+            if(block.entityDim == d)
+                elementTypes.insert(block.elementType);
+        }
+
+        switch(elementTypes.size())
+        {
+            case 0:
+                break;
+            case 1:
+                elementDim = d;
+                break;
+            default:
+                throw std::runtime_error("do not use hybrid meshes for PFEM simulations!");
+        }
+    }
+
+    if(elementDim == -1)
+        throw std::runtime_error("there is no suitable elements in the .msh file!");
+    else
+        m_dim = static_cast<unsigned short>(elementDim);
+
+    std::vector<double> nodesCoord(3*(maxNodeTag + 1), 0.0);
+    bool validTags = true;
+
+    #pragma omp parallel for default(shared) schedule(dynamic) reduction(&&:validTags)
+    for(std::size_t b = 0 ; b < nodeBlocks.size() ; ++b)
+    {
+        const NodeBlock& block = nodeBlocks[b];
+        for(std::size_t i = 0 ; i < block.count ; ++i)
+        {
+            std::size_t tag;
+            std::memcpy(&tag, data.data() + block.tagsOffset + i*sizeof(std::size_t), sizeof(std::size_t));
+            if(tag > maxNodeTag)
+            {
+                validTags = false;
+                continue;
+            }
+
+            std::memcpy(&nodesCoord[3*tag], data.data() + block.coordOffset + i*block.valuesPerNode*sizeof(double),
+                        3*sizeof(double));
+        }
+    }
+
+    if(!validTags)
+        throw std::runtime_error("invalid node tag in the .msh file!");
+
+    // Element blocks of each physical group, in the order of gmsh::model::getPhysicalGroups
+    std::map<std::pair<int, int>, std::vector<std::size_t>> physGroupsBlocks;
+    for(const auto& entity : entitiesPhysicalTags)
+    {
+        for(int physicalTag : entity.second)
+            physGroupsBlocks[{entity.first.first, physicalTag}];
+    }
+
+    for(std::size_t b = 0 ; b < elementBlocks.size() ; ++b)
+    {
+        auto entity = entitiesPhysicalTags.find({elementBlocks[b].entityDim, elementBlocks[b].entityTag});
+        if(entity == entitiesPhysicalTags.end())
+            continue;
+
+        for(int physicalTag : entity->second)
+            physGroupsBlocks[{elementBlocks[b].entityDim, physicalTag}].push_back(b);
+    }
+
+    std::vector<char> isInGroup(maxNodeTag + 1, 0);
+    std::vector<bool> isNodeAdded;
+
+    // Boundary groups first, then the domain groups (see loadFromGmsh)
+    for(int dim = m_dim - 1 ; dim <= m_dim ; ++dim)
+    {
+        for(const auto& physGroup : physGroupsBlocks)
+        {
+            if(physGroup.first.first != dim)
+                continue;
+
+            auto physicalName = physicalNames.find(physGroup.first);
+            const std::string name = (physicalName == physicalNames.end()) ? "" : physicalName->second;
+            if(dim == m_dim - 1 && (name == "FreeSurface" || name == "Fluid"))
+                continue;
+
+            for(std::size_t b : physGroup.second)
+            {
+                const ElementBlock& block = elementBlocks[b];
+                const std::size_t nodesPerElement = getMSHNodesPerElement(block.elementType);
+                for(std::size_t e = 0 ; e < block.count ; ++e)
+                {
+                    std::size_t offset = block.offset + (e*(1 + nodesPerElement) + 1)*sizeof(std::size_t);
+                    for(std::size_t n = 0 ; n < nodesPerElement ; ++n)
+                    {
+                        const std::size_t tag = readValue<std::size_t>(data, offset);
+                        if(tag > maxNodeTag)
+                            throw std::runtime_error("invalid node tag in the .msh file!");
+
+                        isInGroup[tag] = 1;
+                    }
+                }
+            }
+
+            // Sorted by tag, like gmsh::model::mesh::getNodesForPhysicalGroup
+            std::vector<std::size_t> nodesTags;
+            for(std::size_t tag = 0 ; tag <= maxNodeTag ; ++tag)
+            {
+                if(isInGroup[tag])
+                {
+                    nodesTags.push_back(tag);
+                    isInGroup[tag] = 0;
+                }
+            }
+
+            std::vector<double> coord(3*nodesTags.size());
+            for(std::size_t i = 0 ; i < nodesTags.size() ; ++i)
+            {
+                for(unsigned short d = 0 ; d < 3 ; ++d)
+                    coord[3*i + d] = nodesCoord[3*nodesTags[i] + d];
+            }
+
+            addPhysicalGroupNodes(name, dim == m_dim - 1, nodesTags, coord, isNodeAdded);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,260 @@
+#include "Mesh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+/// \return A number in [-1, 1[ which only depends on the seed and on the index (splitmix64).
+static double getJitter(std::uint64_t seed, std::uint64_t index) noexcept
+{
+    std::uint64_t z = seed + (index + 1)*0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    z ^= z >> 31;
+
+    return static_cast<double>(z >> 11)*(2.0/9007199254740992.0) - 1.0;
+}
+
+static void checkSyntheticInfos(const SyntheticMeshInfo& infos)
+{
+    if(infos.dim != 2 && infos.dim != 3)
+        throw std::runtime_error("the dimension of the synthetic cloud should be 2 or 3!");
+
+    if(infos.tankSize.size() != infos.dim)
+        throw std::runtime_error("invalid tank size: " + std::to_string(infos.tankSize.size()) + " components instead of " +
+                                 std::to_string(infos.dim) + "!");
+
+    std::size_t fluidSizeCount;
+    if(infos.shape == "box")
+        fluidSizeCount = 1;
+    else if(infos.shape == "damBreak")
+        fluidSizeCount = infos.dim;
+    else if(infos.shape == "cylinder")
+        fluidSizeCount = 2;
+    else
+        throw std::runtime_error("unknown synthetic shape " + infos.shape + "!");
+
+    if(infos.fluidSize.size() != fluidSizeCount)
+        throw std::runtime_error("invalid fluid size for shape " + infos.shape + ": " + std::to_string(infos.fluidSize.size()) +
+                                 " components instead of " + std::to_string(fluidSizeCount) + "!");
+
+    for(double size : infos.tankSize)
+    {
+        if(size <= 0)
+            throw std::runtime_error("the tank size should be strictly greater than 0!");
+    }
+
+    for(double size : infos.fluidSize)
+    {
+        if(size <= 0)
+            throw std::runtime_error("the fluid size should be strictly greater than 0!");
+    }
+
+    const double height = infos.tankSize[infos.dim - 1];
+    bool fits = true;
+    if(infos.shape == "box")
+        fits = infos.fluidSize[0] <= height;
+    else if(infos.shape == "damBreak")
+    {
+        for(unsigned short d = 0 ; d < infos.dim ; ++d)
+            fits = fits && infos.fluidSize[d] <= infos.tankSize[d];
+    }
+    else if(infos.dim == 2)
+        fits = 2*infos.fluidSize[0] < infos.tankSize[0] && infos.fluidSize[1] - infos.fluidSize[0] > 0 &&
+               infos.fluidSize[1] + infos.fluidSize[0] <= height;
+    else
+        fits = 2*infos.fluidSize[0] < std::min(infos.tankSize[0], infos.tankSize[1]) && infos.fluidSize[1] <= height;
+
+    if(!fits)
+        throw std::runtime_error("the fluid does not fit in the tank!");
+
+    if(infos.nodesCount == 0)
+        throw std::runtime_error("the synthetic cloud should have at least one node!");
+
+    if(infos.jitter < 0 || infos.jitter >= 0.5)
+        throw std::runtime_error("the jitter should be in [0, 0.5[!");
+}
+
+double Mesh::getSyntheticSpacing(const SyntheticMeshInfo& syntheticInfos)
+{
+    checkSyntheticInfos(syntheticInfos);
+
+    const unsigned short dim = syntheticInfos.dim;
+    const std::vector<double>& tank = syntheticInfos.tankSize;
+    const std::vector<double>& fluid = syntheticInfos.fluidSize;
+    const double height = tank[dim - 1];
+    const double bottomArea = (dim == 2) ? tank[0] : tank[0]*tank[1];
+
+    double fluidVolume;
+    if(syntheticInfos.shape == "box")
+        fluidVolume = bottomArea*fluid[0];
+    else if(syntheticInfos.shape == "damBreak")
+        fluidVolume = (dim == 2) ? fluid[0]*fluid[1] : fluid[0]*fluid[1]*fluid[2];
+    else
+        fluidVolume = (dim == 2) ? M_PI*fluid[0]*fluid[0] : M_PI*fluid[0]*fluid[0]*fluid[1];
+
+    const double wallsArea = (dim == 2) ? tank[0] + 2*height : bottomArea + 2*(tank[0] + tank[1])*height;
+
+    //The number of nodes of the fluid and of the walls decreases with the spacing
+    auto getNodesCount = [&](double h) -> double
+    {
+        return fluidVolume/std::pow(h, dim) + wallsArea/std::pow(h, dim - 1);
+    };
+
+    double maxSpacing = *std::max_element(tank.begin(), tank.end());
+    double minSpacing = 1e-6*maxSpacing;
+    for(unsigned int i = 0 ; i < 100 ; ++i)
+    {
+        const double h = std::sqrt(minSpacing*maxSpacing);
+        if(getNodesCount(h) > static_cast<double>(syntheticInfos.nodesCount))
+            minSpacing = h;
+        else
+            maxSpacing = h;
+    }
+
+    return std::sqrt(minSpacing*maxSpacing);
+}
+
+void Mesh::loadSynthetic(const SyntheticMeshInfo& syntheticInfos)
+{
+    const double h = getSyntheticSpacing(syntheticInfos);
+
+    m_dim = syntheticInfos.dim;
+
+    if(m_boundingBox.size() != 2*m_dim)
+        throw std::runtime_error("Invalid bounding box size: " + std::to_string(m_boundingBox.size()));
+
+    for(auto& exclusionZone : m_exclusionZones)
+    {
+        if(exclusionZone.size() != 2*m_dim)
+            throw std::runtime_error("Invalid exclusion zone size: " + std::to_string(exclusionZone.size()));
+    }
+
+    const std::vector<double>& tank = syntheticInfos.tankSize;
+    const std::vector<double>& fluid = syntheticInfos.fluidSize;
+    const unsigned short vertical = m_dim - 1;
+
+    //The spacing is adapted in each direction so that the walls are on the lattice
+    std::array<std::ptrdiff_t, 3> cellsCount = {0, 0, 0};
+    std::array<double, 3> spacing = {0, 0, 0};
+    std::size_t latticeCount = 1;
+    for(unsigned short d = 0 ; d < m_dim ; ++d)
+    {
+        cellsCount[d] = std::max<std::ptrdiff_t>(1, static_cast<std::ptrdiff_t>(std::round(tank[d]/h)));
+        spacing[d] = tank[d]/static_cast<double>(cellsCount[d]);
+        latticeCount *= static_cast<std::size_t>(cellsCount[d] + 1);
+    }
+
+    using Index = std::array<std::ptrdiff_t, 3>;
+
+    auto isWall = [&](const Index& index) -> bool
+    {
+        for(unsigned short d = 0 ; d < m_dim ; ++d)
+        {
+            if(index[d] < 0 || index[d] > cellsCount[d])
+                return false;
+        }
+
+        if(index[vertical] == 0)
+            return true;
+
+        for(unsigned short d = 0 ; d < vertical ; ++d)
+        {
+            if(index[d] == 0 || index[d] == cellsCount[d])
+                return true;
+        }
+
+        return false;
+    };
+
+    const double eps = 1e-6*h;
+    auto isFluid = [&](const Index& index) -> bool
+    {
+        for(unsigned short d = 0 ; d < m_dim ; ++d)
+        {
+            if(index[d] < 0 || index[d] > cellsCount[d])
+                return false;
+        }
+
+        if(isWall(index))
+            return false;
+
+        std::array<double, 3> pos = {0, 0, 0};
+        for(unsigned short d = 0 ; d < m_dim ; ++d)
+            pos[d] = static_cast<double>(index[d])*spacing[d];
+
+        if(syntheticInfos.shape == "box")
+            return pos[vertical] <= fluid[0] + eps;
+        else if(syntheticInfos.shape == "damBreak")
+        {
+            for(unsigned short d = 0 ; d < m_dim ; ++d)
+            {
+                if(pos[d] > fluid[d] + eps)
+                    return false;
+            }
+
+            return true;
+        }
+        else if(m_dim == 2)
+        {
+            const double dx = pos[0] - tank[0]/2, dy = pos[1] - fluid[1];
+            return dx*dx + dy*dy <= (fluid[0] + eps)*(fluid[0] + eps);
+        }
+        else
+        {
+            const double dx = pos[0] - tank[0]/2, dy = pos[1] - tank[1]/2;
+            return dx*dx + dy*dy <= (fluid[0] + eps)*(fluid[0] + eps) && pos[2] <= fluid[1] + eps;
+        }
+    };
+
+    m_nodesList.clear();
+    m_tagNames = {"Boundary", "Fluid"};
+
+    for(std::size_t n = 0 ; n < latticeCount ; ++n)
+    {
+        Index index = {0, 0, 0};
+        std::size_t remainder = n;
+        for(unsigned short d = 0 ; d < m_dim ; ++d)
+        {
+            index[d] = static_cast<std::ptrdiff_t>(remainder%static_cast<std::size_t>(cellsCount[d] + 1));
+            remainder /= static_cast<std::size_t>(cellsCount[d] + 1);
+        }
+
+        const bool isBound = isWall(index);
+        if(!isBound && !isFluid(index))
+            continue;
+
+        //The nodes of the free surface are not moved, so that it stays smooth
+        bool isJittered = !isBound;
+        for(unsigned short d = 0 ; d < m_dim && isJittered ; ++d)
+        {
+            for(std::ptrdiff_t offset : {-1, 1})
+            {
+                Index neighbour = index;
+                neighbour[d] += offset;
+                if(!isWall(neighbour) && !isFluid(neighbour))
+                    isJittered = false;
+            }
+        }
+
+        Node node(*this);
+        for(unsigned short d = 0 ; d < 3 ; ++d)
+        {
+            node.m_position[d] = (d < m_dim) ? static_cast<double>(index[d])*spacing[d] : 0.0;
+            if(d < m_dim && isJittered)
+                node.m_position[d] += syntheticInfos.jitter*spacing[d]*getJitter(syntheticInfos.seed, n*m_dim + d);
+        }
+
+        node.m_isBound = isBound;
+        node.m_tag = isBound ? 0 : 1;
+
+        m_nodesList.push_back(std::move(node));
+    }
+
+    if(m_nodesList.empty())
+        throw std::runtime_error("no nodes generated for the synthetic cloud!");
+
+    triangulateAlphaShape();
+}
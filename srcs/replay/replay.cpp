@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../simulation/physics/Problems.hpp"
+#include "../simulation/utility/Profiler.hpp"
+#include "../simulation/utility/SolTable.hpp"
+
+/**
+ * \param  argv[1] .lua file that contains the parameters of the captured simulation.
+ * \param  argv[2] The capture file, written by a simulation with captureFile and captureStep.
+ * \param  argv[3] (optional) The number of times the time step is solved (default 5).
+ */
+int main(int argc, char **argv)
+{
+    if(argc != 3 && argc != 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " params.lua capture [repetitions]" << std::endl;
+        return 1;
+    }
+
+    const int repetitionsCount = (argc == 4) ? std::atoi(argv[3]) : 5;
+    if(repetitionsCount <= 0)
+    {
+        std::cerr << "The number of repetitions should be positive!" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        std::ifstream luaFile(argv[1]);
+        if(!luaFile.is_open())
+            throw std::runtime_error("cannot open lua file " + std::string(argv[1]) + "!");
+
+        luaFile.close();
+
+        sol::state state;
+        auto res = state.safe_script_file(argv[1]);
+        if(!res.valid())
+        {
+            sol::error err = res;
+            throw std::runtime_error(std::string("an error occured while loading lua file: ") + err.what());
+        }
+
+        SolTable table = SolTable("Problem", state);
+
+        const std::string problemType = table.checkAndGet<std::string>("id");
+        const std::string captureFile = argv[2];
+
+        auto createProblem = [&]() -> std::unique_ptr<Problem>
+        {
+            if(problemType == "IncompNewtonNoT" || problemType == "Bingham" || problemType == "Boussinesq" || problemType == "Conduction")
+                return std::make_unique<ProbIncompNewton>(argv[1], captureFile);
+            else if(problemType == "WCompNewtonNoT" || problemType == "BoussinesqWC")
+                return std::make_unique<ProbWCompNewton>(argv[1], captureFile);
+            else
+                throw std::runtime_error("unknown problem type " + problemType + "!");
+        };
+
+        std::vector<double> times;
+        std::vector<std::uint64_t> hashes;
+        std::unique_ptr<Problem> pProblem;
+
+        for(int repetition = 0 ; repetition < repetitionsCount ; ++repetition)
+        {
+            //Each repetition starts from the captured state, its loading is not part of the measure
+            pProblem.reset();
+            pProblem = createProblem();
+
+            Profiler::reset();
+            const std::int64_t startTime = Profiler::now();
+            const bool ok = pProblem->replayTimeStep();
+            const std::int64_t endTime = Profiler::now();
+
+            times.push_back(static_cast<double>(endTime - startTime)*1e-9);
+            hashes.push_back(pProblem->computeNodesHash());
+
+            std::cout << "Replay " << repetition + 1 << "/" << repetitionsCount << ": " << std::fixed
+                      << std::setprecision(6) << times.back() << " s, time step " << (ok ? "accepted" : "rejected")
+                      << ", nodes hash " << std::hex << hashes.back() << std::dec << std::endl;
+        }
+
+        double meanTime = 0;
+        for(double time : times)
+            meanTime += time;
+        meanTime /= static_cast<double>(times.size());
+
+        std::cout << "======================================" << std::endl;
+        std::cout << "Replayed time step (s): min " << *std::min_element(times.begin(), times.end())
+                  << ", mean " << meanTime << ", max " << *std::max_element(times.begin(), times.end()) << std::endl;
+
+        if(std::all_of(hashes.begin(), hashes.end(), [&](std::uint64_t hash){ return hash == hashes[0]; }))
+            std::cout << "Every replay gave the same nodes positions and states" << std::endl;
+        else
+            std::cout << "The replays gave different nodes positions and states (non deterministic time step)" << std::endl;
+
+        //The capture holds the nodes hash of the original run after the time step
+        bool reproduced = true;
+        if(pProblem->hasCapturedNodesHash())
+        {
+            const std::uint64_t originalHash = pProblem->getCapturedNodesHash();
+            reproduced = std::all_of(hashes.begin(), hashes.end(), [&](std::uint64_t hash){ return hash == originalHash; });
+
+            if(reproduced)
+                std::cout << "Every replay reproduced the original run (nodes hash " << std::hex << originalHash << std::dec << ")" << std::endl;
+            else
+                std::cout << "The replays differ from the original run (nodes hash " << std::hex << originalHash << std::dec << ")" << std::endl;
+        }
+        else
+            std::cout << "The capture does not contain the nodes hash of the original run" << std::endl;
+
+        //Profile of the last repetition
+        std::cout << "======================================" << std::endl;
+        pProblem->displayTimeStats();
+
+        if(!reproduced)
+            return 2;
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << std::endl << "\nSomething went wrong while replaying the time step: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -1,8 +1,9 @@
 #include "Equation.hpp"
 
-#include <iomanip>
-
 #include "Problem.hpp"
+#include "nonLinearAlgo/AitkenAlgo.hpp"
+#include "nonLinearAlgo/AndersonAlgo.hpp"
+#include "nonLinearAlgo/PicardAlgo.hpp"
 
 Equation::Equation(Problem* pProblem, Solver* pSolver, Mesh* pMesh,
                  std::vector<SolTable> solverParams, std::vector<SolTable> materialParams,
@@ -14,7 +15,10 @@ m_bcFlags(bcFlags),
 m_statesIndex(statesIndex),
 m_pProblem(pProblem),
 m_pSolver(pSolver),
-m_pMesh(pMesh)
+m_pMesh(pMesh),
+m_linearIterCount(0),
+m_assemblyMemory(0),
+m_factorizationMemory(0)
 {
     m_equationParams.resize(m_pProblem->getThreadCount());
     m_bcParams.resize(m_pProblem->getThreadCount());
@@ -35,17 +39,6 @@ void Equation::displayParams() const
     throw std::runtime_error("Unimplemented function by the child class -> Equation::displayParams()");
 }
 
-void Equation::displayTimeStats() const
-{
-    std::cout << getID() << " stats" << std::endl;
-    std::cout << "--------------------------------------" << std::endl;
-
-    for(auto& keyPair : m_accumalatedTimes)
-    {
-        std::cout << std::defaultfloat << std::setprecision(7) <<  std::setw(40) << std::left << keyPair.first << ": " << std::setw(10) << std::right << keyPair.second << " s" << std::endl;
-    }
-}
-
 SolTable Equation::getBCParam(unsigned int thread) const
 {
     return m_bcParams[thread];
@@ -71,6 +64,25 @@ double Equation::getSquaredSpeedEquiv(const Node& /** node **/) const
     throw std::runtime_error("Unimplemented function by the child class -> Equation::getSquaredSpeedEquiv()!");
 }
 
+std::size_t Equation::getLinearIterCount() const noexcept
+{
+    return m_linearIterCount;
+}
+
+MemoryUsage Equation::getMemoryUsage() const
+{
+    MemoryUsage usage;
+    usage.assembly = m_assemblyMemory;
+    usage.factorizations = m_factorizationMemory;
+
+    return usage;
+}
+
+const NonLinearAlgo* Equation::getNonLinearAlgo() const noexcept
+{
+    return nullptr;
+}
+
 void Equation::preCompute()
 {
     throw std::runtime_error("Unimplemented function by the child class -> Equation::preCompute()!");
@@ -80,3 +92,40 @@ bool Equation::solve()
 {
     throw std::runtime_error("Unimplemented function by the child class -> Equation::solve()!");
 }
+
+std::unique_ptr<NonLinearAlgo> Equation::m_buildNonLinearAlgo(std::function<void(const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> prepare,
+                                                              std::function<bool(std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                                                                 const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> solve,
+                                                              std::function<double(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                                                                   const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes,
+                                                              std::function<void(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                                                                 const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> update,
+                                                              unsigned int maxIter, double minRes) const
+{
+    std::string algo = "Picard";
+    if(m_equationParams[0].doesVarExist("nonLinearAlgo"))
+        algo = m_equationParams[0].checkAndGet<std::string>("nonLinearAlgo");
+
+    if(algo == "Picard")
+    {
+        return std::make_unique<PicardAlgo>(prepare, solve, computeRes, maxIter, minRes);
+    }
+    else if(algo == "Anderson")
+    {
+        unsigned int depth = 5;
+        if(m_equationParams[0].doesVarExist("andersonDepth"))
+            depth = m_equationParams[0].checkAndGet<unsigned int>("andersonDepth");
+
+        return std::make_unique<AndersonAlgo>(prepare, solve, computeRes, update, maxIter, minRes, depth);
+    }
+    else if(algo == "Aitken")
+    {
+        double initialRelax = 0.5;
+        if(m_equationParams[0].doesVarExist("aitkenRelax"))
+            initialRelax = m_equationParams[0].checkAndGet<double>("aitkenRelax");
+
+        return std::make_unique<AitkenAlgo>(prepare, solve, computeRes, update, maxIter, minRes, initialRelax);
+    }
+    else
+        throw std::runtime_error("unknown non-linear algorithm: " + algo);
+}
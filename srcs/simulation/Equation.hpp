@@ -3,12 +3,15 @@
 #define EQUATION_HPP_INCLUDED
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <Eigen/Dense>
 
-#include "utility/Clock.hpp"
+#include "utility/Memory.hpp"
+#include "utility/Profiler.hpp"
 #include "utility/SolTable.hpp"
 #include "matricesBuilder/MatricesBuilder.hpp"
+#include "nonLinearAlgo/NonLinearAlgo.hpp"
 
 #include "simulation_defines.h"
 
@@ -40,9 +43,6 @@ class Equation
         /// \brief Display general parameters of the equation.
         virtual void displayParams() const;
 
-        /// \brief Display time statistics.
-        void displayTimeStats() const;
-
         /// \param thread the OpenMP thread which might be calling this function.
         /// \return The underlying boundary conditions parameters.
         SolTable getBCParam(unsigned int thread) const;
@@ -61,6 +61,15 @@ class Equation
         /// \return The diffusion coefficient in the Von Neumann number.
         virtual double getDiffusionParam(const Node& node) const;
 
+        /// \return The total number of iterations done by the iterative linear solvers of the equation.
+        std::size_t getLinearIterCount() const noexcept;
+
+        /// \return The memory allocated by the equation (matrices, factorizations and assembly buffers).
+        virtual MemoryUsage getMemoryUsage() const;
+
+        /// \return The non-linear algorithm used to solve the equation (nullptr if there is none).
+        virtual const NonLinearAlgo* getNonLinearAlgo() const noexcept;
+
         /// \brief A function to precompute data for the equation of needed.
         virtual void preCompute();
 
@@ -82,8 +91,23 @@ class Equation
         Solver* m_pSolver;      /**< Pointer to the underlying solver. */
         Mesh* m_pMesh;          /**< Pointer to the mesh used. */
 
-        std::map<std::string, double> m_accumalatedTimes;  /**< Accumulated time in each part of the solver*/
-        Clock m_clock;
+        std::size_t m_linearIterCount;  /**< Total number of iterations done by the iterative linear solvers. */
+        std::size_t m_assemblyMemory;       /**< Memory allocated by the assembly buffers of the last assembly (set by child class). */
+        std::size_t m_factorizationMemory;  /**< Memory allocated by the factors of the last factorization (set by child class). */
+
+        /// \brief Build the non-linear algorithm chosen by the optional nonLinearAlgo equation parameter
+        ///        ("Picard" (default), "Anderson" or "Aitken").
+        /// \param update Push a mixed iterate to the mesh (unused by the Picard algorithm).
+        /// \param maxIter The maximum number of iterations.
+        /// \param minRes The residual under which the algorithm has converged.
+        std::unique_ptr<NonLinearAlgo> m_buildNonLinearAlgo(std::function<void(const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> prepare,
+                                                            std::function<bool(std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                                                               const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> solve,
+                                                            std::function<double(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                                                                 const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes,
+                                                            std::function<void(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                                                               const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> update,
+                                                            unsigned int maxIter, double minRes) const;
 };
 
 #endif // EQUATION_HPP_INCLUDED
@@ -1,14 +1,23 @@
 #include "Problem.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 
 #include <omp.h>
 #include <Eigen/Core>
 
+#include "Equation.hpp"
 #include "Solver.hpp"
+#include "Telemetry.hpp"
 #include "extractors/Extractors.hpp"
 #include "../mesh/Mesh.hpp"
 #include "utility/SignalHandler.h"
@@ -18,11 +27,49 @@
 
 int g_shouldClose = 0;
 
-Problem::Problem(const std::string& luaFilePath):
+template<typename T>
+static void writeBinary(std::ostream& file, const T* pData, std::size_t count)
+{
+    file.write(reinterpret_cast<const char*>(pData), static_cast<std::streamsize>(count*sizeof(T)));
+}
+
+template<typename T>
+static void readBinary(std::istream& file, T* pData, std::size_t count)
+{
+    file.read(reinterpret_cast<char*>(pData), static_cast<std::streamsize>(count*sizeof(T)));
+    if(!file)
+        throw std::runtime_error("unexpected end of the binary file!");
+}
+
+static std::vector<double> readDoubleBlock(std::istream& file)
+{
+    std::uint64_t count;
+    readBinary(file, &count, 1);
+    std::vector<double> data(count);
+    readBinary(file, data.data(), data.size());
+
+    return data;
+}
+
+Problem::Problem(const std::string& luaFilePath, const std::string& restartFile):
 m_time(0),
-m_step(0)
+m_maxSteps(0),
+m_step(0),
+m_binaryTelemetry(false),
+m_timeBetweenCheckpoints(0),
+m_nextCheckpointTime(0),
+m_captureStep(0),
+m_isCaptured(false),
+m_hasCapturedNodesHash(false),
+m_capturedNodesHash(0),
+m_memorySoftLimit(0),
+m_isRestarted(!restartFile.empty()),
+m_restartStatesCount(0),
+m_hasRestartTelemetrySize(false),
+m_restartTelemetrySize(0)
 {
     signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
 
     std::cout   << "================================================================"
                 << "\n"
@@ -56,25 +103,184 @@ m_step(0)
 
     SolTable mesh = SolTable("Mesh", m_problemParams[0]);
 
+    //The nodes can be generated on a jittered lattice instead of being loaded from a .msh file
+    const bool isSynthetic = mesh.doesVarExist("Synthetic");
+    SyntheticMeshInfo syntheticInfo;
+    if(isSynthetic)
+    {
+        SolTable synthetic = SolTable("Synthetic", mesh);
+        syntheticInfo.shape = synthetic.checkAndGet<std::string>("shape");
+        syntheticInfo.dim = static_cast<unsigned short>(synthetic.checkAndGet<int>("dim"));
+        syntheticInfo.nodesCount = static_cast<std::size_t>(synthetic.checkAndGet<double>("nodesCount"));
+        syntheticInfo.tankSize = synthetic.checkAndGet<std::vector<double>>("tankSize");
+        syntheticInfo.fluidSize = synthetic.checkAndGet<std::vector<double>>("fluidSize");
+        if(synthetic.doesVarExist("jitter"))
+            syntheticInfo.jitter = synthetic.checkAndGet<double>("jitter");
+        if(synthetic.doesVarExist("seed"))
+            syntheticInfo.seed = synthetic.checkAndGet<std::uint64_t>("seed");
+    }
+
     MeshCreateInfo createInfo = {
-        mesh.checkAndGet<double>("hchar"),
+        isSynthetic ? Mesh::getSyntheticSpacing(syntheticInfo) : mesh.checkAndGet<double>("hchar"),
         mesh.checkAndGet<double>("alpha"),
         mesh.checkAndGet<double>("gamma"),
         mesh.checkAndGet<double>("omega"),
         mesh.checkAndGet<std::vector<double>>("boundingBox"),
         mesh.checkAndGet<std::vector<std::vector<double>>>("exclusionZones"),
-        mesh.checkAndGet<std::string>("mshFile"),
+        isSynthetic ? std::string() : mesh.checkAndGet<std::string>("mshFile"),
         mesh.checkAndGet<bool>("addOnFS"),
         mesh.checkAndGet<bool>("deleteFlyingNodes"),
         mesh.checkAndGet<bool>("laplacianSmoothingBoundaries")
     };
 
-    std::cout << "Loading the mesh" << std::flush;
-    m_pMesh = std::make_unique<Mesh>(createInfo);
-    std::cout << "\rLoading the mesh\t\tok" << std::endl;
+    if(m_isRestarted)
+    {
+        std::cout << "Loading the checkpoint" << std::flush;
+
+        std::ifstream file(restartFile, std::ios::binary);
+        if(!file.is_open())
+            throw std::runtime_error("cannot open checkpoint file " + restartFile + "!");
+
+        char magic[8];
+        std::uint32_t version;
+        readBinary(file, magic, 8);
+        readBinary(file, &version, 1);
+        if(std::string(magic, 8) != "PFEMCKP1" || (version < 1 || version > 3))
+            throw std::runtime_error(restartFile + " is not a valid checkpoint file!");
+
+        std::uint64_t idSize;
+        readBinary(file, &idSize, 1);
+        std::string id(idSize, ' ');
+        readBinary(file, &id[0], id.size());
+        if(id != m_id)
+            throw std::runtime_error("the checkpoint was written by a " + id + " problem, not " + m_id + "!");
+
+        std::uint64_t step;
+        readBinary(file, &m_time, 1);
+        readBinary(file, &step, 1);
+        m_step = step;
+
+        m_restartSolverData = readDoubleBlock(file);
+
+        //Version 1 only stored the next write time of each extractor
+        if(version == 1)
+        {
+            for(double trigger : readDoubleBlock(file))
+                m_restartExtractorsData.push_back({trigger});
+        }
+        else
+        {
+            std::uint64_t extractorsCount;
+            readBinary(file, &extractorsCount, 1);
+            for(std::uint64_t i = 0 ; i < extractorsCount ; ++i)
+                m_restartExtractorsData.push_back(readDoubleBlock(file));
+        }
+
+        //Version 3 added the size of the telemetry file, if any
+        if(version >= 3)
+        {
+            std::uint64_t telemetrySizesCount;
+            readBinary(file, &telemetrySizesCount, 1);
+            if(telemetrySizesCount > 1)
+                throw std::runtime_error(restartFile + " is not a valid checkpoint file!");
+
+            if(telemetrySizesCount == 1)
+            {
+                readBinary(file, &m_restartTelemetrySize, 1);
+                m_hasRestartTelemetrySize = true;
+            }
+        }
+
+        m_pMesh = std::make_unique<Mesh>(createInfo, file);
+        m_restartStatesCount = m_pMesh->getNode(0).getStates().size();
+
+        //A capture ends with the nodes hash after its time step (see writeCaptureHash)
+        char hashTag[4];
+        if(file.read(hashTag, 4) && std::string(hashTag, 4) == "HASH")
+        {
+            readBinary(file, &m_capturedNodesHash, 1);
+            m_hasCapturedNodesHash = true;
+        }
+
+        std::cout << "\rLoading the checkpoint\t\tok" << std::endl;
+    }
+    else
+    {
+        std::cout << "Loading the mesh" << std::flush;
+        if(isSynthetic)
+            m_pMesh = std::make_unique<Mesh>(createInfo, syntheticInfo);
+        else
+            m_pMesh = std::make_unique<Mesh>(createInfo);
+        std::cout << "\rLoading the mesh\t\tok" << std::endl;
+    }
 
     m_maxTime = m_problemParams[0].checkAndGet<double>("simulationTime");
+    if(m_problemParams[0].doesVarExist("maxSteps"))
+        m_maxSteps = m_problemParams[0].checkAndGet<std::size_t>("maxSteps");
     m_verboseOutput = m_problemParams[0].checkAndGet<bool>("verboseOutput");
+
+    if(m_problemParams[0].doesVarExist("profileFile"))
+        m_profileFile = m_problemParams[0].checkAndGet<std::string>("profileFile");
+
+    if(m_problemParams[0].doesVarExist("traceFile"))
+    {
+        m_traceFile = m_problemParams[0].checkAndGet<std::string>("traceFile");
+        Profiler::setTracing(true);
+    }
+
+    //Hardware counters, from the parameters file or the PFEM_PERF_COUNTERS environment variable
+    bool perfCounters = false;
+    if(m_problemParams[0].doesVarExist("perfCounters"))
+        perfCounters = m_problemParams[0].checkAndGet<bool>("perfCounters");
+
+    const char* pPerfCounters = std::getenv("PFEM_PERF_COUNTERS");
+    if(pPerfCounters != nullptr && std::atoi(pPerfCounters) != 0)
+        perfCounters = true;
+
+    if(perfCounters && !Profiler::setCounters(true))
+        std::cerr << "Hardware counters are not available (PFEM should be built with USE_PERF_COUNTERS on Linux "
+                  << "and perf_event_paranoid should allow them): they will not be recorded." << std::endl;
+
+    if(m_problemParams[0].doesVarExist("telemetryFile"))
+    {
+        m_telemetryFile = m_problemParams[0].checkAndGet<std::string>("telemetryFile");
+
+        std::string telemetryFormat = "NDJSON";
+        if(m_problemParams[0].doesVarExist("telemetryFormat"))
+            telemetryFormat = m_problemParams[0].checkAndGet<std::string>("telemetryFormat");
+
+        if(telemetryFormat == "Binary")
+            m_binaryTelemetry = true;
+        else if(telemetryFormat != "NDJSON")
+            throw std::runtime_error("unknown telemetry format: " + telemetryFormat + "!");
+    }
+
+    if(m_problemParams[0].doesVarExist("checkpointFile"))
+    {
+        m_checkpointFile = m_problemParams[0].checkAndGet<std::string>("checkpointFile");
+        m_timeBetweenCheckpoints = m_problemParams[0].checkAndGet<double>("timeBetweenCheckpoints");
+        if(m_timeBetweenCheckpoints <= 0)
+            throw std::runtime_error("the interval between checkpoints should be strictly greater than 0!");
+    }
+
+    if(m_problemParams[0].doesVarExist("captureFile"))
+    {
+        m_captureFile = m_problemParams[0].checkAndGet<std::string>("captureFile");
+        m_captureStep = m_problemParams[0].checkAndGet<std::size_t>("captureStep");
+    }
+
+    if(m_problemParams[0].doesVarExist("memorySoftLimit"))
+    {
+        if(m_checkpointFile.empty())
+            throw std::runtime_error("the memory soft limit requires a checkpoint file!");
+
+        const double memorySoftLimit = m_problemParams[0].checkAndGet<double>("memorySoftLimit");
+        if(memorySoftLimit <= 0)
+            throw std::runtime_error("the memory soft limit should be strictly greater than 0!");
+
+        //Given in MB, as the --mem-per-cpu option of SLURM
+        m_memorySoftLimit = static_cast<std::size_t>(memorySoftLimit*1024*1024);
+    }
 }
 
 Problem::~Problem()
@@ -92,12 +298,47 @@ void Problem::displayTimeStats() const
     std::cout << "Time stats" << std::endl;
     std::cout << "======================================" << std::endl;
 
-    for(auto& keyPair : m_accumalatedTimes)
+    m_pSolver->displayTimeStats();
+    std::cout << "--------------------------------------" << std::endl;
+    Profiler::writeTextReport(std::cout);
+
+    if(!m_profileFile.empty())
+        Profiler::writeJSONReport(m_profileFile);
+
+    if(!m_traceFile.empty())
+        Profiler::writeChromeTrace(m_traceFile);
+}
+
+void Problem::displayMemoryStats() const
+{
+    auto toMB = [](std::size_t bytes) -> double
     {
-        std::cout << std::defaultfloat << std::setprecision(7) <<  std::setw(40) << std::left << keyPair.first << ": " << std::setw(10) << std::right << keyPair.second << " s" << std::endl;
-    }
+        return static_cast<double>(bytes)/(1024*1024);
+    };
 
-    m_pSolver->displayTimeStats();
+    auto displayLine = [&](const std::string& name, std::size_t current, std::size_t peak)
+    {
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(12) << toMB(current)
+                  << std::setw(12) << toMB(peak) << std::endl;
+    };
+
+    const std::ios_base::fmtflags flags = std::cout.flags();
+    const std::streamsize precision = std::cout.precision();
+
+    std::cout << "Memory stats (MB)" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(24) << "" << std::right << std::setw(12) << "last" << std::setw(12) << "peak" << std::endl;
+    displayLine("Mesh", m_memoryUsage.mesh, m_peakMemoryUsage.mesh);
+    displayLine("Triangulation", m_memoryUsage.triangulation, m_peakMemoryUsage.triangulation);
+    displayLine("Matrices", m_memoryUsage.matrices, m_peakMemoryUsage.matrices);
+    displayLine("Factorizations", m_memoryUsage.factorizations, m_peakMemoryUsage.factorizations);
+    displayLine("Assembly buffers", m_memoryUsage.assembly, m_peakMemoryUsage.assembly);
+    displayLine("Extractors", m_memoryUsage.extractors, m_peakMemoryUsage.extractors);
+    displayLine("Resident set size", getCurrentRSS(), getPeakRSS());
+
+    std::cout.flags(flags);
+    std::cout.precision(precision);
 }
 
 void Problem::dump()
@@ -105,7 +346,119 @@ void Problem::dump()
     for(auto& pExtractor : m_pExtractors)
     {
         pExtractor->update(true);
+        pExtractor->flush();
+    }
+}
+
+void Problem::writeCheckpoint() const
+{
+    PROFILE_SCOPE("Write checkpoint");
+
+    writeState(m_checkpointFile, false);
+}
+
+void Problem::writeState(const std::string& fileName, bool writeConnectivity) const
+{
+    const std::string tmpFile = fileName + ".tmp";
+
+    {
+        std::vector<char> buffer(1 << 20);
+        std::ofstream file;
+        file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.open(tmpFile, std::ios::binary | std::ios::trunc);
+        if(!file.is_open())
+            throw std::runtime_error("cannot open checkpoint file " + tmpFile + "!");
+
+        const std::uint32_t version = 3;
+        writeBinary(file, "PFEMCKP1", 8);
+        writeBinary(file, &version, 1);
+
+        const std::uint64_t idSize = m_id.size();
+        writeBinary(file, &idSize, 1);
+        writeBinary(file, m_id.data(), m_id.size());
+
+        const std::uint64_t step = m_step;
+        writeBinary(file, &m_time, 1);
+        writeBinary(file, &step, 1);
+
+        const std::vector<double> solverData = m_pSolver->getCheckpointData();
+        const std::uint64_t solverDataCount = solverData.size();
+        writeBinary(file, &solverDataCount, 1);
+        writeBinary(file, solverData.data(), solverData.size());
+
+        //One block per extractor: its next write time, then the state of its output files
+        const std::uint64_t extractorsCount = m_pExtractors.size();
+        writeBinary(file, &extractorsCount, 1);
+        for(const auto& pExtractor : m_pExtractors)
+        {
+            std::vector<double> extractorData = pExtractor->getCheckpointData();
+            extractorData.insert(extractorData.begin(), pExtractor->getNextWriteTrigger());
+            const std::uint64_t extractorDataCount = extractorData.size();
+            writeBinary(file, &extractorDataCount, 1);
+            writeBinary(file, extractorData.data(), extractorData.size());
+        }
+
+        //The records written after the checkpoint are dropped on restart (the telemetry is flushed at each record)
+        const std::uint64_t telemetrySizesCount = m_pTelemetry ? 1 : 0;
+        writeBinary(file, &telemetrySizesCount, 1);
+        if(m_pTelemetry)
+        {
+            const std::uint64_t telemetrySize = m_pTelemetry->getSize();
+            writeBinary(file, &telemetrySize, 1);
+        }
+
+        m_pMesh->writeCheckpoint(file, writeConnectivity);
+
+        file.flush();
+        if(!file)
+            throw std::runtime_error("an error occured while writing checkpoint file " + tmpFile + "!");
     }
+
+    //The previous file is only replaced once the new one is complete
+    if(std::rename(tmpFile.c_str(), fileName.c_str()) != 0)
+        throw std::runtime_error("cannot move " + tmpFile + " to " + fileName + "!");
+}
+
+void Problem::writeCaptureHash() const
+{
+    std::ofstream file(m_captureFile, std::ios::binary | std::ios::app);
+    if(!file.is_open())
+        throw std::runtime_error("cannot open capture file " + m_captureFile + "!");
+
+    const std::uint64_t hash = computeNodesHash();
+    writeBinary(file, "HASH", 4);
+    writeBinary(file, &hash, 1);
+
+    file.flush();
+    if(!file)
+        throw std::runtime_error("an error occured while writing capture file " + m_captureFile + "!");
+}
+
+std::uint64_t Problem::computeNodesHash() const
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto addValue = [&](double value)
+    {
+        unsigned char bytes[sizeof(double)];
+        std::memcpy(bytes, &value, sizeof(double));
+        for(unsigned char byte : bytes)
+        {
+            hash ^= byte;
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    for(std::size_t n = 0 ; n < m_pMesh->getNodesCount() ; ++n)
+    {
+        const Node& node = m_pMesh->getNode(n);
+        for(unsigned short d = 0 ; d < m_pMesh->getDim() ; ++d)
+            addValue(node.getCoordinate(d));
+
+        for(double state : node.getStates())
+            addValue(state);
+    }
+
+    return hash;
 }
 
 std::string Problem::getID() const noexcept
@@ -118,71 +471,174 @@ std::vector<std::string> Problem::getWrittableDataName() const
     throw std::runtime_error("Unimplemented function by the child class -> Problem::getWrittableDataName()");
 }
 
-std::vector<double> Problem::getWrittableData(const std::string& /** name **/, std::size_t /** nodeIndex **/) const
+WrittableField Problem::getWrittableField(const std::string& name) const
 {
-    throw std::runtime_error("Unimplemented function by the child class -> Problem::getWrittableData(name, nodeIndex)");
+    if(name == "normals")
+        return {WrittableField::Kind::Normal, 0, 3};
+    else if(name == "debug")
+        return {WrittableField::Kind::NodeType, 0, 1};
+    else if(name == "curvatures")
+        throw std::runtime_error("The mesh data " + name + " cannot be extracted from the mesh");
+
+    return resolveWrittableField(name);
 }
 
-std::vector<std::string> Problem::getGlobalWrittableDataName() const
+void Problem::getWrittableData(const WrittableField& field, double* pData) const
 {
-    throw std::runtime_error("Unimplemented function by the child class -> Problem::getGlobalWrittableDataName()");
+    const std::size_t nodesCount = m_pMesh->getNodesCount();
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+        getWrittableData(field, n, pData + field.componentsCount*n);
+}
+
+std::vector<double> Problem::getWrittableData(const std::string& name, std::size_t nodeIndex) const
+{
+    const WrittableField field = getWrittableField(name);
+
+    std::vector<double> data(field.componentsCount);
+    getWrittableData(field, nodeIndex, data.data());
+
+    return data;
 }
 
-double Problem::getGlobalWrittableData(const std::string& /** name **/) const
+WrittableField Problem::resolveWrittableField(const std::string& /** name **/) const
 {
-    throw std::runtime_error("Unimplemented function by the child class -> Problem::getGlobalWrittableData(name)");
+    throw std::runtime_error("Unimplemented function by the child class -> Problem::resolveWrittableField(name)");
 }
 
-std::vector<std::string> Problem::getMeshWrittableDataName() const
+std::vector<std::string> Problem::getGlobalWrittableDataName() const
 {
-    return {"normals", "curvatures", "debug"};
+    throw std::runtime_error("Unimplemented function by the child class -> Problem::getGlobalWrittableDataName()");
 }
 
-std::vector<double> Problem::getMeshWrittableData(const std::string& name, std::size_t nodeIndex) const
+double Problem::getGlobalWrittableData(const std::string& name) const
 {
-    if(name == "normals")
-    {
-        if(!m_pMesh->isNormalCurvComputed())
-            return {0, 0, 0};
+    const std::vector<std::string> diagnosticsName = getDiagnosticsName();
+    auto it = std::find(diagnosticsName.begin(), diagnosticsName.end(), name);
+    if(it == diagnosticsName.end())
+        throw std::runtime_error("The global data " + name + " cannot be extract from problem " + getID());
+
+    return computeDiagnostics()[static_cast<std::size_t>(it - diagnosticsName.begin())];
+}
+
+std::vector<double> Problem::computeGlobalWrittableData(const std::vector<std::string>& names) const
+{
+    const std::vector<std::string> diagnosticsName = getDiagnosticsName();
+    std::vector<double> diagnostics;
 
-        if(m_pMesh->getNode(nodeIndex).isOnFreeSurface() || (m_pMesh->getNode(nodeIndex).isBound() && !m_pMesh->getNode(nodeIndex).isFree()))
+    std::vector<double> values(names.size());
+    for(std::size_t i = 0 ; i < names.size() ; ++i)
+    {
+        auto it = std::find(diagnosticsName.begin(), diagnosticsName.end(), names[i]);
+        if(it != diagnosticsName.end())
         {
-            std::array<double, 3> normal = m_pMesh->getBoundFSNormal(nodeIndex);
-            return {normal[0], normal[1], normal[2]};
+            if(diagnostics.empty())
+                diagnostics = computeDiagnostics();
+
+            values[i] = diagnostics[static_cast<std::size_t>(it - diagnosticsName.begin())];
         }
         else
-            return {0, 0, 0};
+            values[i] = getGlobalWrittableData(names[i]);
     }
-//    else if(name == "curvatures")
-//    {
-//        if(!m_pMesh->isNormalCurvComputed())
-//            return {0};
-//
-//        if(m_pMesh->getNode(nodeIndex).isOnFreeSurface())
-//        {
-//            double curvature = m_pMesh->getFreeSurfaceCurvature(nodeIndex);
-//            return {curvature};
-//        }
-//        else
-//            return {0};
-//    }
-    else if(name == "debug")
+
+    return values;
+}
+
+std::vector<std::string> Problem::getDiagnosticsName() const
+{
+    const std::string axes = "XYZ";
+    std::vector<std::string> names = {"kineticEnergy", "maxVelocity"};
+
+    for(unsigned short d = 0 ; d < m_pMesh->getDim() ; ++d)
+        names.push_back("centerOfMass" + axes.substr(d, 1));
+
+    for(unsigned short d = 0 ; d < m_pMesh->getDim() ; ++d)
+        names.push_back("freeSurfaceMin" + axes.substr(d, 1));
+
+    for(unsigned short d = 0 ; d < m_pMesh->getDim() ; ++d)
+        names.push_back("freeSurfaceMax" + axes.substr(d, 1));
+
+    return names;
+}
+
+std::vector<double> Problem::computeDiagnostics() const
+{
+    const unsigned short dim = m_pMesh->getDim();
+    const std::size_t nodesCount = m_pMesh->getNodesCount();
+    const double nodesPerElm = static_cast<double>(m_pMesh->getNodesPerElm());
+
+    double kineticEnergy = 0;
+    double maxVelocity = 0;
+    double volume = 0;
+    double centerOfMass[3] = {0, 0, 0};
+    double freeSurfaceMin[3];
+    double freeSurfaceMax[3];
+    for(unsigned short d = 0 ; d < 3 ; ++d)
     {
-        const Node& node = m_pMesh->getNode(nodeIndex);
+        freeSurfaceMin[d] = std::numeric_limits<double>::max();
+        freeSurfaceMax[d] = std::numeric_limits<double>::lowest();
+    }
+
+    #pragma omp parallel for default(shared) reduction(+:kineticEnergy, volume, centerOfMass[:3]) \
+                                             reduction(max:maxVelocity, freeSurfaceMax[:3]) \
+                                             reduction(min:freeSurfaceMin[:3])
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        const Node& node = m_pMesh->getNode(n);
+
+        //Lumped volume: each element gives an equal share of its size to its nodes
+        double nodeVolume = 0;
+        for(unsigned int elm = 0 ; elm < node.getElementCount() ; ++elm)
+            nodeVolume += m_pMesh->getElement(node.getElementMeshIndex(elm)).getSize();
+        nodeVolume /= nodesPerElm;
+
+        double velocity2 = 0;
+        for(unsigned short d = 0 ; d < dim ; ++d)
+            velocity2 += node.getState(d)*node.getState(d);
+
+        kineticEnergy += 0.5*nodeVolume*velocity2;
+        volume += nodeVolume;
+        for(unsigned short d = 0 ; d < dim ; ++d)
+            centerOfMass[d] += nodeVolume*node.getCoordinate(d);
+
+        if(!node.isBound())
+            maxVelocity = std::max(maxVelocity, std::sqrt(velocity2));
 
         if(node.isOnFreeSurface())
-            return {-2};
-        else if(node.isFree())
-            return {-1};
-        else if(node.isBound() || node.isContact())
-            return {1};
-        else if(node.isFixed())
-            return {2};
-        else
-            return {0};
+        {
+            for(unsigned short d = 0 ; d < dim ; ++d)
+            {
+                freeSurfaceMin[d] = std::min(freeSurfaceMin[d], node.getCoordinate(d));
+                freeSurfaceMax[d] = std::max(freeSurfaceMax[d], node.getCoordinate(d));
+            }
+        }
     }
-    else
-        throw std::runtime_error("The mesh data " + name + " cannot be extracted from the mesh");
+
+    const bool hasFreeSurface = freeSurfaceMin[0] <= freeSurfaceMax[0];
+
+    std::vector<double> diagnostics = {kineticEnergy, maxVelocity};
+
+    for(unsigned short d = 0 ; d < dim ; ++d)
+        diagnostics.push_back((volume > 0) ? centerOfMass[d]/volume : 0);
+
+    for(unsigned short d = 0 ; d < dim ; ++d)
+        diagnostics.push_back(hasFreeSurface ? freeSurfaceMin[d] : 0);
+
+    for(unsigned short d = 0 ; d < dim ; ++d)
+        diagnostics.push_back(hasFreeSurface ? freeSurfaceMax[d] : 0);
+
+    return diagnostics;
+}
+
+std::vector<std::string> Problem::getMeshWrittableDataName() const
+{
+    return {"normals", "curvatures", "debug"};
+}
+
+std::vector<double> Problem::getMeshWrittableData(const std::string& name, std::size_t nodeIndex) const
+{
+    return getWrittableData(name, nodeIndex);
 }
 
 std::vector<std::string> Problem::getBoundaryWrittableDataName() const
@@ -208,16 +664,68 @@ void Problem::addExtractors()
         std::string outFileName = extractor.checkAndGet<std::string>("outputFile");
         double timeBetweenWriting = extractor.checkAndGet<double>("timeBetweenWriting");
 
+        //Scalar extractors write text rows by default, or raw doubles
+        auto isBinaryFormat = [&extractor]() -> bool {
+            if(!extractor.doesVarExist("format"))
+                return false;
+
+            std::string format = extractor.checkAndGet<std::string>("format");
+            if(format != "CSV" && format != "Binary")
+                throw std::runtime_error("unknown scalar extractor format " + format);
+
+            return format == "Binary";
+        };
+
         if(kind == "GMSH")
         {
             std::vector<std::string> whatToWrite = extractor.checkAndGet<std::vector<std::string>>("whatToWrite");
             std::string writeAs = extractor.checkAndGet<std::string>("writeAs");
 
+            bool asyncWrite = true;
+            if(extractor.doesVarExist("asyncWrite"))
+                asyncWrite = extractor.checkAndGet<bool>("asyncWrite");
+
+            unsigned int maxPendingWrites = 2;
+            if(extractor.doesVarExist("maxPendingWrites"))
+                maxPendingWrites = extractor.checkAndGet<unsigned int>("maxPendingWrites");
+
             m_pExtractors.push_back(std::make_unique<GMSHExtractor>(this,
                                                                     outFileName,
                                                                     timeBetweenWriting,
                                                                     whatToWrite,
-                                                                    writeAs));
+                                                                    writeAs,
+                                                                    asyncWrite,
+                                                                    maxPendingWrites));
+        }
+        else if(kind == "VTU")
+        {
+            std::vector<std::string> whatToWrite = extractor.checkAndGet<std::vector<std::string>>("whatToWrite");
+            std::string writeAs = extractor.checkAndGet<std::string>("writeAs");
+
+            bool compress = false;
+            if(extractor.doesVarExist("compress"))
+                compress = extractor.checkAndGet<bool>("compress");
+
+            m_pExtractors.push_back(std::make_unique<VTUExtractor>(this,
+                                                                   outFileName,
+                                                                   timeBetweenWriting,
+                                                                   whatToWrite,
+                                                                   writeAs,
+                                                                   compress));
+        }
+        else if(kind == "TimeSeries")
+        {
+            std::vector<std::string> whatToWrite = extractor.checkAndGet<std::vector<std::string>>("whatToWrite");
+
+            std::string format = TimeSeriesExtractor::getDefaultFormat();
+            if(extractor.doesVarExist("format"))
+                format = extractor.checkAndGet<std::string>("format");
+
+            m_pExtractors.push_back(std::make_unique<TimeSeriesExtractor>(this,
+                                                                          outFileName,
+                                                                          timeBetweenWriting,
+                                                                          whatToWrite,
+                                                                          format));
         }
         else if(kind == "Point")
         {
@@ -228,13 +736,25 @@ void Problem::addExtractors()
                                                                      outFileName,
                                                                      timeBetweenWriting,
                                                                      whatToWrite,
-                                                                     points));
+                                                                     points,
+                                                                     isBinaryFormat()));
         }
         else if(kind == "Mass")
         {
             m_pExtractors.push_back(std::make_unique<MassExtractor>(this,
                                                                     outFileName,
-                                                                    timeBetweenWriting));
+                                                                    timeBetweenWriting,
+                                                                    isBinaryFormat()));
+        }
+        else if(kind == "Global")
+        {
+            std::vector<std::string> whatToWrite = extractor.checkAndGet<std::vector<std::string>>("whatToWrite");
+
+            m_pExtractors.push_back(std::make_unique<GlobalExtractor>(this,
+                                                                      outFileName,
+                                                                      timeBetweenWriting,
+                                                                      whatToWrite,
+                                                                      isBinaryFormat()));
         }
         else if(kind == "MinMax")
         {
@@ -245,7 +765,8 @@ void Problem::addExtractors()
                                                                       outFileName,
                                                                       timeBetweenWriting,
                                                                       coordinate,
-                                                                      minMax));
+                                                                      minMax,
+                                                                      isBinaryFormat()));
         }
         else
             throw std::runtime_error("Unknown extractor kind " + kind + "!");
@@ -256,44 +777,251 @@ void Problem::addExtractors()
 
 void Problem::setInitialCondition()
 {
-    std::cout << "Setting initial conditions" << std::flush;
+    if(m_isRestarted)
+    {
+        if(m_restartStatesCount != m_statesNumber)
+            throw std::runtime_error("the checkpoint does not contain the right number of state: " +
+                                     std::to_string(m_restartStatesCount) + " vs " + std::to_string(m_statesNumber) + "!");
 
-    SolTable initialCond = SolTable("IC", m_problemParams[0]);
-    initialCond.checkCall("initStates", m_pMesh->getNode(0).getPosition());
+        return;
+    }
+
+    std::cout << "Setting initial conditions" << std::flush;
 
     assert(m_pMesh->getNodesCount() != 0);
 
-    //With lua, not thread safe !
-    for(std::size_t n = 0 ; n < m_pMesh->getNodesCount() ; ++n)
-    {
-        const Node& node = m_pMesh->getNode(n);
+    const std::size_t nodesCount = m_pMesh->getNodesCount();
+    const std::vector<std::string>& tagNames = m_pMesh->getTagNames();
 
-        std::vector<double> result;
-        result = initialCond.call<std::vector<double>>("initStates", node.getPosition());
+    //One table per thread, as lua is not thread safe
+    std::vector<SolTable> initialCond(m_nThreads);
+    for(std::size_t i = 0 ; i < m_nThreads ; ++i)
+        initialCond[i] = SolTable("IC", m_problemParams[i]);
 
-        if(result.size() != m_statesNumber)
-            throw std::runtime_error("Your initial condition does not set the right number of state: " +
-                                     std::to_string(result.size()) + " vs " + std::to_string(m_statesNumber) + "!");
+    //The boundary tags are resolved once instead of once per node
+    std::vector<bool> isTagBound(tagNames.size(), false);
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        const Node& node = m_pMesh->getNode(n);
+        if(node.isBound())
+            isTagBound[static_cast<std::size_t>(node.getTag())] = true;
+    }
 
+    std::vector<bool> isTagFixed(tagNames.size(), false);
+    for(std::size_t tag = 0 ; tag < tagNames.size() ; ++tag)
+    {
+        if(isTagBound[tag])
+            isTagFixed[tag] = initialCond[0].checkAndGet<bool>(tagNames[tag] + std::string("Fixed"));
+    }
 
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        const Node& node = m_pMesh->getNode(n);
         if(node.isBound())
+            m_pMesh->setNodeIsFixed(n, isTagFixed[static_cast<std::size_t>(node.getTag())]);
+    }
+
+    //The states can be given in a binary file: "PFEMFLD1", uint64 nodes count, uint64 states count
+    //and the states (all the nodes for state 0, then state 1, ...) in the order of the mesh nodes
+    if(initialCond[0].doesVarExist("statesFile"))
+    {
+        const std::string statesFile = initialCond[0].checkAndGet<std::string>("statesFile");
+        std::ifstream file(statesFile, std::ios::binary);
+        if(!file.is_open())
+            throw std::runtime_error("cannot open the initial states file " + statesFile + "!");
+
+        char magic[8];
+        readBinary(file, magic, 8);
+        if(std::string(magic, 8) != "PFEMFLD1")
+            throw std::runtime_error(statesFile + " is not an initial states file!");
+
+        std::uint64_t fileNodesCount, fileStatesCount;
+        readBinary(file, &fileNodesCount, 1);
+        readBinary(file, &fileStatesCount, 1);
+        if(fileNodesCount != nodesCount || fileStatesCount != m_statesNumber)
+            throw std::runtime_error("the initial states file does not match the mesh: " +
+                                     std::to_string(fileNodesCount) + " nodes and " + std::to_string(fileStatesCount) +
+                                     " states vs " + std::to_string(nodesCount) + " nodes and " +
+                                     std::to_string(m_statesNumber) + " states!");
+
+        std::vector<double> states(nodesCount*m_statesNumber);
+        readBinary(file, states.data(), states.size());
+
+        #pragma omp parallel for default(shared)
+        for(std::size_t n = 0 ; n < nodesCount ; ++n)
         {
-            bool isFixed = initialCond.checkAndGet<bool>(m_pMesh->getNodeType(n) + std::string("Fixed"));
-            m_pMesh->setNodeIsFixed(n, isFixed);
+            for(unsigned short i = 0 ; i < m_statesNumber ; ++i)
+                m_pMesh->setNodeState(n, i, states[n + i*nodesCount]);
+        }
 
-            bool ok = initialCond.checkCallNoThrow("init" + m_pMesh->getNodeType(n) + "States", node.getPosition());
+        std::cout << "\rSetting initial conditions\tok" << std::endl;
+        return;
+    }
 
-            if(ok)
-                result = initialCond.call<std::vector<double>>("init" + m_pMesh->getNodeType(n) + "States", node.getPosition());
+    //Each of initStates and init<Tag>States can be a function of the position, a constant table or be
+    //replaced by a vectorised function <name>Array taking the positions {x1, y1, z1, x2, ...} of a batch
+    //of nodes and returning their states {s1_1, s2_1, ..., s1_2, ...}
+    enum class ICKind {Function, ArrayFunction, Constant};
+    struct ICSource
+    {
+        ICKind kind;
+        std::string name;
+        std::vector<double> constant;
+    };
+
+    auto findSource = [&](const std::string& name, std::vector<ICSource>& sources) -> bool
+    {
+        if(initialCond[0].doesVarExist(name + "Array"))
+            sources.push_back({ICKind::ArrayFunction, name + "Array", {}});
+        else if(!initialCond[0].doesVarExist(name))
+            return false;
+        else if(initialCond[0].isFunction(name))
+        {
+            initialCond[0].checkCall(name, m_pMesh->getNode(0).getPosition());
+            sources.push_back({ICKind::Function, name, {}});
+        }
+        else
+        {
+            std::vector<double> constant = initialCond[0].checkAndGet<std::vector<double>>(name);
+            if(constant.size() != m_statesNumber)
+                throw std::runtime_error("Your initial condition does not set the right number of state: " +
+                                         std::to_string(constant.size()) + " vs " + std::to_string(m_statesNumber) + "!");
+
+            sources.push_back({ICKind::Constant, name, std::move(constant)});
         }
 
-        for(unsigned short i = 0 ; i < m_statesNumber ; ++i)
-            m_pMesh->setNodeState(n, i, result[i]);
+        return true;
+    };
+
+    std::vector<ICSource> sources;
+    if(!findSource("initStates", sources))
+        initialCond[0].checkCall("initStates", m_pMesh->getNode(0).getPosition());
+
+    std::vector<std::size_t> tagSource(tagNames.size(), 0);
+    for(std::size_t tag = 0 ; tag < tagNames.size() ; ++tag)
+    {
+        if(isTagBound[tag] && findSource("init" + tagNames[tag] + "States", sources))
+            tagSource[tag] = sources.size() - 1;
     }
 
+    std::vector<std::vector<std::size_t>> sourceNodes(sources.size());
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        const Node& node = m_pMesh->getNode(n);
+        sourceNodes[node.isBound() ? tagSource[static_cast<std::size_t>(node.getTag())] : 0].push_back(n);
+    }
+
+    bool validSize = true;
+    for(std::size_t s = 0 ; s < sources.size() ; ++s)
+    {
+        const ICSource& source = sources[s];
+        const std::vector<std::size_t>& nodes = sourceNodes[s];
+
+        switch(source.kind)
+        {
+            case ICKind::Constant:
+            {
+                #pragma omp parallel for default(shared)
+                for(std::size_t i = 0 ; i < nodes.size() ; ++i)
+                {
+                    for(unsigned short st = 0 ; st < m_statesNumber ; ++st)
+                        m_pMesh->setNodeState(nodes[i], st, source.constant[st]);
+                }
+                break;
+            }
+
+            case ICKind::Function:
+            {
+                #pragma omp parallel for default(shared) reduction(&&:validSize)
+                for(std::size_t i = 0 ; i < nodes.size() ; ++i)
+                {
+                    const SolTable& threadIC = initialCond[static_cast<std::size_t>(omp_get_thread_num())];
+                    std::vector<double> result = threadIC.call<std::vector<double>>(source.name,
+                                                                                    m_pMesh->getNode(nodes[i]).getPosition());
+                    if(result.size() != m_statesNumber)
+                    {
+                        validSize = false;
+                        continue;
+                    }
+
+                    for(unsigned short st = 0 ; st < m_statesNumber ; ++st)
+                        m_pMesh->setNodeState(nodes[i], st, result[st]);
+                }
+                break;
+            }
+
+            case ICKind::ArrayFunction:
+            {
+                const std::size_t batchSize = 4096;
+                const std::size_t batchesCount = (nodes.size() + batchSize - 1)/batchSize;
+
+                #pragma omp parallel for default(shared) schedule(dynamic) reduction(&&:validSize)
+                for(std::size_t b = 0 ; b < batchesCount ; ++b)
+                {
+                    const std::size_t begin = b*batchSize;
+                    const std::size_t count = std::min(batchSize, nodes.size() - begin);
+
+                    std::vector<double> positions(3*count);
+                    for(std::size_t i = 0 ; i < count ; ++i)
+                    {
+                        const std::array<double, 3> position = m_pMesh->getNode(nodes[begin + i]).getPosition();
+                        for(unsigned short d = 0 ; d < 3 ; ++d)
+                            positions[3*i + d] = position[d];
+                    }
+
+                    const SolTable& threadIC = initialCond[static_cast<std::size_t>(omp_get_thread_num())];
+                    std::vector<double> result = threadIC.call<std::vector<double>>(source.name, positions);
+                    if(result.size() != count*m_statesNumber)
+                    {
+                        validSize = false;
+                        continue;
+                    }
+
+                    for(std::size_t i = 0 ; i < count ; ++i)
+                    {
+                        for(unsigned short st = 0 ; st < m_statesNumber ; ++st)
+                            m_pMesh->setNodeState(nodes[begin + i], st, result[i*m_statesNumber + st]);
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    if(!validSize)
+        throw std::runtime_error("Your initial condition does not set the right number of state (" +
+                                 std::to_string(m_statesNumber) + " expected)!");
+
     std::cout << "\rSetting initial conditions\tok" << std::endl;
 }
 
+void Problem::updateMemoryUsage()
+{
+    m_memoryUsage = MemoryUsage();
+    m_memoryUsage.mesh = m_pMesh->getMemoryUsage();
+    m_memoryUsage.triangulation = m_pMesh->getTriangulationMemory();
+
+    for(std::size_t i = 0 ; i < m_pSolver->getEquationsCount() ; ++i)
+        m_memoryUsage += m_pSolver->getEquation(i).getMemoryUsage();
+
+    for(const auto& pExtractor : m_pExtractors)
+        m_memoryUsage.extractors += pExtractor->getMemoryUsage();
+
+    m_peakMemoryUsage.keepMax(m_memoryUsage);
+}
+
+bool Problem::replayTimeStep()
+{
+    if(!m_isRestarted)
+        throw std::runtime_error("the replayed time step should be loaded from a capture!");
+
+    m_pSolver->setCheckpointData(m_restartSolverData);
+
+    PROFILE_SCOPE("Solve time step");
+    return m_pSolver->solveOneTimeStep();
+}
+
 void Problem::updateTime(double timeStep)
 {
     m_time += timeStep;
@@ -313,14 +1041,43 @@ void Problem::simulate()
 
     std::cout << std::string(40, '-') << std::endl;
 
-    m_clock.start();
-    for(auto& pExtractor : m_pExtractors)
+    if(m_isRestarted)
+    {
+        if(m_restartExtractorsData.size() != m_pExtractors.size())
+            throw std::runtime_error("the checkpoint does not contain the right number of extractors: " +
+                                     std::to_string(m_restartExtractorsData.size()) + " vs " + std::to_string(m_pExtractors.size()) + "!");
+
+        m_pSolver->setCheckpointData(m_restartSolverData);
+        for(std::size_t i = 0 ; i < m_pExtractors.size() ; ++i)
+        {
+            const std::vector<double>& extractorData = m_restartExtractorsData[i];
+            if(extractorData.empty())
+                throw std::runtime_error("the checkpoint does not contain the state of extractor " + std::to_string(i) + "!");
+
+            m_pExtractors[i]->setNextWriteTrigger(extractorData[0]);
+            m_pExtractors[i]->setCheckpointData(std::vector<double>(extractorData.begin() + 1, extractorData.end()));
+        }
+    }
+
+    m_nextCheckpointTime = m_time + m_timeBetweenCheckpoints;
+
+    //The telemetry columns depend on the equations, which are only known once the child class built the solver
+    if(!m_telemetryFile.empty())
     {
-        pExtractor->update(false);
+        m_pTelemetry = std::make_unique<Telemetry>(this, m_telemetryFile, m_binaryTelemetry);
+        if(m_hasRestartTelemetrySize)
+            m_pTelemetry->resize(m_restartTelemetrySize);
     }
-    m_accumalatedTimes["Extract data"] += m_clock.end();
 
-    while(m_time < m_maxTime)
+    {
+        PROFILE_SCOPE("Extract data");
+        for(auto& pExtractor : m_pExtractors)
+        {
+            pExtractor->update(false);
+        }
+    }
+
+    while(m_time < m_maxTime && (m_maxSteps == 0 || m_step < m_maxSteps))
     {
         if(m_verboseOutput)
         {
@@ -341,33 +1098,114 @@ void Problem::simulate()
             }
         }
 
+        const bool isCapturedStep = !m_captureFile.empty() && !m_isCaptured && m_step == m_captureStep;
+        if(isCapturedStep)
+        {
+            PROFILE_SCOPE("Capture time step");
+            writeState(m_captureFile, true);
+            m_isCaptured = true;
+        }
+
+        const std::int64_t stepStartTime = Profiler::now();
+        const double timeStep = m_pSolver->getTimeStep();
+
+        PROFILE_TIMER(solveTimer, "Solve time step");
         bool ok = m_pSolver->solveOneTimeStep();
+        solveTimer.stop();
+
+        if(isCapturedStep)
+        {
+            PROFILE_SCOPE("Capture time step");
+            writeCaptureHash();
+        }
 
         if(ok)
         {
-            m_clock.start();
+            PROFILE_SCOPE("Extract data");
             for(auto& pExtractor : m_pExtractors)
             {
                 pExtractor->update(false);
             }
-            m_accumalatedTimes["Extract data"] += m_clock.end();
         }
 
-        if(g_shouldClose == 1)
+        //Measuring the memory of each subsystem walks the whole mesh: only done when it is recorded at each step,
+        //otherwise at checkpoints and at the end of the simulation
+        if(m_pTelemetry)
+        {
+            updateMemoryUsage();
+            m_pTelemetry->record(ok, timeStep, stepStartTime);
+        }
+
+        //Stop with a checkpoint before the job gets killed for exceeding its memory
+        const bool memoryExceeded = (m_memorySoftLimit != 0 && getCurrentRSS() > m_memorySoftLimit);
+        if(memoryExceeded)
+        {
+            std::cerr << std::endl << "The resident set size exceeds the memory soft limit ("
+                      << m_memorySoftLimit/(1024*1024) << " MB): writing a checkpoint and stopping." << std::endl;
+        }
+
+        if(g_shouldClose == 1 || memoryExceeded)
         {
-            m_clock.start();
-            for(auto& pExtractor : m_pExtractors)
             {
-                pExtractor->update(true);
+                PROFILE_SCOPE("Extract data");
+                for(auto& pExtractor : m_pExtractors)
+                {
+                    pExtractor->update(true);
+                    pExtractor->flush();
+                }
+
+                if(m_pTelemetry)
+                    m_pTelemetry->flush();
+            }
+
+            if(!m_checkpointFile.empty())
+            {
+                m_pSolver->computeNextDT();
+                writeCheckpoint();
             }
-            m_accumalatedTimes["Extract data"] += m_clock.end();
 
             break;
         }
 
-        m_clock.start();
-        m_pSolver->computeNextDT();
-        m_accumalatedTimes["Compute next dt"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Compute next dt");
+            m_pSolver->computeNextDT();
+        }
+
+        if(ok && !m_checkpointFile.empty() && m_time >= m_nextCheckpointTime)
+        {
+            //The extractors output should be on the disk before the checkpoint refers to it
+            {
+                PROFILE_SCOPE("Flush extractors");
+                for(auto& pExtractor : m_pExtractors)
+                {
+                    pExtractor->flush();
+                }
+
+                if(m_pTelemetry)
+                    m_pTelemetry->flush();
+            }
+
+            if(!m_pTelemetry)
+                updateMemoryUsage();
+
+            writeCheckpoint();
+            m_nextCheckpointTime += m_timeBetweenCheckpoints;
+        }
+    }
+
+    if(!m_pTelemetry)
+        updateMemoryUsage();
+
+    {
+        PROFILE_SCOPE("Flush extractors");
+        for(auto& pExtractor : m_pExtractors)
+        {
+            pExtractor->flush();
+        }
+
+        if(m_pTelemetry)
+            m_pTelemetry->flush();
     }
 
     std::cout << std::endl;
@@ -2,13 +2,15 @@
 #ifndef PROBLEM_HPP_INCLUDED
 #define PROBLEM_HPP_INCLUDED
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
-#include "utility/Clock.hpp"
+#include "utility/Memory.hpp"
+#include "utility/Profiler.hpp"
 #include "utility/SolTable.hpp"
 
 #include "../mesh/Mesh.hpp"
@@ -17,6 +19,29 @@
 
 class Solver;
 class Extractor;
+class Telemetry;
+
+/**
+ * \struct WrittableField
+ * \brief Data which can be extracted from a problem, resolved once from its name so that
+ * it can be extracted afterwards without any string comparison.
+ */
+struct WrittableField
+{
+    enum class Kind
+    {
+        State,              /**< One of the nodes states. */
+        KineticEnergy,      /**< Kinetic energy per unit mass, 0.5*|v|^2. */
+        VelocityMagnitude,  /**< Norm of the velocity. */
+        Velocity,           /**< Velocity vector, always with 3 components. */
+        Normal,             /**< Normal of boundary and free surface nodes. */
+        NodeType            /**< Value identifying the type of the node (debug). */
+    };
+
+    Kind kind;
+    unsigned int stateIndex;        /**< Index of the state (Kind::State only). */
+    unsigned short componentsCount; /**< Number of values per node. */
+};
 
 /**
  * \class Problem
@@ -30,7 +55,11 @@ class Extractor;
 class SIMULATION_API Problem
 {
     public:
-        Problem(const std::string& luaFilePath);
+        /**
+         * \param luaFilePath The lua parameters file.
+         * \param restartFile If not empty, the checkpoint file from which the simulation is restarted.
+         */
+        Problem(const std::string& luaFilePath, const std::string& restartFile = "");
         Problem(const Problem& problem)             = delete;
         Problem& operator=(const Problem& problem)  = delete;
         Problem(Problem&& problem)                  = delete;
@@ -40,19 +69,39 @@ class SIMULATION_API Problem
         /// \brief Display general parameters of the problem.
         virtual void displayParams() const;
 
-        /// \brief Display time statistics.
+        /// \brief Display the solver statistics and the profiler call tree, and write the optional
+        ///        profiler report and trace files.
         void displayTimeStats() const;
 
+        /// \brief Display the memory allocated by each subsystem at the end of the last time step, its
+        ///        high-water mark and the peak resident set size.
+        void displayMemoryStats() const;
+
         /// \return The id of the problem (child class have to set m_id).
         std::string getID() const noexcept;
 
         /// \return A vector containing the name of the data which can be extracted for this problem.
         virtual std::vector<std::string> getWrittableDataName() const;
 
+        /// \param name The name of the data (problem or mesh data) to write.
+        /// \return The field which allows to extract the data without any string comparison.
+        WrittableField getWrittableField(const std::string& name) const;
+
+        /// \param field The field to extract.
+        /// \param nodeIndex From which node should the data be extracted.
+        /// \param pData Buffer of field.componentsCount values in which the data is written.
+        inline void getWrittableData(const WrittableField& field, std::size_t nodeIndex, double* pData) const;
+
+        /// \brief Extract a field for all the nodes in parallel.
+        /// \param field The field to extract.
+        /// \param pData Buffer of field.componentsCount*nodesCount values in which the data is written,
+        /// the components of a node being contiguous.
+        void getWrittableData(const WrittableField& field, double* pData) const;
+
         /// \param name The name of the data to write.
         /// \param nodeIndex From which node should the data be extracted.
         /// \return A vector containing the value of the data.
-        virtual std::vector<double> getWrittableData(const std::string& name, std::size_t nodeIndex) const;
+        std::vector<double> getWrittableData(const std::string& name, std::size_t nodeIndex) const;
 
         /// \return A vector containing the name of the global data which can be extracted for this problem.
         virtual std::vector<std::string> getGlobalWrittableDataName() const;
@@ -61,6 +110,10 @@ class SIMULATION_API Problem
         /// \return The value of the global data.
         virtual double getGlobalWrittableData(const std::string& name) const;
 
+        /// \param names The names of the global data to write.
+        /// \return The values of the global data, the diagnostics being computed in a single pass over the nodes.
+        std::vector<double> computeGlobalWrittableData(const std::vector<std::string>& names) const;
+
         /// \return A vector containing the name of the mesh data which can be extracted for this problem.
         std::vector<std::string> getMeshWrittableDataName() const;
 
@@ -83,9 +136,40 @@ class SIMULATION_API Problem
         inline unsigned int getThreadCount() const noexcept;
         inline bool isOutputVerbose() const noexcept;
 
+        /// \return Was the problem loaded from a checkpoint (the extractors then append to their files) ?
+        inline bool isRestarted() const noexcept;
+
+        /// \return The memory allocated by each subsystem at the last measure (end of each time step if the telemetry
+        ///         is enabled, checkpoints and end of the simulation otherwise).
+        inline const MemoryUsage& getMemoryUsage() const noexcept;
+
+        /// \return The highest memory allocated by each subsystem over the measures.
+        inline const MemoryUsage& getPeakMemoryUsage() const noexcept;
+
+        /// \param maxSteps The maximum number of time steps done by simulate (0 if unlimited).
+        inline void setMaxSteps(std::size_t maxSteps) noexcept;
+
         /// \brief Write all extractor data.
         void dump();
 
+        /// \brief Write the full simulation state (time, solver, extractors and mesh) in the checkpoint file.
+        void writeCheckpoint() const;
+
+        /// \brief Solve the time step loaded from a capture (see captureFile), without any extraction, so that
+        ///        it can be profiled alone.
+        /// \return Was the time step accepted by the solver ?
+        bool replayTimeStep();
+
+        /// \return A FNV-1a hash of the nodes positions and states, to compare the result of a replayed time step
+        ///         with the original run.
+        std::uint64_t computeNodesHash() const;
+
+        /// \return Does the capture the problem was loaded from contain the nodes hash after the captured time step ?
+        inline bool hasCapturedNodesHash() const noexcept;
+
+        /// \return The nodes hash after the captured time step in the original run (see computeNodesHash).
+        inline std::uint64_t getCapturedNodesHash() const noexcept;
+
         /// \brief This function simulate the problem from t = 0 to t = t_max
         void simulate();
 
@@ -97,6 +181,7 @@ class SIMULATION_API Problem
         std::string m_id;               /**<  The id of the problem (should be set by child class). */
         double m_time;                  /**<  Current time of the simulation. */
         double m_maxTime;               /**<  Maximum time of the simulation. */
+        std::size_t m_maxSteps;         /**<  Maximum number of time steps of the simulation (0 if unlimited). */
         std::size_t m_step;             /**<  Current step of the simulation. */
         unsigned int m_statesNumber;    /**<  Number of states used by the problem. */
 
@@ -110,8 +195,43 @@ class SIMULATION_API Problem
         std::unique_ptr<Solver> m_pSolver;      /**<  Smart pointer to the solver. */
         std::vector<std::unique_ptr<Extractor>> m_pExtractors;  /**<  Smart pointer to the extractirs. */
 
-        std::map<std::string, double> m_accumalatedTimes;  /**< Accumulated time in each part of the solver*/
-        Clock m_clock;
+        std::string m_profileFile;          /**<  File in which the profiler call tree is written in JSON (optional). */
+        std::string m_traceFile;            /**<  File in which the profiler Chrome trace is written (optional). */
+
+        std::string m_telemetryFile;            /**<  File in which a record per time step is written (optional). */
+        bool m_binaryTelemetry;                 /**<  Should the telemetry be written in binary instead of NDJSON ? */
+        std::unique_ptr<Telemetry> m_pTelemetry;/**<  Smart pointer to the telemetry writer (created by simulate). */
+
+        std::string m_checkpointFile;       /**<  File in which checkpoints are written (empty if disabled). */
+        double m_timeBetweenCheckpoints;    /**<  The simulation time between each checkpoint. */
+        double m_nextCheckpointTime;        /**<  The simulation time at which the next checkpoint is written. */
+
+        std::string m_captureFile;          /**<  File in which the inputs of a time step are captured (empty if disabled). */
+        std::size_t m_captureStep;          /**<  Number of time steps done before the captured one. */
+        bool m_isCaptured;                  /**<  Was the time step already captured (only its first attempt is) ? */
+        bool m_hasCapturedNodesHash;        /**<  Does the loaded capture contain the nodes hash after its time step ? */
+        std::uint64_t m_capturedNodesHash;  /**<  Nodes hash after the captured time step in the original run. */
+
+        MemoryUsage m_memoryUsage;          /**<  Memory allocated by each subsystem at the last measure. */
+        MemoryUsage m_peakMemoryUsage;      /**<  Highest memory allocated by each subsystem over the measures. */
+        std::size_t m_memorySoftLimit;      /**<  Resident set size above which a checkpoint is written and the simulation stops (0 if disabled). */
+        bool m_isRestarted;                             /**<  Was the problem loaded from a checkpoint ? */
+        std::size_t m_restartStatesCount;               /**<  Number of states per node stored in the checkpoint. */
+        std::vector<double> m_restartSolverData;        /**<  Solver state read from the checkpoint. */
+        std::vector<std::vector<double>> m_restartExtractorsData;   /**<  Per extractor, the next write time then its own state, read from the checkpoint. */
+        bool m_hasRestartTelemetrySize;                 /**<  Was the telemetry enabled when the checkpoint was written ? */
+        std::uint64_t m_restartTelemetrySize;           /**<  Size of the telemetry file when the checkpoint was written. */
+
+        /// \return The name of the global diagnostics computed from the nodes velocity: kinetic energy (per unit density),
+        /// maximum velocity, center of mass and free surface extent.
+        std::vector<std::string> getDiagnosticsName() const;
+
+        /// \return The value of the diagnostics, in the order of getDiagnosticsName(), computed in a single pass over the nodes.
+        std::vector<double> computeDiagnostics() const;
+
+        /// \param name The name of the data to write.
+        /// \return The field corresponding to the problem data name (child class have to implement it).
+        virtual WrittableField resolveWrittableField(const std::string& name) const;
 
         /// \brief This function parse the lua parameters file and set the requires extractors in m_pExtractors.
         /// Should be called in the constructor of every child class.
@@ -120,6 +240,21 @@ class SIMULATION_API Problem
         /// \brief This function parse the lua parameters file and set the initial condition.
         /// Should be called in the constructor of every child class.
         void setInitialCondition();
+
+        /// \brief Measure the memory allocated by each subsystem and update its high-water mark.
+        void updateMemoryUsage();
+
+        /**
+         * \brief Write the full simulation state (time, solver, extractors and mesh) in a binary file, through a
+         *        temporary file so that a previous one is only replaced once the new one is complete.
+         * \param fileName The name of the file.
+         * \param writeConnectivity Should the mesh connectivity be written (see Mesh::writeCheckpoint) ?
+         */
+        void writeState(const std::string& fileName, bool writeConnectivity) const;
+
+        /// \brief Append the nodes hash after the captured time step to the capture file, so that pfem_replay can
+        ///        check that it reproduces the original run.
+        void writeCaptureHash() const;
 };
 
 #include "Problem.inl"
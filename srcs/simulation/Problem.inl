@@ -1,5 +1,7 @@
 #include "Problem.hpp"
 
+#include <cmath>
+
 inline const Mesh& Problem::getMesh() const noexcept
 {
     return *m_pMesh;
@@ -30,4 +32,92 @@ inline bool Problem::isOutputVerbose() const noexcept
     return m_verboseOutput;
 }
 
+inline bool Problem::isRestarted() const noexcept
+{
+    return m_isRestarted;
+}
+
+inline bool Problem::hasCapturedNodesHash() const noexcept
+{
+    return m_hasCapturedNodesHash;
+}
+
+inline std::uint64_t Problem::getCapturedNodesHash() const noexcept
+{
+    return m_capturedNodesHash;
+}
+
+inline const MemoryUsage& Problem::getMemoryUsage() const noexcept
+{
+    return m_memoryUsage;
+}
+
+inline const MemoryUsage& Problem::getPeakMemoryUsage() const noexcept
+{
+    return m_peakMemoryUsage;
+}
+
+inline void Problem::setMaxSteps(std::size_t maxSteps) noexcept
+{
+    m_maxSteps = maxSteps;
+}
+
+inline void Problem::getWrittableData(const WrittableField& field, std::size_t nodeIndex, double* pData) const
+{
+    const Node& node = m_pMesh->getNode(nodeIndex);
+    const unsigned short dim = m_pMesh->getDim();
+
+    switch(field.kind)
+    {
+        case WrittableField::Kind::State:
+            pData[0] = node.getState(field.stateIndex);
+            break;
+
+        case WrittableField::Kind::KineticEnergy:
+        case WrittableField::Kind::VelocityMagnitude:
+        {
+            double velocity2 = 0;
+            for(unsigned short d = 0 ; d < dim ; ++d)
+                velocity2 += node.getState(d)*node.getState(d);
+
+            pData[0] = (field.kind == WrittableField::Kind::KineticEnergy) ? 0.5*velocity2 : std::sqrt(velocity2);
+            break;
+        }
+
+        case WrittableField::Kind::Velocity:
+            for(unsigned short d = 0 ; d < 3 ; ++d)
+                pData[d] = (d < dim) ? node.getState(d) : 0;
+            break;
+
+        case WrittableField::Kind::Normal:
+            if(m_pMesh->isNormalCurvComputed() && (node.isOnFreeSurface() || (node.isBound() && !node.isFree())))
+            {
+                std::array<double, 3> normal = m_pMesh->getBoundFSNormal(nodeIndex);
+                pData[0] = normal[0];
+                pData[1] = normal[1];
+                pData[2] = normal[2];
+            }
+            else
+            {
+                pData[0] = 0;
+                pData[1] = 0;
+                pData[2] = 0;
+            }
+            break;
+
+        case WrittableField::Kind::NodeType:
+            if(node.isOnFreeSurface())
+                pData[0] = -2;
+            else if(node.isFree())
+                pData[0] = -1;
+            else if(node.isBound() || node.isContact())
+                pData[0] = 1;
+            else if(node.isFixed())
+                pData[0] = 2;
+            else
+                pData[0] = 0;
+            break;
+    }
+}
+
 
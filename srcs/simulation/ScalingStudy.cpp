@@ -0,0 +1,244 @@
+#include "ScalingStudy.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(_OPENMP)
+    #include <omp.h>
+#endif
+
+#include "Problem.hpp"
+#include "utility/Profiler.hpp"
+
+/// Regions taking less than this fraction of the one thread run are not reported.
+static constexpr double minRegionFraction = 0.01;
+
+static std::string escapeName(const std::string& name)
+{
+    std::string escaped;
+    for(char c : name)
+    {
+        if(c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+ScalingStudy::ScalingStudy(std::function<std::unique_ptr<Problem>()> createProblem, std::size_t stepsCount,
+                           unsigned int maxThreads) :
+m_createProblem(std::move(createProblem)),
+m_stepsCount(stepsCount)
+{
+    if(m_stepsCount == 0)
+        throw std::runtime_error("the scaling study requires at least one time step!");
+
+    if(maxThreads == 0)
+    {
+        const char* pNumThreads = std::getenv("OMP_NUM_THREADS");
+        if(pNumThreads != nullptr && std::atoi(pNumThreads) > 0)
+            maxThreads = static_cast<unsigned int>(std::atoi(pNumThreads));
+        else
+        {
+#if defined(_OPENMP)
+            maxThreads = static_cast<unsigned int>(omp_get_num_procs());
+#else
+            maxThreads = 1;
+#endif
+        }
+    }
+
+    for(unsigned int threadsCount = 1 ; threadsCount < maxThreads ; threadsCount *= 2)
+        m_threadsCounts.push_back(threadsCount);
+
+    m_threadsCounts.push_back(maxThreads);
+}
+
+void ScalingStudy::run()
+{
+    m_results.clear();
+
+    for(unsigned int threadsCount : m_threadsCounts)
+    {
+        std::cout << "======================================" << std::endl;
+        std::cout << "Scaling study: " << m_stepsCount << " time steps with " << threadsCount << " thread(s)"
+                  << std::endl;
+        std::cout << "======================================" << std::endl;
+
+        setThreadsCount(threadsCount);
+
+        std::unique_ptr<Problem> pProblem = m_createProblem();
+        pProblem->setMaxSteps(m_stepsCount);
+
+        //The problem loading is not part of the measure
+        Profiler::reset();
+        const std::int64_t startTime = Profiler::now();
+        pProblem->simulate();
+        const std::int64_t endTime = Profiler::now();
+
+        RunResult result;
+        result.threadsCount = threadsCount;
+        result.totalTime = static_cast<double>(endTime - startTime)*1e-9;
+        result.regionsTime = Profiler::getRegionsTime(true);
+        m_regionNames = Profiler::getRegionNames();
+
+        result.categoriesTime.fill(0);
+        for(std::size_t region = 0 ; region < result.regionsTime.size() ; ++region)
+        {
+            const std::size_t category = Telemetry::getCategory(m_regionNames[region]);
+            if(category != Telemetry::CategoriesCount)
+                result.categoriesTime[category] += result.regionsTime[region];
+        }
+
+        m_results.push_back(std::move(result));
+    }
+
+    //Regions registered during the later runs were not entered by the first ones
+    for(auto& result : m_results)
+        result.regionsTime.resize(m_regionNames.size(), 0);
+}
+
+void ScalingStudy::writeReport(std::ostream& out) const
+{
+    if(m_results.empty())
+        throw std::runtime_error("the scaling study should be run before writing its report!");
+
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    out << "Scaling study (" << m_stepsCount << " time steps, speedup S and efficiency E relative to 1 thread)"
+        << std::endl;
+    out << std::left << std::setw(40) << "" << std::right << std::setw(12) << "T1 (s)";
+    for(std::size_t i = 1 ; i < m_results.size() ; ++i)
+        out << std::setw(16) << (std::to_string(m_results[i].threadsCount) + " threads");
+    out << std::endl;
+
+    auto getTimes = [&](auto&& getTime) -> std::vector<double>
+    {
+        std::vector<double> times;
+        for(const auto& result : m_results)
+            times.push_back(getTime(result));
+
+        return times;
+    };
+
+    writeReportLine(out, "total", getTimes([](const RunResult& result){ return result.totalTime; }));
+
+    out << "-- per category" << std::endl;
+    for(std::size_t category = 0 ; category < Telemetry::CategoriesCount ; ++category)
+    {
+        writeReportLine(out, Telemetry::getCategoryName(category),
+                        getTimes([category](const RunResult& result){ return result.categoriesTime[category]; }));
+    }
+
+    out << "-- per region (sorted by decreasing efficiency loss)" << std::endl;
+    std::vector<std::size_t> regions;
+    for(std::size_t region = 0 ; region < m_regionNames.size() ; ++region)
+    {
+        if(m_results[0].regionsTime[region] >= minRegionFraction*m_results[0].totalTime)
+            regions.push_back(region);
+    }
+
+    //The time lost with the largest threads count compared to a perfect scaling
+    auto getLostTime = [&](std::size_t region) -> double
+    {
+        const RunResult& last = m_results.back();
+        return last.regionsTime[region] - m_results[0].regionsTime[region]/last.threadsCount;
+    };
+
+    std::sort(regions.begin(), regions.end(), [&](std::size_t a, std::size_t b)
+    {
+        return getLostTime(a) > getLostTime(b);
+    });
+
+    for(std::size_t region : regions)
+    {
+        writeReportLine(out, m_regionNames[region],
+                        getTimes([region](const RunResult& result){ return result.regionsTime[region]; }));
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void ScalingStudy::writeJSONReport(const std::string& fileName) const
+{
+    std::ofstream file(fileName);
+    if(!file.is_open())
+        throw std::runtime_error("cannot open file to write the scaling report: " + fileName);
+
+    file << std::setprecision(9);
+    file << "{\"steps\": " << m_stepsCount << ", \"runs\": [";
+
+    for(std::size_t i = 0 ; i < m_results.size() ; ++i)
+    {
+        const RunResult& result = m_results[i];
+
+        file << (i == 0 ? "" : ", ") << "{\"threads\": " << result.threadsCount
+             << ", \"total\": " << result.totalTime << ", \"categories\": {";
+
+        for(std::size_t category = 0 ; category < Telemetry::CategoriesCount ; ++category)
+        {
+            file << (category == 0 ? "" : ", ") << "\"" << Telemetry::getCategoryName(category) << "\": "
+                 << result.categoriesTime[category];
+        }
+
+        file << "}, \"regions\": {";
+
+        bool first = true;
+        for(std::size_t region = 0 ; region < result.regionsTime.size() ; ++region)
+        {
+            if(result.regionsTime[region] == 0)
+                continue;
+
+            file << (first ? "" : ", ") << "\"" << escapeName(m_regionNames[region]) << "\": "
+                 << result.regionsTime[region];
+            first = false;
+        }
+
+        file << "}}";
+    }
+
+    file << "]}" << std::endl;
+}
+
+void ScalingStudy::writeReportLine(std::ostream& out, const std::string& name, const std::vector<double>& times) const
+{
+    out << std::left << std::setw(40) << name.substr(0, 39) << std::right
+        << std::fixed << std::setprecision(3) << std::setw(12) << times[0];
+
+    for(std::size_t i = 1 ; i < times.size() ; ++i)
+    {
+        if(times[0] == 0 || times[i] == 0)
+        {
+            out << std::setw(16) << "-";
+            continue;
+        }
+
+        const double speedup = times[0]/times[i];
+        const double efficiency = speedup/m_results[i].threadsCount;
+
+        std::ostringstream cell;
+        cell << std::fixed << std::setprecision(2) << speedup << " / " << std::setprecision(0) << 100*efficiency
+             << "%";
+        out << std::setw(16) << cell.str();
+    }
+
+    out << std::endl;
+}
+
+void ScalingStudy::setThreadsCount(unsigned int threadsCount)
+{
+    const std::string value = std::to_string(threadsCount);
+#if defined(_WIN32)
+    _putenv_s("OMP_NUM_THREADS", value.c_str());
+#else
+    setenv("OMP_NUM_THREADS", value.c_str(), 1);
+#endif
+}
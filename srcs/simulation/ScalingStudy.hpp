@@ -0,0 +1,77 @@
+#pragma once
+#ifndef SCALINGSTUDY_HPP_INCLUDED
+#define SCALINGSTUDY_HPP_INCLUDED
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "simulation_defines.h"
+#include "Telemetry.hpp"
+
+class Problem;
+
+/**
+ * \class ScalingStudy
+ * \brief Runs the same number of time steps of a problem with 1, 2, 4, ... threads (up to the maximum
+ * number of threads) and reports the speedup and the parallel efficiency of the whole run, of each
+ * category of regions (remeshing, assembly, solve, boundary conditions, extraction) and of each profiler
+ * region, to expose the regions which do not scale.
+ *
+ * The times are the wall times of the regions entered by the calling (master) thread.
+ */
+class SIMULATION_API ScalingStudy
+{
+    public:
+        ScalingStudy()                                  = delete;
+        /**
+         * \param createProblem Callable building a new problem (called once per threads count, after
+         *                      OMP_NUM_THREADS was set).
+         * \param stepsCount The number of time steps done by each run.
+         * \param maxThreads The largest number of threads (0 for OMP_NUM_THREADS if set, or else the
+         *                   number of processors).
+         */
+        ScalingStudy(std::function<std::unique_ptr<Problem>()> createProblem, std::size_t stepsCount,
+                     unsigned int maxThreads = 0);
+        ScalingStudy(const ScalingStudy& study)             = delete;
+        ScalingStudy& operator=(const ScalingStudy& study)  = delete;
+        ScalingStudy(ScalingStudy&& study)                  = delete;
+        ScalingStudy& operator=(ScalingStudy&& study)       = delete;
+        ~ScalingStudy()                                     = default;
+
+        /// \brief Run the problem for each threads count.
+        void run();
+
+        /// \brief Write the time with one thread, the speedup and the efficiency for each threads count.
+        void writeReport(std::ostream& out) const;
+
+        /// \brief Write the times of each run in a JSON file.
+        void writeJSONReport(const std::string& fileName) const;
+
+    private:
+        /// Result of one run.
+        struct RunResult
+        {
+            unsigned int threadsCount;
+            double totalTime;
+            std::array<double, Telemetry::CategoriesCount> categoriesTime;
+            std::vector<double> regionsTime;    /**< Indexed by region id. */
+        };
+
+        /// \brief Write one line of the report from the time of each run.
+        void writeReportLine(std::ostream& out, const std::string& name, const std::vector<double>& times) const;
+
+        /// \brief Set OMP_NUM_THREADS so that the next built problem uses threadsCount threads.
+        static void setThreadsCount(unsigned int threadsCount);
+
+        std::function<std::unique_ptr<Problem>()> m_createProblem;
+        std::size_t m_stepsCount;
+        std::vector<unsigned int> m_threadsCounts;
+        std::vector<std::string> m_regionNames;
+        std::vector<RunResult> m_results;
+};
+
+#endif // SCALINGSTUDY_HPP_INCLUDED
@@ -1,7 +1,5 @@
 #include "Solver.hpp"
 
-#include <iomanip>
-
 #include "../mesh/Mesh.hpp"
 #include "Problem.hpp"
 #include "Equation.hpp"
@@ -12,7 +10,8 @@
 Solver::Solver(Problem* pProblem, Mesh* pMesh, std::vector<SolTable> m_problemParams):
 m_timeStep(0),
 m_pMesh(pMesh),
-m_pProblem(pProblem)
+m_pProblem(pProblem),
+m_nextTimeToRemesh(0)
 {
     m_solverParams.resize(m_pProblem->getThreadCount());
     for(std::size_t i = 0 ; i < m_solverParams.size() ; ++i)
@@ -78,16 +77,18 @@ void Solver::displayParams() const
 
 void Solver::displayTimeStats() const
 {
-    for(auto& keyPair : m_accumalatedTimes)
-    {
-        std::cout << std::defaultfloat << std::setprecision(7) << std::setw(40) << std::left << keyPair.first << ": " << std::setw(10) << std::right << keyPair.second << " s" << std::endl;
-    }
 
-    for(auto& pEquation : m_pEquations)
-    {
-        std::cout << "--------------------------------------" << std::endl;
-        pEquation->displayTimeStats();
-    }
+}
+
+std::size_t Solver::getEquationsCount() const noexcept
+{
+    return m_pEquations.size();
+}
+
+const Equation& Solver::getEquation(std::size_t index) const noexcept
+{
+    assert(index < m_pEquations.size());
+    return *m_pEquations[index];
 }
 
 std::string Solver::getID() const noexcept
@@ -154,6 +155,20 @@ std::size_t Solver::getAdditionalStateCount() const
     throw std::runtime_error("Unimplemented function by the child class -> Solver::getAdditionalStateCount()");
 }
 
+std::vector<double> Solver::getCheckpointData() const
+{
+    return {m_timeStep, m_nextTimeToRemesh};
+}
+
+void Solver::setCheckpointData(const std::vector<double>& data)
+{
+    if(data.size() < 2)
+        throw std::runtime_error("the checkpoint does not contain enough solver data!");
+
+    m_timeStep = data[0];
+    m_nextTimeToRemesh = data[1];
+}
+
 void Solver::m_conditionalRemesh()
 {
     bool force = false;
@@ -6,7 +6,7 @@
 #include <memory>
 #include <vector>
 
-#include "utility/Clock.hpp"
+#include "utility/Profiler.hpp"
 #include "utility/SolTable.hpp"
 #include "meshSmoother/MeshSmoother.hpp"
 
@@ -37,8 +37,8 @@ class SIMULATION_API Solver
         /// \brief Display general parameters of the solver.
         virtual void displayParams() const;
 
-        /// \brief Display time statistics.
-        void displayTimeStats() const;
+        /// \brief Display the statistics of the solver (the timings are reported by the Profiler).
+        virtual void displayTimeStats() const;
 
         bool checkBC(SolTable bcParam, unsigned int n, const Node& node, std::string bcString, unsigned int expectedBCSize);
         bool checkFreeSurfaceBC(SolTable bcParam, const Node& node, std::string bcString, unsigned int expectedBCSize);
@@ -60,6 +60,19 @@ class SIMULATION_API Solver
 
         inline double getTimeStep() const noexcept;
 
+        /// \return The number of equations solved by the solver.
+        std::size_t getEquationsCount() const noexcept;
+
+        /// \param index The index of the equation.
+        /// \return The equation.
+        const Equation& getEquation(std::size_t index) const noexcept;
+
+        /// \return The internal state of the solver required to restart the simulation from a checkpoint.
+        virtual std::vector<double> getCheckpointData() const;
+
+        /// \param data The internal state of the solver, as returned by getCheckpointData.
+        virtual void setCheckpointData(const std::vector<double>& data);
+
     protected:
         std::string m_id;   /**<  The id of the solver (should be set by child class). */
 
@@ -80,9 +93,6 @@ class SIMULATION_API Solver
         Mesh* m_pMesh;          /**< Pointer to the mesh used. */
         Problem* m_pProblem;    /**< Pointer to the underlying problem. */
 
-        std::map<std::string, double> m_accumalatedTimes;  /**< Accumulated time in each part of the solver*/
-        Clock m_clock;
-
         std::vector<std::unique_ptr<MeshSmoother>> m_pMeshSmoothers;
 
         double m_nextTimeToRemesh;
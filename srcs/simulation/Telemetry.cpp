@@ -0,0 +1,281 @@
+#include "Telemetry.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+#include "Equation.hpp"
+#include "Problem.hpp"
+#include "Solver.hpp"
+#include "nonLinearAlgo/NonLinearAlgo.hpp"
+#include "utility/Memory.hpp"
+#include "utility/Profiler.hpp"
+
+static bool startsWith(const std::string& text, const char* prefix)
+{
+    return text.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+Telemetry::Telemetry(const Problem* pProblem, const std::string& fileName, bool binary) :
+m_pProblem(pProblem),
+m_pFile(nullptr),
+m_binary(binary),
+m_size(0),
+m_addedNodesCount(pProblem->getMesh().getAddedNodesCount()),
+m_removedNodesCount(pProblem->getMesh().getRemovedNodesCount()),
+m_linearIterCount(0)
+{
+    m_columnsName = {"step", "time", "dt", "accepted", "nodes", "elements", "facets", "addedNodes", "removedNodes", "rss",
+                     "peakRss", "meshMemory", "triangulationMemory", "matricesMemory", "factorizationsMemory",
+                     "assemblyMemory", "extractorsMemory"};
+
+    const Solver& solver = m_pProblem->getSolver();
+    for(std::size_t i = 0 ; i < solver.getEquationsCount() ; ++i)
+    {
+        const Equation& equation = solver.getEquation(i);
+        m_columnsName.push_back(equation.getID() + ".iterations");
+        m_columnsName.push_back(equation.getID() + ".residual");
+        m_linearIterCount += equation.getLinearIterCount();
+    }
+
+    m_columnsName.push_back("linearIterations");
+    for(std::size_t category = 0 ; category < CategoriesCount ; ++category)
+        m_columnsName.push_back(getCategoryName(category) + "Time");
+    m_columnsName.push_back("stepTime");
+    m_row.resize(m_columnsName.size());
+
+    m_categoriesTime = getCategoriesTime();
+
+    //On restart, the records are appended to the ones written before the checkpoint
+    const std::string header = getHeader();
+    bool writeHeader = true;
+    if(m_pProblem->isRestarted())
+    {
+        if(m_binary)
+        {
+            std::FILE* pFile = std::fopen(fileName.c_str(), "rb");
+            if(pFile != nullptr)
+            {
+                std::string existingHeader(header.size(), '\0');
+                const std::size_t readCount = std::fread(&existingHeader[0], 1, existingHeader.size(), pFile);
+                std::fclose(pFile);
+
+                if(readCount != 0)
+                {
+                    if(readCount != header.size() || existingHeader != header)
+                        throw std::runtime_error("cannot append to telemetry file " + fileName + ": the columns are not the same!");
+
+                    writeHeader = false;
+                }
+            }
+        }
+
+        m_pFile = std::fopen(fileName.c_str(), binary ? "ab" : "a");
+    }
+    else
+        m_pFile = std::fopen(fileName.c_str(), binary ? "wb" : "w");
+
+    if(m_pFile == nullptr)
+        throw std::runtime_error("cannot open file to write telemetry: " + fileName);
+
+    if(writeHeader && !header.empty())
+    {
+        std::fwrite(header.data(), 1, header.size(), m_pFile);
+        std::fflush(m_pFile);
+    }
+
+    std::fseek(m_pFile, 0, SEEK_END);
+    const long size = std::ftell(m_pFile);
+    m_size = (size > 0) ? static_cast<std::uint64_t>(size) : 0;
+}
+
+Telemetry::~Telemetry()
+{
+    std::fclose(m_pFile);
+}
+
+void Telemetry::record(bool accepted, double timeStep, std::int64_t startTime)
+{
+    const Mesh& mesh = m_pProblem->getMesh();
+    const Solver& solver = m_pProblem->getSolver();
+
+    std::size_t column = 0;
+    m_row[column++] = m_pProblem->getCurrentSimStep();
+    m_row[column++] = m_pProblem->getCurrentSimTime();
+    m_row[column++] = timeStep;
+    m_row[column++] = accepted ? 1 : 0;
+    m_row[column++] = static_cast<double>(mesh.getNodesCount());
+    m_row[column++] = static_cast<double>(mesh.getElementsCount());
+    m_row[column++] = static_cast<double>(mesh.getFacetsCount());
+    m_row[column++] = static_cast<double>(mesh.getAddedNodesCount() - m_addedNodesCount);
+    m_row[column++] = static_cast<double>(mesh.getRemovedNodesCount() - m_removedNodesCount);
+    m_row[column++] = static_cast<double>(getCurrentRSS());
+    m_row[column++] = static_cast<double>(getPeakRSS());
+
+    const MemoryUsage& memoryUsage = m_pProblem->getMemoryUsage();
+    m_row[column++] = static_cast<double>(memoryUsage.mesh);
+    m_row[column++] = static_cast<double>(memoryUsage.triangulation);
+    m_row[column++] = static_cast<double>(memoryUsage.matrices);
+    m_row[column++] = static_cast<double>(memoryUsage.factorizations);
+    m_row[column++] = static_cast<double>(memoryUsage.assembly);
+    m_row[column++] = static_cast<double>(memoryUsage.extractors);
+    m_addedNodesCount = mesh.getAddedNodesCount();
+    m_removedNodesCount = mesh.getRemovedNodesCount();
+
+    std::size_t linearIterCount = 0;
+    for(std::size_t i = 0 ; i < solver.getEquationsCount() ; ++i)
+    {
+        const Equation& equation = solver.getEquation(i);
+        const NonLinearAlgo* pNonLinearAlgo = equation.getNonLinearAlgo();
+        m_row[column++] = pNonLinearAlgo == nullptr ? 0 : pNonLinearAlgo->getLastIterCount();
+        m_row[column++] = pNonLinearAlgo == nullptr ? 0 : pNonLinearAlgo->getLastResidual();
+        linearIterCount += equation.getLinearIterCount();
+    }
+    m_row[column++] = static_cast<double>(linearIterCount - m_linearIterCount);
+    m_linearIterCount = linearIterCount;
+
+    const std::array<double, CategoriesCount> categoriesTime = getCategoriesTime();
+    for(std::size_t category = 0 ; category < CategoriesCount ; ++category)
+        m_row[column++] = categoriesTime[category] - m_categoriesTime[category];
+    m_categoriesTime = categoriesTime;
+
+    m_row[column++] = static_cast<double>(Profiler::now() - startTime)/1000000000.0;
+
+    writeRow();
+}
+
+void Telemetry::flush()
+{
+    std::fflush(m_pFile);
+}
+
+std::uint64_t Telemetry::getSize() const noexcept
+{
+    return m_size;
+}
+
+void Telemetry::resize(std::uint64_t size)
+{
+    //A file shorter than the checkpoint one (e.g. replaced since) has nothing to drop
+    if(size >= m_size)
+        return;
+
+    std::fflush(m_pFile);
+
+#ifdef _WIN32
+    const bool ok = _chsize_s(_fileno(m_pFile), static_cast<__int64>(size)) == 0;
+#else
+    const bool ok = ftruncate(fileno(m_pFile), static_cast<off_t>(size)) == 0;
+#endif
+    if(!ok)
+        throw std::runtime_error("cannot resize the telemetry file!");
+
+    m_size = size;
+
+    //An emptied binary file gets its header back
+    if(m_size == 0 && m_binary)
+    {
+        const std::string header = getHeader();
+        std::fwrite(header.data(), 1, header.size(), m_pFile);
+        std::fflush(m_pFile);
+        m_size = header.size();
+    }
+}
+
+std::size_t Telemetry::getCategory(const std::string& regionName)
+{
+    if(startsWith(regionName, "Remeshing"))
+        return Remeshing;
+    else if(startsWith(regionName, "Assemble") || startsWith(regionName, "Compute triplets") ||
+            startsWith(regionName, "Prepare matri") || startsWith(regionName, "Push back"))
+        return Assembly;
+    else if(startsWith(regionName, "Solve system") || startsWith(regionName, "Factorize") ||
+            startsWith(regionName, "Analyse pattern") || startsWith(regionName, "Compute matrix"))
+        return LinearSolve;
+    else if(startsWith(regionName, "Apply boundary conditions"))
+        return BoundaryConditions;
+    else if(startsWith(regionName, "Extract data") || startsWith(regionName, "Flush extractors"))
+        return Extraction;
+
+    return CategoriesCount;
+}
+
+std::string Telemetry::getCategoryName(std::size_t category)
+{
+    static const std::array<std::string, CategoriesCount> names = {"remesh", "assembly", "solve", "bc", "extraction"};
+
+    return category < CategoriesCount ? names[category] : "other";
+}
+
+std::array<double, Telemetry::CategoriesCount> Telemetry::getCategoriesTime()
+{
+    //Regions can be registered lazily (first call of a function), so new ones are classified on the fly
+    const std::vector<std::string> regionNames = Profiler::getRegionNames();
+    for(std::size_t region = m_regionsCategory.size() ; region < regionNames.size() ; ++region)
+        m_regionsCategory.push_back(getCategory(regionNames[region]));
+
+    std::array<double, CategoriesCount> categoriesTime;
+    categoriesTime.fill(0);
+
+    const std::vector<double> regionsTime = Profiler::getRegionsTime(true);
+    for(std::size_t region = 0 ; region < regionsTime.size() && region < m_regionsCategory.size() ; ++region)
+    {
+        if(m_regionsCategory[region] != CategoriesCount)
+            categoriesTime[m_regionsCategory[region]] += regionsTime[region];
+    }
+
+    return categoriesTime;
+}
+
+std::string Telemetry::getHeader() const
+{
+    if(!m_binary)
+        return std::string();
+
+    std::string header = "PFEMTLM1";
+    auto appendUInt32 = [&header](std::size_t value)
+    {
+        const std::uint32_t value32 = static_cast<std::uint32_t>(value);
+        header.append(reinterpret_cast<const char*>(&value32), sizeof(value32));
+    };
+
+    appendUInt32(m_columnsName.size());
+    for(const std::string& name : m_columnsName)
+    {
+        appendUInt32(name.size());
+        header += name;
+    }
+
+    return header;
+}
+
+void Telemetry::writeRow()
+{
+    if(m_binary)
+        std::fwrite(m_row.data(), sizeof(double), m_row.size(), m_pFile);
+    else
+    {
+        std::fputc('{', m_pFile);
+        for(std::size_t i = 0 ; i < m_row.size() ; ++i)
+        {
+            //JSON has no representation for non finite numbers
+            if(std::isfinite(m_row[i]))
+                std::fprintf(m_pFile, "%s\"%s\":%.17g", i == 0 ? "" : ",", m_columnsName[i].c_str(), m_row[i]);
+            else
+                std::fprintf(m_pFile, "%s\"%s\":null", i == 0 ? "" : ",", m_columnsName[i].c_str());
+        }
+        std::fputs("}\n", m_pFile);
+    }
+
+    //A record is available as soon as the step is done, so that a running simulation can be monitored
+    std::fflush(m_pFile);
+
+    const long size = std::ftell(m_pFile);
+    m_size = (size > 0) ? static_cast<std::uint64_t>(size) : 0;
+}
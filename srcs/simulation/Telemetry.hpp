@@ -0,0 +1,101 @@
+#pragma once
+#ifndef TELEMETRY_HPP_INCLUDED
+#define TELEMETRY_HPP_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "simulation_defines.h"
+
+class Problem;
+
+/**
+ * \class Telemetry
+ * \brief Writes one record per attempted time step (mesh sizes, remeshing activity, resident and per subsystem
+ * memory, convergence of the equations and time spent per category of the profiler regions).
+ *
+ * The columns are fixed for the whole run. In NDJSON mode, each record is a JSON object on its own line,
+ * handed to the OS as soon as it is written. In binary mode, the file starts with the magic "PFEMTLM1",
+ * the uint32 number of columns and the columns name (uint32 length followed by the characters),
+ * followed by fixed size rows of doubles. Binary records are also handed to the OS at each time step.
+ * On restart, the records are appended to the existing file (with the same columns in binary mode), once
+ * the records written after the checkpoint are dropped with resize.
+ */
+class SIMULATION_API Telemetry
+{
+    public:
+        Telemetry()                                 = delete;
+        /**
+         * \param pProblem The problem whose time steps are recorded (its solver should already be built).
+         * \param fileName The file name in which the records will be written.
+         * \param binary Should the records be written as raw doubles instead of NDJSON ?
+         */
+        Telemetry(const Problem* pProblem, const std::string& fileName, bool binary);
+        Telemetry(const Telemetry& telemetry)               = delete;
+        Telemetry& operator=(const Telemetry& telemetry)    = delete;
+        Telemetry(Telemetry&& telemetry)                    = delete;
+        Telemetry& operator=(Telemetry&& telemetry)         = delete;
+        ~Telemetry();
+
+        /// \brief Write the record of the time step which was just attempted.
+        /// \param accepted Did the solver succeed to solve the time step ?
+        /// \param timeStep The time step which was attempted.
+        /// \param startTime The time at which the time step started (see Profiler::now).
+        void record(bool accepted, double timeStep, std::int64_t startTime);
+
+        /// \brief Hand the buffered records to the OS.
+        void flush();
+
+        /// \return The size in bytes of the file, header included.
+        std::uint64_t getSize() const noexcept;
+
+        /// \brief Cut the file back to a previous size (the records written after a checkpoint are dropped on restart).
+        /// \param size The new size in bytes of the file, as returned by getSize (the file is kept if not larger).
+        void resize(std::uint64_t size);
+
+        /// Categories in which the profiler regions time is summed.
+        enum Category : std::size_t
+        {
+            Remeshing = 0,
+            Assembly,
+            LinearSolve,
+            BoundaryConditions,
+            Extraction,
+            CategoriesCount
+        };
+
+        /// \return The category of a profiler region from its name (CategoriesCount if none).
+        static std::size_t getCategory(const std::string& regionName);
+
+        /// \return The name of a category.
+        static std::string getCategoryName(std::size_t category);
+
+    private:
+
+        const Problem* m_pProblem;
+        std::FILE* m_pFile;
+        bool m_binary;
+        std::uint64_t m_size;           /**< Size of the file (the records are handed to the OS as soon as written). */
+
+        std::vector<std::string> m_columnsName;
+        std::vector<double> m_row;
+
+        std::vector<std::size_t> m_regionsCategory;     /**< Category of each profiler region (CategoriesCount if none). */
+        std::array<double, CategoriesCount> m_categoriesTime;   /**< Time of each category at the last record. */
+        std::size_t m_addedNodesCount;                  /**< Nodes added by remeshing at the last record. */
+        std::size_t m_removedNodesCount;                /**< Nodes removed by remeshing at the last record. */
+        std::size_t m_linearIterCount;                  /**< Linear solvers iterations at the last record. */
+
+        /// \return The current time of each category.
+        std::array<double, CategoriesCount> getCategoriesTime();
+
+        /// \return The header of the binary file (empty in NDJSON mode).
+        std::string getHeader() const;
+
+        void writeRow();
+};
+
+#endif // TELEMETRY_HPP_INCLUDED
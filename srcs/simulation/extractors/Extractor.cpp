@@ -21,3 +21,32 @@ void Extractor::update(bool force)
     (void) force;
     throw std::runtime_error("Extractor base class is useless ^^!");
 }
+
+void Extractor::flush()
+{
+}
+
+std::size_t Extractor::getMemoryUsage() const
+{
+    return 0;
+}
+
+std::vector<double> Extractor::getCheckpointData() const
+{
+    return {};
+}
+
+void Extractor::setCheckpointData(const std::vector<double>& data)
+{
+    (void) data;
+}
+
+double Extractor::getNextWriteTrigger() const noexcept
+{
+    return m_nextWriteTrigger;
+}
+
+void Extractor::setNextWriteTrigger(double nextWriteTrigger) noexcept
+{
+    m_nextWriteTrigger = nextWriteTrigger;
+}
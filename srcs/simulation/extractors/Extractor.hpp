@@ -2,11 +2,14 @@
 #ifndef EXTRACTOR_HPP_INCLUDED
 #define EXTRACTOR_HPP_INCLUDED
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "../simulation_defines.h"
 
 class Problem;
+struct WrittableField;
 
 /**
  * \class Extractor
@@ -31,6 +34,25 @@ class SIMULATION_API Extractor
         /// Update the extractor state and write data if necessary
         virtual void update(bool force);
 
+        /// Wait until every data given to the extractor has been written
+        virtual void flush();
+
+        /// \return The memory allocated by the buffers of the extractor, in bytes.
+        virtual std::size_t getMemoryUsage() const;
+
+        /// \return The state of the output files which should be restored on restart (saved in the checkpoints).
+        virtual std::vector<double> getCheckpointData() const;
+
+        /// \brief Restore the state of the output files saved in a checkpoint, so that the extractor appends to them.
+        /// \param data The state returned by getCheckpointData (empty for checkpoints without it).
+        virtual void setCheckpointData(const std::vector<double>& data);
+
+        /// \return The simulation time at which the extractor will write next.
+        double getNextWriteTrigger() const noexcept;
+
+        /// \param nextWriteTrigger The simulation time at which the extractor will write next.
+        void setNextWriteTrigger(double nextWriteTrigger) noexcept;
+
     protected:
         Problem* m_pProblem;
         std::string m_outFileName;
@@ -6,5 +6,8 @@
 #include "MinMaxExtractor.hpp"
 #include "GMSHExtractor.hpp"
 #include "MassExtractor.hpp"
+#include "GlobalExtractor.hpp"
+#include "VTUExtractor.hpp"
+#include "TimeSeriesExtractor.hpp"
 
 #endif // EXTRACTORS_HPP_INCLUDED
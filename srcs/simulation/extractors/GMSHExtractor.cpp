@@ -1,23 +1,31 @@
 #include "GMSHExtractor.hpp"
 
 #include <algorithm>
-#include <map>
 #include <stdexcept>
 #include <utility>
 #include <gmsh.h>
 
 #include "../Problem.hpp"
+#include "../utility/Memory.hpp"
 
 unsigned int GMSHExtractor::m_initialized;
+std::mutex GMSHExtractor::m_gmshMutex;
 
 GMSHExtractor::GMSHExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
-                             const std::vector<std::string>& whatToWrite, std::string writeAs) :
+                             const std::vector<std::string>& whatToWrite, std::string writeAs,
+                             bool asyncWrite, unsigned int maxPendingWrites) :
 Extractor(pProblem, outFileName, timeBetweenWriting),
-m_writeAs(std::move(writeAs))
+m_writeAs(std::move(writeAs)),
+m_asyncWrite(asyncWrite),
+m_writing(false),
+m_stopWriter(false)
 {
     if(!(m_writeAs == "Nodes" || m_writeAs == "Elements" || m_writeAs == "NodesElements"))
         throw std::runtime_error("unknown data type for results writing " + m_writeAs);
 
+    if(m_asyncWrite && maxPendingWrites == 0)
+        throw std::runtime_error("the maximum number of pending writes should be greater than 0!");
+
     std::vector<std::string> writtableData = m_pProblem->getWrittableDataName();
     std::vector<std::string> meshWrittableData = m_pProblem->getMeshWrittableDataName();
 
@@ -31,6 +39,12 @@ m_writeAs(std::move(writeAs))
             throw std::runtime_error("the problem " + m_pProblem->getID() + " cannot write data named " + dataToWrite + " using GMSHExtractor!");
     }
 
+    for(const std::string& dataToWrite : m_whatToWrite)
+        m_fieldsToWrite.push_back(m_pProblem->getWrittableField(dataToWrite));
+
+    for(const std::string& dataToWrite : m_meshToWrite)
+        m_fieldsToWrite.push_back(m_pProblem->getWrittableField(dataToWrite));
+
     if(m_initialized == 0)
     {
         gmsh::initialize();
@@ -42,10 +56,28 @@ m_writeAs(std::move(writeAs))
     }
 
     m_initialized++;
+
+    //One buffer being filled while the others wait to be written
+    const unsigned int snapshotsCount = m_asyncWrite ? maxPendingWrites + 1 : 1;
+    for(unsigned int i = 0 ; i < snapshotsCount ; ++i)
+        m_freeSnapshots.push_back(std::make_unique<Snapshot>());
+
+    if(m_asyncWrite)
+        m_writer = std::thread(&GMSHExtractor::writerLoop, this);
 }
 
 GMSHExtractor::~GMSHExtractor()
 {
+    if(m_writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopWriter = true;
+        }
+        m_cv.notify_all();
+        m_writer.join();
+    }
+
     if(m_initialized == 1)
     {
         gmsh::finalize();
@@ -59,120 +91,227 @@ void GMSHExtractor::update(bool force)
     if(m_pProblem->getCurrentSimTime() < m_nextWriteTrigger && !force)
         return;
 
+    if(m_asyncWrite)
+    {
+        std::unique_ptr<Snapshot> pSnapshot;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]{ return !m_freeSnapshots.empty() || m_writerError; });
+            if(m_writerError)
+            {
+                lock.unlock();
+                rethrowWriterError();
+            }
+
+            pSnapshot = std::move(m_freeSnapshots.back());
+            m_freeSnapshots.pop_back();
+        }
+
+        fillSnapshot(*pSnapshot);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pendingSnapshots.push_back(std::move(pSnapshot));
+        }
+        m_cv.notify_all();
+    }
+    else
+    {
+        fillSnapshot(*m_freeSnapshots[0]);
+        writeSnapshot(*m_freeSnapshots[0]);
+    }
+
+    if(!force)
+        m_nextWriteTrigger += m_timeBetweenWriting;
+}
+
+void GMSHExtractor::flush()
+{
+    if(!m_asyncWrite)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]{ return (m_pendingSnapshots.empty() && !m_writing) || m_writerError; });
+    }
+
+    rethrowWriterError();
+}
+
+std::size_t GMSHExtractor::getMemoryUsage() const
+{
+    auto getSnapshotMemory = [](const Snapshot& snapshot) -> std::size_t
+    {
+        return sizeof(Snapshot) + getMemorySize(snapshot.nodesTags) + getMemorySize(snapshot.nodesCoord) +
+               getMemorySize(snapshot.elementTags) + getMemorySize(snapshot.nodesTagsPerElement) +
+               getMemorySize(snapshot.data);
+    };
+
+    //The snapshot being written and m_nodesData are owned by the writer thread and are not accounted
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::size_t memory = 0;
+    for(const auto& pSnapshot : m_freeSnapshots)
+        memory += getSnapshotMemory(*pSnapshot);
+
+    for(const auto& pSnapshot : m_pendingSnapshots)
+        memory += getSnapshotMemory(*pSnapshot);
+
+    return memory;
+}
+
+void GMSHExtractor::fillSnapshot(Snapshot& snapshot) const
+{
     const Mesh& mesh = m_pProblem->getMesh();
 
-    gmsh::model::add("theModel");
-    gmsh::model::setCurrent("theModel");
-    if(m_writeAs == "Nodes" || m_writeAs == "NodesElements")
-        gmsh::model::addDiscreteEntity(0, 1);
-    if(m_writeAs == "Elements" || m_writeAs == "NodesElements")
-        gmsh::model::addDiscreteEntity(mesh.getDim(), 2);
+    snapshot.dim = mesh.getDim();
+    snapshot.step = static_cast<std::size_t>(m_pProblem->getCurrentSimStep());
+    snapshot.time = m_pProblem->getCurrentSimTime();
 
-    std::vector<std::size_t> nodesTags(mesh.getNodesCount());
-    std::vector<double> nodesCoord(3*mesh.getNodesCount());
+    snapshot.nodesTags.resize(mesh.getNodesCount());
+    snapshot.nodesCoord.resize(3*mesh.getNodesCount());
     #pragma omp parallel for default(shared)
     for(std::size_t n = 0 ; n < mesh.getNodesCount() ; ++n)
     {
         const Node& node = mesh.getNode(n);
-        nodesTags[n] = n + 1;
-        nodesCoord[3*n] = node.getCoordinate(0);
-        nodesCoord[3*n + 1] = node.getCoordinate(1);
+        snapshot.nodesTags[n] = n + 1;
+        snapshot.nodesCoord[3*n] = node.getCoordinate(0);
+        snapshot.nodesCoord[3*n + 1] = node.getCoordinate(1);
         if(mesh.getDim() == 2)
-            nodesCoord[3*n + 2] = 0;
+            snapshot.nodesCoord[3*n + 2] = 0;
         else
-            nodesCoord[3*n + 2] = node.getCoordinate(2);
+            snapshot.nodesCoord[3*n + 2] = node.getCoordinate(2);
     }
 
-    gmsh::model::mesh::addNodes(0, 1, nodesTags, nodesCoord);
-
     if(m_writeAs == "Elements" || m_writeAs == "NodesElements")
     {
-        std::vector<std::size_t> elementTags(mesh.getElementsCount());
-        std::vector<std::size_t> nodesTagsPerElement((mesh.getDim()+1)*mesh.getElementsCount());
+        snapshot.elementTags.resize(mesh.getElementsCount());
+        snapshot.nodesTagsPerElement.resize((mesh.getDim()+1)*mesh.getElementsCount());
         #pragma omp parallel for default(shared)
         for(std::size_t elm = 0 ; elm < mesh.getElementsCount() ; ++elm)
         {
             const Element& element = mesh.getElement(elm);
 
-            elementTags[elm] = elm + 1;
+            snapshot.elementTags[elm] = elm + 1;
             for(std::size_t n = 0 ; n < mesh.getNodesPerElm() ; ++n)
-                nodesTagsPerElement[(mesh.getDim() + 1)*elm + n] = element.getNodeIndex(n) + 1;
+                snapshot.nodesTagsPerElement[(mesh.getDim() + 1)*elm + n] = element.getNodeIndex(n) + 1;
         }
+    }
 
-        if(mesh.getDim() == 2)
-            gmsh::model::mesh::addElementsByType(2, 2, elementTags, nodesTagsPerElement); //Triangle 2
-        else
-            gmsh::model::mesh::addElementsByType(2, 4, elementTags, nodesTagsPerElement); //Tetrahedron 4
+    //The buffers keep their capacity between writes, so the copy only allocates when the mesh grows
+    snapshot.data.resize(m_fieldsToWrite.size());
+    for(std::size_t i = 0 ; i < m_fieldsToWrite.size() ; ++i)
+    {
+        snapshot.data[i].resize(m_fieldsToWrite[i].componentsCount*mesh.getNodesCount());
+        m_pProblem->getWrittableData(m_fieldsToWrite[i], snapshot.data[i].data());
     }
+}
 
-    if(m_writeAs == "Nodes" || m_writeAs == "NodesElements")
-        gmsh::model::mesh::addElementsByType(1, 15, nodesTags, nodesTags);
+void GMSHExtractor::writeSnapshot(const Snapshot& snapshot)
+{
+    std::lock_guard<std::mutex> lock(m_gmshMutex);
 
-    std::map<std::string, std::vector<std::vector<double>>> dataToWritePerNodePerState;
+    gmsh::model::add("theModel");
+    gmsh::model::setCurrent("theModel");
+    if(m_writeAs == "Nodes" || m_writeAs == "NodesElements")
+        gmsh::model::addDiscreteEntity(0, 1);
+    if(m_writeAs == "Elements" || m_writeAs == "NodesElements")
+        gmsh::model::addDiscreteEntity(snapshot.dim, 2);
 
-    std::size_t counter = 1;
+    gmsh::model::mesh::addNodes(0, 1, snapshot.nodesTags, snapshot.nodesCoord);
 
-    for(std::string toWrite : m_whatToWrite)
+    if(m_writeAs == "Elements" || m_writeAs == "NodesElements")
     {
-        gmsh::view::add(toWrite, counter);
+        if(snapshot.dim == 2)
+            gmsh::model::mesh::addElementsByType(2, 2, snapshot.elementTags, snapshot.nodesTagsPerElement); //Triangle 2
+        else
+            gmsh::model::mesh::addElementsByType(2, 4, snapshot.elementTags, snapshot.nodesTagsPerElement); //Tetrahedron 4
+    }
 
-        dataToWritePerNodePerState[toWrite] = std::vector<std::vector<double>>(mesh.getNodesCount());
+    if(m_writeAs == "Nodes" || m_writeAs == "NodesElements")
+        gmsh::model::mesh::addElementsByType(1, 15, snapshot.nodesTags, snapshot.nodesTags);
+
+    const std::string baseName = m_outFileName.substr(0, m_outFileName.find(".msh"));
 
+    std::size_t counter = 1;
+    for(const std::string& toWrite : m_whatToWrite)
+    {
+        gmsh::view::add(toWrite, static_cast<int>(counter));
         counter++;
     }
 
-    for(std::string toWrite : m_meshToWrite)
+    for(const std::string& toWrite : m_meshToWrite)
     {
-        gmsh::view::add(toWrite, counter);
-
-        dataToWritePerNodePerState[toWrite] = std::vector<std::vector<double>>(mesh.getNodesCount());
-
+        gmsh::view::add(toWrite, static_cast<int>(counter));
         counter++;
     }
 
-    #pragma omp parallel for default(shared)
-    for(std::size_t n = 0 ; n < mesh.getNodesCount() ; ++n)
+    for(std::size_t i = 0 ; i < snapshot.data.size() ; ++i)
     {
-        for(std::string toWrite : m_whatToWrite)
-        {
-            std::vector<double> dataToWrite = m_pProblem->getWrittableData(toWrite, n);
-            dataToWritePerNodePerState[toWrite][n] = dataToWrite;
-        }
-
-        for(std::string toWrite : m_meshToWrite)
-        {
-            std::vector<double> dataToWrite = m_pProblem->getMeshWrittableData(toWrite, n);
-            dataToWritePerNodePerState[toWrite][n] = dataToWrite;
-        }
+        //gmsh::view::addModelData expects one vector per node
+        const std::size_t stride = m_fieldsToWrite[i].componentsCount;
+        m_nodesData.resize(snapshot.nodesTags.size());
+        for(std::size_t n = 0 ; n < m_nodesData.size() ; ++n)
+            m_nodesData[n].assign(snapshot.data[i].begin() + static_cast<std::ptrdiff_t>(stride*n),
+                                  snapshot.data[i].begin() + static_cast<std::ptrdiff_t>(stride*(n + 1)));
+
+        const int tag = static_cast<int>(i + 1);
+        gmsh::view::addModelData(tag, static_cast<int>(snapshot.step), "theModel", "NodeData", snapshot.nodesTags,
+                                 m_nodesData, snapshot.time, static_cast<int>(stride));
+
+        gmsh::view::write(tag, baseName + "_" + std::to_string(snapshot.time) + ".msh" , true);
     }
 
-    const std::string baseName = m_outFileName.substr(0, m_outFileName.find(".msh"));
+    gmsh::model::remove();
+}
 
-    counter = 1;
-    for(std::string toWrite : m_whatToWrite)
+void GMSHExtractor::writerLoop()
+{
+    while(true)
     {
-        gmsh::view::addModelData(counter, m_pProblem->getCurrentSimStep(), "theModel", "NodeData", nodesTags,
-                                 dataToWritePerNodePerState[toWrite], m_pProblem->getCurrentSimTime(),
-                                 dataToWritePerNodePerState[toWrite][0].size());
+        std::unique_ptr<Snapshot> pSnapshot;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]{ return m_stopWriter || !m_pendingSnapshots.empty(); });
 
-        gmsh::view::write(counter, baseName + "_" + std::to_string(m_pProblem->getCurrentSimTime()) + ".msh" , true);
+            //Stop only once every pending snapshot is written
+            if(m_pendingSnapshots.empty())
+                return;
 
-        counter++;
-    }
-
-    for(std::string toWrite : m_meshToWrite)
-    {
-        gmsh::view::addModelData(counter, m_pProblem->getCurrentSimStep(), "theModel", "NodeData", nodesTags,
-                                 dataToWritePerNodePerState[toWrite], m_pProblem->getCurrentSimTime(),
-                                 dataToWritePerNodePerState[toWrite][0].size());
+            pSnapshot = std::move(m_pendingSnapshots.front());
+            m_pendingSnapshots.pop_front();
+            m_writing = true;
+        }
 
-        gmsh::view::write(counter, baseName + "_" + std::to_string(m_pProblem->getCurrentSimTime()) + ".msh" , true);
+        std::exception_ptr error;
+        try
+        {
+            writeSnapshot(*pSnapshot);
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
 
-        counter++;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_writing = false;
+            if(error && !m_writerError)
+                m_writerError = error;
+            m_freeSnapshots.push_back(std::move(pSnapshot));
+        }
+        m_cv.notify_all();
     }
+}
 
-    gmsh::model::remove();
+void GMSHExtractor::rethrowWriterError()
+{
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(error, m_writerError);
+    }
 
-    if(!force)
-        m_nextWriteTrigger += m_timeBetweenWriting;
+    if(error)
+        std::rethrow_exception(error);
 }
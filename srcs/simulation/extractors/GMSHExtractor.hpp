@@ -2,6 +2,12 @@
 #ifndef GMSHEXTRACTOR_HPP_INCLUDED
 #define GMSHEXTRACTOR_HPP_INCLUDED
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "Extractor.hpp"
@@ -9,6 +15,10 @@
 /**
  * \class GMSHExtractor
  * \brief Extractor to save data inside gmsh files.
+ *
+ * When the writing is asynchronous, update() only copies the mesh and the requested data into
+ * a snapshot which is written by a background thread. At most maxPendingWrites snapshots can
+ * wait to be written, update() blocks if the writer thread is that late.
  */
 class SIMULATION_API GMSHExtractor : public Extractor
 {
@@ -20,9 +30,12 @@ class SIMULATION_API GMSHExtractor : public Extractor
          * \param timeBetweenWriting The simulation time between each write.
          * \param whatToWrite A vector containing the name of which data to write.
          * \param writeAs Hot to save the data. Can be "Nodes", "Elements" or "NodesElements".
+         * \param asyncWrite Should the files be written by a background thread ?
+         * \param maxPendingWrites The maximum number of snapshots waiting to be written.
          */
         GMSHExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
-                      const std::vector<std::string>& whatToWrite, std::string writeAs);
+                      const std::vector<std::string>& whatToWrite, std::string writeAs,
+                      bool asyncWrite = true, unsigned int maxPendingWrites = 2);
         GMSHExtractor(const GMSHExtractor& gmshExtractor)            = delete;
         GMSHExtractor& operator=(const GMSHExtractor& gmshExtractor) = delete;
         GMSHExtractor(GMSHExtractor&& gmshExtractor)                 = delete;
@@ -32,12 +45,51 @@ class SIMULATION_API GMSHExtractor : public Extractor
         /// Update the extractor state and write data if necessary
         void update(bool force) override;
 
+        /// Wait until every pending snapshot has been written
+        void flush() override;
+
+        std::size_t getMemoryUsage() const override;
+
     private:
+        /**
+         * \struct Snapshot
+         * \brief Copy of everything needed to write one time step.
+         */
+        struct Snapshot
+        {
+            unsigned short dim;
+            std::size_t step;
+            double time;
+            std::vector<std::size_t> nodesTags;
+            std::vector<double> nodesCoord;
+            std::vector<std::size_t> elementTags;
+            std::vector<std::size_t> nodesTagsPerElement;
+            std::vector<std::vector<double>> data;  /**< Per written field, the values of the nodes one after the other. */
+        };
+
         std::vector<std::string> m_whatToWrite;
         std::vector<std::string> m_meshToWrite;
+        std::vector<WrittableField> m_fieldsToWrite;    /**< Fields of m_whatToWrite then m_meshToWrite, resolved once. */
         std::string m_writeAs;
 
+        bool m_asyncWrite;
+        std::vector<std::unique_ptr<Snapshot>> m_freeSnapshots;     /**< Buffers ready to be filled. */
+        std::deque<std::unique_ptr<Snapshot>> m_pendingSnapshots;   /**< Buffers waiting to be written. */
+        bool m_writing;             /**< Is the writer thread currently writing a snapshot ? */
+        bool m_stopWriter;
+        std::exception_ptr m_writerError;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::thread m_writer;
+        std::vector<std::vector<double>> m_nodesData;   /**< Per node values of the field being written, only used by writeSnapshot. */
+
         static unsigned int m_initialized;
+        static std::mutex m_gmshMutex;   /**< The gmsh API is not thread-safe. */
+
+        void fillSnapshot(Snapshot& snapshot) const;
+        void writeSnapshot(const Snapshot& snapshot);
+        void writerLoop();
+        void rethrowWriterError();
 };
 
 #endif // GMSHEXTRACTOR_HPP_INCLUDED
@@ -0,0 +1,58 @@
+#include "GlobalExtractor.hpp"
+
+#include <algorithm>
+
+#include "../Problem.hpp"
+
+
+GlobalExtractor::GlobalExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
+                                 const std::vector<std::string>& whatToWrite, bool binary) :
+Extractor(pProblem, outFileName, timeBetweenWriting),
+m_sink(outFileName, binary, pProblem->isRestarted()),
+m_whatToWrite(whatToWrite)
+{
+    std::vector<std::string> globalData = m_pProblem->getGlobalWrittableDataName();
+
+    for(const std::string& dataToWrite : m_whatToWrite)
+    {
+        if(std::find(globalData.begin(), globalData.end(), dataToWrite) == globalData.end())
+            throw std::runtime_error("the problem " + m_pProblem->getID() + " cannot write global data named " + dataToWrite + "!");
+    }
+}
+
+GlobalExtractor::~GlobalExtractor()
+{
+}
+
+void GlobalExtractor::update(bool force)
+{
+    if(m_pProblem->getCurrentSimTime() < m_nextWriteTrigger && !force)
+        return;
+
+    m_sink.writeRow(m_pProblem->getCurrentSimTime(), m_pProblem->computeGlobalWrittableData(m_whatToWrite));
+
+    if(!force)
+        m_nextWriteTrigger += m_timeBetweenWriting;
+}
+
+void GlobalExtractor::flush()
+{
+    m_sink.sync();
+}
+
+std::size_t GlobalExtractor::getMemoryUsage() const
+{
+    return m_sink.getMemoryUsage();
+}
+
+std::vector<double> GlobalExtractor::getCheckpointData() const
+{
+    return {static_cast<double>(m_sink.getSize())};
+}
+
+void GlobalExtractor::setCheckpointData(const std::vector<double>& data)
+{
+    //The rows written after the checkpoint are written again
+    if(!data.empty())
+        m_sink.resize(static_cast<std::uint64_t>(data[0]));
+}
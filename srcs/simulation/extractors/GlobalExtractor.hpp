@@ -0,0 +1,48 @@
+#pragma once
+#ifndef GLOBALEXTRACTOR_HPP_INCLUDED
+#define GLOBALEXTRACTOR_HPP_INCLUDED
+
+#include <vector>
+
+#include "Extractor.hpp"
+#include "ScalarSink.hpp"
+
+/**
+ * \class GlobalExtractor
+ * \brief Extractor writing several global data (mass, kinetic energy, center of mass, ...) on one line per write.
+ */
+class SIMULATION_API GlobalExtractor : public Extractor
+{
+    public:
+        GlobalExtractor()                                                = delete;
+        /**
+         * \param pProblem A pointer to the problem from which data will be extracted.
+         * \param outFileName The file name in which data will be written.
+         * \param timeBetweenWriting The simulation time between each write.
+         * \param whatToWrite A vector containing the name of which global data to write.
+         * \param binary Should the data be written as raw doubles instead of text ?
+         */
+        GlobalExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
+                        const std::vector<std::string>& whatToWrite, bool binary = false);
+        GlobalExtractor(const GlobalExtractor& globalExtractor)            = delete;
+        GlobalExtractor& operator=(const GlobalExtractor& globalExtractor) = delete;
+        GlobalExtractor(GlobalExtractor&& globalExtractor)                 = delete;
+        GlobalExtractor& operator=(GlobalExtractor&& globalExtractor)      = delete;
+        ~GlobalExtractor() override;
+
+        void update(bool force) override;
+
+        /// Write the buffered rows to the disk
+        void flush() override;
+
+        std::size_t getMemoryUsage() const override;
+
+        std::vector<double> getCheckpointData() const override;
+        void setCheckpointData(const std::vector<double>& data) override;
+
+    private:
+        ScalarSink m_sink;
+        std::vector<std::string> m_whatToWrite;
+};
+
+#endif // GLOBALEXTRACTOR_HPP_INCLUDED
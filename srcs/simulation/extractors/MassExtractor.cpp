@@ -5,13 +5,10 @@
 #include "../Problem.hpp"
 
 
-MassExtractor::MassExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting) :
-Extractor(pProblem, outFileName, timeBetweenWriting)
+MassExtractor::MassExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting, bool binary) :
+Extractor(pProblem, outFileName, timeBetweenWriting),
+m_sink(outFileName, binary, pProblem->isRestarted())
 {
-    m_outFile.open(m_outFileName);
-    if(!m_outFile.is_open())
-        throw std::runtime_error("cannot open file to write point extractor: " + m_outFileName);
-
     std::vector<std::string> globalData = m_pProblem->getGlobalWrittableDataName();
 
     if(std::find(globalData.begin(), globalData.end(), std::string("mass")) == globalData.end())
@@ -20,7 +17,6 @@ Extractor(pProblem, outFileName, timeBetweenWriting)
 
 MassExtractor::~MassExtractor()
 {
-    m_outFile.close();
 }
 
 void MassExtractor::update(bool force)
@@ -30,8 +26,30 @@ void MassExtractor::update(bool force)
 
     double valueToWrite = m_pProblem->getGlobalWrittableData(std::string("mass"));
 
-    m_outFile << std::to_string(m_pProblem->getCurrentSimTime()) << "," << std::to_string(valueToWrite) << std::endl;
+    m_sink.writeRow(m_pProblem->getCurrentSimTime(), {valueToWrite});
 
     if(!force)
         m_nextWriteTrigger += m_timeBetweenWriting;
 }
+
+void MassExtractor::flush()
+{
+    m_sink.sync();
+}
+
+std::size_t MassExtractor::getMemoryUsage() const
+{
+    return m_sink.getMemoryUsage();
+}
+
+std::vector<double> MassExtractor::getCheckpointData() const
+{
+    return {static_cast<double>(m_sink.getSize())};
+}
+
+void MassExtractor::setCheckpointData(const std::vector<double>& data)
+{
+    //The rows written after the checkpoint are written again
+    if(!data.empty())
+        m_sink.resize(static_cast<std::uint64_t>(data[0]));
+}
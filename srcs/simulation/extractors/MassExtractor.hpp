@@ -2,15 +2,14 @@
 #ifndef MASSEXTRACTOR_HPP_INCLUDED
 #define MASSEXTRACTOR_HPP_INCLUDED
 
-#include <fstream>
-
 #include "Extractor.hpp"
+#include "ScalarSink.hpp"
 
 class SIMULATION_API MassExtractor : public Extractor
 {
     public:
         MassExtractor()                                              = delete;
-        MassExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting);
+        MassExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting, bool binary = false);
         MassExtractor(const MassExtractor& massExtractor)            = delete;
         MassExtractor& operator=(const MassExtractor& massExtractor) = delete;
         MassExtractor(MassExtractor&& massExtractor)                 = delete;
@@ -19,8 +18,16 @@ class SIMULATION_API MassExtractor : public Extractor
 
         void update(bool force) override;
 
+        /// Write the buffered rows to the disk
+        void flush() override;
+
+        std::size_t getMemoryUsage() const override;
+
+        std::vector<double> getCheckpointData() const override;
+        void setCheckpointData(const std::vector<double>& data) override;
+
     private:
-        std::ofstream m_outFile;
+        ScalarSink m_sink;
 };
 
 #endif // MASSEXTRACTOR_HPP_INCLUDED
@@ -1,11 +1,15 @@
 #include "MinMaxExtractor.hpp"
 
+#include <limits>
+
 #include "../Problem.hpp"
+#include "../utility/Reduction.hpp"
 
 
 MinMaxExtractor::MinMaxExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
-                                 unsigned short coordinate, const std::string& minMax) :
+                                 unsigned short coordinate, const std::string& minMax, bool binary) :
 Extractor(pProblem, outFileName, timeBetweenWriting),
+m_sink(outFileName, binary, pProblem->isRestarted()),
 m_coordinate(coordinate),
 m_minMax(minMax)
 {
@@ -14,15 +18,10 @@ m_minMax(minMax)
 
     if(m_minMax != "min" && m_minMax != "max")
         throw std::runtime_error("unknown data to compute for MinMaxExtractor.");
-
-    m_outFile.open(m_outFileName);
-    if(!m_outFile.is_open())
-        throw std::runtime_error("cannot open file to write point extractor: " + m_outFileName);
 }
 
 MinMaxExtractor::~MinMaxExtractor()
 {
-    m_outFile.close();
 }
 
 void MinMaxExtractor::update(bool force)
@@ -36,27 +35,43 @@ void MinMaxExtractor::update(bool force)
 
     if(m_minMax == "min")
     {
-        valueToWrite = std::numeric_limits<double>::max();
-        for(std::size_t n = 0 ; n < mesh.getNodesCount() ; ++n)
-        {
+        valueToWrite = parallelMin(mesh.getNodesCount(), [&](std::size_t n){
             const Node& node = mesh.getNode(n);
-            if(!node.isBound() && !node.isFree())
-                valueToWrite = std::min(valueToWrite, node.getCoordinate(m_coordinate));
-        }
+            return (!node.isBound() && !node.isFree()) ? node.getCoordinate(m_coordinate) : std::numeric_limits<double>::max();
+        });
     }
     else
     {
-        valueToWrite = 0;
-        for(std::size_t n = 0 ; n < mesh.getNodesCount() ; ++n)
-        {
+        valueToWrite = parallelMax(mesh.getNodesCount(), [&](std::size_t n){
             const Node& node = mesh.getNode(n);
-            if(!node.isBound() && !node.isFree())
-                valueToWrite = std::max(valueToWrite, node.getCoordinate(m_coordinate));
-        }
+            return (!node.isBound() && !node.isFree()) ? node.getCoordinate(m_coordinate) : std::numeric_limits<double>::lowest();
+        });
     }
 
-    m_outFile << std::to_string(m_pProblem->getCurrentSimTime()) << "," << std::to_string(valueToWrite) << std::endl;
+    m_sink.writeRow(m_pProblem->getCurrentSimTime(), {valueToWrite});
 
     if(!force)
         m_nextWriteTrigger += m_timeBetweenWriting;
 }
+
+void MinMaxExtractor::flush()
+{
+    m_sink.sync();
+}
+
+std::size_t MinMaxExtractor::getMemoryUsage() const
+{
+    return m_sink.getMemoryUsage();
+}
+
+std::vector<double> MinMaxExtractor::getCheckpointData() const
+{
+    return {static_cast<double>(m_sink.getSize())};
+}
+
+void MinMaxExtractor::setCheckpointData(const std::vector<double>& data)
+{
+    //The rows written after the checkpoint are written again
+    if(!data.empty())
+        m_sink.resize(static_cast<std::uint64_t>(data[0]));
+}
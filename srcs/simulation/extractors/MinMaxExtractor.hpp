@@ -2,16 +2,15 @@
 #ifndef MINMAXEXTRACTOR_HPP_INCLUDED
 #define MINMAXEXTRACTOR_HPP_INCLUDED
 
-#include <fstream>
-
 #include "Extractor.hpp"
+#include "ScalarSink.hpp"
 
 class SIMULATION_API MinMaxExtractor : public Extractor
 {
     public:
         MinMaxExtractor()                                                  = delete;
         MinMaxExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
-                        unsigned short coordinate, const std::string& minMax);
+                        unsigned short coordinate, const std::string& minMax, bool binary = false);
         MinMaxExtractor(const MinMaxExtractor& minmaxExtractor)            = delete;
         MinMaxExtractor& operator=(const MinMaxExtractor& minmaxExtractor) = delete;
         MinMaxExtractor(MinMaxExtractor&& minmaxExtractor)                 = delete;
@@ -20,8 +19,16 @@ class SIMULATION_API MinMaxExtractor : public Extractor
 
         void update(bool force) override;
 
+        /// Write the buffered rows to the disk
+        void flush() override;
+
+        std::size_t getMemoryUsage() const override;
+
+        std::vector<double> getCheckpointData() const override;
+        void setCheckpointData(const std::vector<double>& data) override;
+
     private:
-        std::ofstream m_outFile;
+        ScalarSink m_sink;
         unsigned short m_coordinate;
         std::string m_minMax;
 };
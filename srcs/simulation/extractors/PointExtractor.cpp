@@ -1,33 +1,45 @@
 #include "PointExtractor.hpp"
 
-#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include "../Problem.hpp"
+#include "../utility/Memory.hpp"
 
 
 PointExtractor::PointExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
-                               std::string whatToWrite, const std::vector<std::vector<double>>& points) :
+                               std::string whatToWrite, const std::vector<std::vector<double>>& points, bool binary) :
 Extractor(pProblem, outFileName, timeBetweenWriting),
-m_points(points)
+m_sink(outFileName, binary, pProblem->isRestarted()),
+m_field(),
+m_points(points),
+m_elementIndexes(points.size(), std::numeric_limits<std::size_t>::max()),
+m_isGridBuilt(false),
+m_gridMin({0, 0, 0}),
+m_gridCellSize({1, 1, 1}),
+m_gridCellsCount({1, 1, 1})
 {
-    m_outFile.open(m_outFileName);
-    if(!m_outFile.is_open())
-        throw std::runtime_error("cannot open file to write point extractor: " + m_outFileName);
-
     std::vector<std::string> writtableData = m_pProblem->getWrittableDataName();
 
     if(std::find(writtableData.begin(), writtableData.end(), whatToWrite) == writtableData.end())
         throw std::runtime_error("the problem named " + m_pProblem->getID() + " cannot write data named " + whatToWrite + "!");
 
-    if(m_pProblem->getWrittableData(whatToWrite, 0).size() != 1)
+    m_field = m_pProblem->getWrittableField(whatToWrite);
+    if(m_field.componentsCount != 1)
         throw std::runtime_error("PointExtractor is currently only able to extract scalars!");
 
     m_whatToWrite = whatToWrite;
+
+    for(auto& point : m_points)
+    {
+        if(point.size() < m_pProblem->getMesh().getDim())
+            throw std::runtime_error("a point of the point extractor " + m_outFileName + " does not have enough coordinates!");
+    }
 }
 
 PointExtractor::~PointExtractor()
 {
-    m_outFile.close();
 }
 
 void PointExtractor::update(bool force)
@@ -37,200 +49,273 @@ void PointExtractor::update(bool force)
 
     const Mesh& mesh = m_pProblem->getMesh();
 
-    m_outFile << std::to_string(m_pProblem->getCurrentSimTime());
+    //The nodes moved (and the mesh may have been rebuilt) since the last write
+    m_isGridBuilt = false;
 
-    for(auto& point : m_points)
+    m_row.clear();
+
+    for(std::size_t i = 0 ; i < m_points.size() ; ++i)
     {
-        std::size_t elm;
-        bool isFound = findElementIndex(mesh, elm, point);
+        const std::vector<double>& point = m_points[i];
 
-        const Element& element = mesh.getElement(elm);
+        std::array<double, 4> lambda;
+        bool isFound = findElementIndex(mesh, m_elementIndexes[i], point, lambda);
 
-        double valueToWrite;
-        if(!isFound)
-           valueToWrite = 0;
-        else
+        double valueToWrite = 0;
+        if(isFound)
         {
-            Eigen::MatrixXd A(mesh.getDim() + 1, mesh.getDim() + 1);
-            Eigen::VectorXd b(mesh.getDim() + 1);
-            if(mesh.getDim() == 2)
-            {
-                const Node& n0 = mesh.getNode(element.getNodeIndex(0));
-                const Node& n1 = mesh.getNode(element.getNodeIndex(1));
-                const Node& n2 = mesh.getNode(element.getNodeIndex(2));
-
-                A << n0.getCoordinate(0), n0.getCoordinate(1), 1,
-                     n1.getCoordinate(0), n1.getCoordinate(1), 1,
-                     n2.getCoordinate(0), n2.getCoordinate(1), 1;
-
-                b << m_pProblem->getWrittableData(m_whatToWrite, element.getNodeIndex(0))[0],
-                     m_pProblem->getWrittableData(m_whatToWrite, element.getNodeIndex(1))[0],
-                     m_pProblem->getWrittableData(m_whatToWrite, element.getNodeIndex(2))[0];
-            }
-            else
+            const Element& element = mesh.getElement(m_elementIndexes[i]);
+            for(unsigned short n = 0 ; n < mesh.getNodesPerElm() ; ++n)
             {
-                const Node& n0 = mesh.getNode(element.getNodeIndex(0));
-                const Node& n1 = mesh.getNode(element.getNodeIndex(1));
-                const Node& n2 = mesh.getNode(element.getNodeIndex(2));
-                const Node& n3 = mesh.getNode(element.getNodeIndex(3));
-
-                A << n0.getCoordinate(0), n0.getCoordinate(1), n0.getCoordinate(2), 1,
-                     n1.getCoordinate(0), n1.getCoordinate(1), n1.getCoordinate(2), 1,
-                     n2.getCoordinate(0), n2.getCoordinate(1), n2.getCoordinate(2), 1,
-                     n3.getCoordinate(0), n3.getCoordinate(1), n3.getCoordinate(2), 1;
-
-                b << m_pProblem->getWrittableData(m_whatToWrite, element.getNodeIndex(0))[0],
-                     m_pProblem->getWrittableData(m_whatToWrite, element.getNodeIndex(1))[0],
-                     m_pProblem->getWrittableData(m_whatToWrite, element.getNodeIndex(2))[0],
-                     m_pProblem->getWrittableData(m_whatToWrite, element.getNodeIndex(3))[0];
+                double nodeValue;
+                m_pProblem->getWrittableData(m_field, element.getNodeIndex(n), &nodeValue);
+                valueToWrite += lambda[n]*nodeValue;
             }
-
-            Eigen::VectorXd sol = A.completeOrthogonalDecomposition().solve(b);
-
-            valueToWrite = 0;
-            for(unsigned short d = 0 ; d < mesh.getDim() ; ++d)
-                valueToWrite += sol(d)*point[d];
-
-            valueToWrite += sol(mesh.getDim());
         }
-        if(mesh.getDim() == 2)
-            m_outFile << "," << std::to_string(point[0]) << "," << std::to_string(point[1]) << "," << std::to_string(valueToWrite);
-        else
-            m_outFile << "," << std::to_string(point[0]) << "," << std::to_string(point[1]) << "," << std::to_string(point[2]) << "," << std::to_string(valueToWrite);
+
+        m_row.insert(m_row.end(), point.begin(), point.begin() + mesh.getDim());
+        m_row.push_back(valueToWrite);
     }
 
-    m_outFile << std::endl;
+    m_sink.writeRow(m_pProblem->getCurrentSimTime(), m_row);
 
     if(!force)
         m_nextWriteTrigger += m_timeBetweenWriting;
 }
 
-bool PointExtractor::findElementIndex(const Mesh& mesh, std::size_t& elementIndex, const std::vector<double>& point)
+void PointExtractor::flush()
 {
-    for(std::size_t elm = 0 ; elm < mesh.getElementsCount() ; ++elm)
-    {
-        const Element& element = mesh.getElement(elm);
-        std::vector<double> baryCenter(mesh.getDim(), 0);
+    m_sink.sync();
+}
 
-        for(unsigned int n = 0 ; n < mesh.getNodesPerElm() ; ++n)
-        {
-            const Node& node = mesh.getNode(element.getNodeIndex(n));
-            for(unsigned int d = 0 ; d < mesh.getDim() ; ++d)
-            {
-                baryCenter[d] += node.getCoordinate(d);
-            }
-        }
+std::size_t PointExtractor::getMemoryUsage() const
+{
+    return m_sink.getMemoryUsage() + getMemorySize(m_points) + getMemorySize(m_row) + getMemorySize(m_elementIndexes) +
+           getMemorySize(m_gridCellsStart) + getMemorySize(m_gridElements);
+}
 
-        for(unsigned int d = 0 ; d < mesh.getDim() ; ++d)
+bool PointExtractor::findElementIndex(const Mesh& mesh, std::size_t& elementIndex, const std::vector<double>& point,
+                                      std::array<double, 4>& lambda)
+{
+    const std::size_t elementsCount = mesh.getElementsCount();
+    if(elementsCount == 0)
+        return false;
+
+    //The nodes only moved of a few time steps since the last write: walk from the previous element
+    //towards the point, crossing the face opposite to the most negative barycentric coordinate
+    const unsigned int maxWalkSteps = 64;
+    if(elementIndex < elementsCount)
+    {
+        for(unsigned int step = 0 ; step < maxWalkSteps ; ++step)
         {
-            baryCenter[d] /= static_cast<double>(mesh.getNodesPerElm());
+            if(computeBarycentric(mesh, elementIndex, point, lambda))
+                return true;
+
+            const unsigned short nodeElmIndex = static_cast<unsigned short>(
+                std::min_element(lambda.begin(), lambda.begin() + mesh.getNodesPerElm()) - lambda.begin());
+
+            const std::size_t next = getFaceNeighbour(mesh, elementIndex, nodeElmIndex);
+            if(next == elementsCount)
+                break;
+
+            elementIndex = next;
         }
+    }
 
-        unsigned short ok = 0;
+    if(!m_isGridBuilt)
+        buildGrid(mesh);
 
-        std::vector<double> normal(mesh.getDim());
-        std::vector<double> vMiddleToBary(mesh.getDim());
-        std::vector<double> vPointToVertex(mesh.getDim());
+    std::size_t cellIndex = 0;
+    for(unsigned short d = mesh.getDim() ; d-- > 0 ;)
+    {
+        const double coord = (point[d] - m_gridMin[d])/m_gridCellSize[d];
+        if(coord < 0 || coord > static_cast<double>(m_gridCellsCount[d]))
+            return false;
 
-        if(mesh.getDim() == 2)
+        const std::size_t cell = std::min(static_cast<std::size_t>(coord), m_gridCellsCount[d] - 1);
+        cellIndex = cellIndex*m_gridCellsCount[d] + cell;
+    }
+
+    for(std::size_t i = m_gridCellsStart[cellIndex] ; i < m_gridCellsStart[cellIndex + 1] ; ++i)
+    {
+        if(computeBarycentric(mesh, m_gridElements[i], point, lambda))
         {
-            for(unsigned short i = 0 ; i < mesh.getDim() + 1 ; ++i)
-            {
-                unsigned short j = i + 1;
-                if(i == mesh.getDim())
-                    j = 0;
+            elementIndex = m_gridElements[i];
+            return true;
+        }
+    }
 
-                const Node& ni = mesh.getNode(element.getNodeIndex(i));
-                const Node& nj = mesh.getNode(element.getNodeIndex(j));
+    return false;
+}
 
-                normal[0] = nj.getCoordinate(1) - ni.getCoordinate(1);
-                normal[1] = - nj.getCoordinate(0) + ni.getCoordinate(0);
+bool PointExtractor::computeBarycentric(const Mesh& mesh, std::size_t elementIndex, const std::vector<double>& point,
+                                        std::array<double, 4>& lambda) const
+{
+    const Element& element = mesh.getElement(elementIndex);
+    const Node& n0 = mesh.getNode(element.getNodeIndex(0));
+    const unsigned short dim = mesh.getDim();
 
-                vMiddleToBary[0] = baryCenter[0] - 0.5*(ni.getCoordinate(0) + nj.getCoordinate(0));
-                vMiddleToBary[1] = baryCenter[1] - 0.5*(ni.getCoordinate(1) + nj.getCoordinate(1));
+    //Reference coordinates xi = invJ*(x - x0) are the barycentric coordinates of the nodes 1 to dim
+    lambda = {1, 0, 0, 0};
+    for(unsigned short i = 0 ; i < dim ; ++i)
+    {
+        double xi = 0;
+        for(unsigned short j = 0 ; j < dim ; ++j)
+            xi += element.getInvJ(i, j)*(point[j] - n0.getCoordinate(j));
 
-                if((normal[0]*vMiddleToBary[0] + normal[1]*vMiddleToBary[1]) > 0)
-                {
-                    normal[0] *= -1;
-                    normal[1] *= -1;
-                }
+        lambda[i + 1] = xi;
+        lambda[0] -= xi;
+    }
 
-                vPointToVertex[0] = point[0] - ni.getCoordinate(0);
-                vPointToVertex[1] = point[1] - ni.getCoordinate(1);
+    const double tolerance = 1e-10;
+    for(unsigned short n = 0 ; n <= dim ; ++n)
+    {
+        if(lambda[n] < -tolerance)
+            return false;
+    }
 
-                if((normal[0]*vPointToVertex[0] + normal[1]*vPointToVertex[1]) > 0)
-                    break;
-                else
-                    ok++;
-            }
+    return true;
+}
 
-            if(ok == 3)
-            {
-                elementIndex = elm;
-                return true;
-            }
-        }
-        else
+std::size_t PointExtractor::getFaceNeighbour(const Mesh& mesh, std::size_t elementIndex, unsigned short nodeElmIndex) const
+{
+    const Element& element = mesh.getElement(elementIndex);
+
+    for(unsigned int i = 0 ; i < element.getNeighbourElementsCount() ; ++i)
+    {
+        const std::size_t neighbourIndex = element.getNeighbourElmIndex(i);
+        const Element& neighbour = mesh.getElement(neighbourIndex);
+
+        unsigned short sharedNodes = 0;
+        for(unsigned short k = 0 ; k < mesh.getNodesPerElm() ; ++k)
         {
-            for(unsigned short i = 0 ; i < mesh.getDim() + 1 ; ++i)
+            if(k == nodeElmIndex)
+                continue;
+
+            for(unsigned short l = 0 ; l < mesh.getNodesPerElm() ; ++l)
             {
-                unsigned short j = i + 1;
-                unsigned short k = i + 2;
-                if(i == mesh.getDim() - 1)
-                    k = 0;
-                else if(i == mesh.getDim())
+                if(neighbour.getNodeIndex(l) == element.getNodeIndex(k))
                 {
-                    j = 0;
-                    k = 1;
+                    sharedNodes++;
+                    break;
                 }
+            }
+        }
 
-                const Node& ni = mesh.getNode(element.getNodeIndex(i));
-                const Node& nj = mesh.getNode(element.getNodeIndex(j));
-                const Node& nk = mesh.getNode(element.getNodeIndex(k));
+        if(sharedNodes == mesh.getDim())
+            return neighbourIndex;
+    }
 
-                normal[0] = ((nj.getCoordinate(1) - ni.getCoordinate(1))
-                             *(nk.getCoordinate(2) - ni.getCoordinate(2)))
-                          - ((nj.getCoordinate(2) - ni.getCoordinate(2))
-                             *(nk.getCoordinate(1) - ni.getCoordinate(1)));
+    return mesh.getElementsCount();
+}
 
-                normal[1] = ((nj.getCoordinate(2) - ni.getCoordinate(2))
-                             *(nk.getCoordinate(0) - ni.getCoordinate(0)))
-                          - ((nj.getCoordinate(0) - ni.getCoordinate(0))
-                             *(nk.getCoordinate(2) - ni.getCoordinate(2)));
+void PointExtractor::buildGrid(const Mesh& mesh)
+{
+    const unsigned short dim = mesh.getDim();
+    const std::size_t elementsCount = mesh.getElementsCount();
 
-                normal[2] = ((nj.getCoordinate(0) - ni.getCoordinate(0))
-                             *(nk.getCoordinate(1) - ni.getCoordinate(1)))
-                          - ((nj.getCoordinate(1) - ni.getCoordinate(1))
-                             *(nk.getCoordinate(0) - ni.getCoordinate(0)));
+    std::array<double, 3> gridMax = {0, 0, 0};
+    for(unsigned short d = 0 ; d < dim ; ++d)
+    {
+        m_gridMin[d] = std::numeric_limits<double>::max();
+        gridMax[d] = std::numeric_limits<double>::lowest();
+    }
 
-                vMiddleToBary[0] = baryCenter[0] - (1.0f/3.0f)*(ni.getCoordinate(0) + nj.getCoordinate(0) + nk.getCoordinate(0));
-                vMiddleToBary[1] = baryCenter[1] - (1.0f/3.0f)*(ni.getCoordinate(1) + nj.getCoordinate(1) + nk.getCoordinate(1));
-                vMiddleToBary[2] = baryCenter[2] - (1.0f/3.0f)*(ni.getCoordinate(2) + nj.getCoordinate(2) + nk.getCoordinate(2));
+    for(std::size_t n = 0 ; n < mesh.getNodesCount() ; ++n)
+    {
+        const Node& node = mesh.getNode(n);
+        for(unsigned short d = 0 ; d < dim ; ++d)
+        {
+            m_gridMin[d] = std::min(m_gridMin[d], node.getCoordinate(d));
+            gridMax[d] = std::max(gridMax[d], node.getCoordinate(d));
+        }
+    }
 
-                if((normal[0]*vMiddleToBary[0] + normal[1]*vMiddleToBary[1] + normal[2]*vMiddleToBary[2]) > 0)
-                {
-                    normal[0] *= -1;
-                    normal[1] *= -1;
-                    normal[2] *= -1;
-                }
+    //About one element per cell
+    double volume = 1;
+    for(unsigned short d = 0 ; d < dim ; ++d)
+        volume *= gridMax[d] - m_gridMin[d];
 
-                vPointToVertex[0] = point[0] - ni.getCoordinate(0);
-                vPointToVertex[1] = point[1] - ni.getCoordinate(1);
-                vPointToVertex[2] = point[2] - ni.getCoordinate(2);
+    double cellSize = std::pow(volume/static_cast<double>(elementsCount), 1.0/dim);
+    if(!(cellSize > 0))
+        cellSize = 1;
 
-                if((normal[0]*vPointToVertex[0] + normal[1]*vPointToVertex[1] + normal[2]*vPointToVertex[2]) > 0)
-                    break;
-                else
-                    ok++;
-            }
+    std::size_t cellsCount = 1;
+    for(unsigned short d = 0 ; d < dim ; ++d)
+    {
+        const double extent = gridMax[d] - m_gridMin[d];
+        m_gridCellsCount[d] = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(extent/cellSize)));
+        m_gridCellSize[d] = (extent > 0) ? extent/static_cast<double>(m_gridCellsCount[d]) : 1;
+        cellsCount *= m_gridCellsCount[d];
+    }
+
+    auto cellCoord = [&](double x, unsigned short d) -> std::size_t {
+        const double coord = std::max(0.0, (x - m_gridMin[d])/m_gridCellSize[d]);
+        return std::min(static_cast<std::size_t>(coord), m_gridCellsCount[d] - 1);
+    };
+
+    //Cells overlapped by the bounding box of each element
+    std::vector<std::array<std::size_t, 6>> elementsCells(elementsCount);
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+    {
+        const Element& element = mesh.getElement(elm);
+        std::array<std::size_t, 6>& cells = elementsCells[elm];
+        for(unsigned short d = 0 ; d < 3 ; ++d)
+        {
+            cells[d] = 0;
+            cells[d + 3] = 0;
+        }
 
-            if(ok == 4)
+        for(unsigned short d = 0 ; d < dim ; ++d)
+        {
+            double minCoord = std::numeric_limits<double>::max();
+            double maxCoord = std::numeric_limits<double>::lowest();
+            for(unsigned short n = 0 ; n < mesh.getNodesPerElm() ; ++n)
             {
-                elementIndex = elm;
-                return true;
+                const double x = mesh.getNode(element.getNodeIndex(n)).getCoordinate(d);
+                minCoord = std::min(minCoord, x);
+                maxCoord = std::max(maxCoord, x);
             }
+
+            cells[d] = cellCoord(minCoord, d);
+            cells[d + 3] = cellCoord(maxCoord, d);
         }
     }
 
-    return false;
+    auto forEachCell = [&](const std::array<std::size_t, 6>& cells, auto&& func) {
+        for(std::size_t k = cells[2] ; k <= cells[5] ; ++k)
+        {
+            for(std::size_t j = cells[1] ; j <= cells[4] ; ++j)
+            {
+                for(std::size_t i = cells[0] ; i <= cells[3] ; ++i)
+                    func(i + m_gridCellsCount[0]*(j + m_gridCellsCount[1]*k));
+            }
+        }
+    };
+
+    m_gridCellsStart.assign(cellsCount + 1, 0);
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+        forEachCell(elementsCells[elm], [&](std::size_t cell){ m_gridCellsStart[cell + 1]++; });
+
+    for(std::size_t cell = 0 ; cell < cellsCount ; ++cell)
+        m_gridCellsStart[cell + 1] += m_gridCellsStart[cell];
+
+    std::vector<std::size_t> cursors(m_gridCellsStart.begin(), m_gridCellsStart.end() - 1);
+    m_gridElements.resize(m_gridCellsStart[cellsCount]);
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+        forEachCell(elementsCells[elm], [&](std::size_t cell){ m_gridElements[cursors[cell]++] = elm; });
+
+    m_isGridBuilt = true;
+}
+
+std::vector<double> PointExtractor::getCheckpointData() const
+{
+    return {static_cast<double>(m_sink.getSize())};
+}
+
+void PointExtractor::setCheckpointData(const std::vector<double>& data)
+{
+    //The rows written after the checkpoint are written again
+    if(!data.empty())
+        m_sink.resize(static_cast<std::uint64_t>(data[0]));
 }
@@ -2,10 +2,12 @@
 #ifndef POINTEXTRACTOR_HPP_INCLUDED
 #define POINTEXTRACTOR_HPP_INCLUDED
 
-#include <fstream>
+#include <array>
 #include <vector>
 
 #include "Extractor.hpp"
+#include "ScalarSink.hpp"
+#include "../Problem.hpp"
 
 class Mesh;
 
@@ -14,7 +16,7 @@ class SIMULATION_API PointExtractor : public Extractor
     public:
         PointExtractor()                                                = delete;
         PointExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
-                       std::string whatToWrite, const std::vector<std::vector<double>>& points);
+                       std::string whatToWrite, const std::vector<std::vector<double>>& points, bool binary = false);
         PointExtractor(const PointExtractor& pointExtractor)            = delete;
         PointExtractor& operator=(const PointExtractor& pointExtractor) = delete;
         PointExtractor(PointExtractor&& pointExtractor)                 = delete;
@@ -23,12 +25,48 @@ class SIMULATION_API PointExtractor : public Extractor
 
         void update(bool force) override;
 
+        /// Write the buffered rows to the disk
+        void flush() override;
+
+        std::size_t getMemoryUsage() const override;
+
+        std::vector<double> getCheckpointData() const override;
+        void setCheckpointData(const std::vector<double>& data) override;
+
     private:
-        std::ofstream m_outFile;
+        ScalarSink m_sink;
         std::string m_whatToWrite;
+        WrittableField m_field;     /**< Field of m_whatToWrite, resolved once. */
         std::vector<std::vector<double>> m_points;
+        std::vector<double> m_row;                  /**< Values written at each update, kept to avoid reallocations. */
+        std::vector<std::size_t> m_elementIndexes;  /**< Element containing each point at the previous write. */
+
+        //Uniform grid over the elements bounding boxes, only built when walking from the previous element fails
+        bool m_isGridBuilt;
+        std::array<double, 3> m_gridMin;
+        std::array<double, 3> m_gridCellSize;
+        std::array<std::size_t, 3> m_gridCellsCount;
+        std::vector<std::size_t> m_gridCellsStart;  /**< Start of each cell inside m_gridElements (CSR layout). */
+        std::vector<std::size_t> m_gridElements;
+
+        /**
+         * \param mesh The mesh in which the point is searched.
+         * \param elementIndex The element from which the search starts, set to the element containing the point.
+         * \param point The point to locate.
+         * \param lambda The barycentric coordinates of the point inside the found element.
+         * \return true if the point is inside the mesh, false otherwise.
+         */
+        bool findElementIndex(const Mesh& mesh, std::size_t& elementIndex, const std::vector<double>& point,
+                              std::array<double, 4>& lambda);
+
+        /// \return true if the point is inside the element, lambda being set to its barycentric coordinates.
+        bool computeBarycentric(const Mesh& mesh, std::size_t elementIndex, const std::vector<double>& point,
+                                std::array<double, 4>& lambda) const;
+
+        /// \return The index of the element sharing the face opposite to the node nodeElmIndex, or the number of elements if there is none.
+        std::size_t getFaceNeighbour(const Mesh& mesh, std::size_t elementIndex, unsigned short nodeElmIndex) const;
 
-        bool findElementIndex(const Mesh& mesh, std::size_t& elementIndex, const std::vector<double>& point);
+        void buildGrid(const Mesh& mesh);
 };
 
 #endif // POINTEXTRACTOR_HPP_INCLUDED
@@ -0,0 +1,190 @@
+#include "ScalarSink.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+ScalarSink::ScalarSink(const std::string& fileName, bool binary, bool append, std::size_t bufferSize) :
+m_pFile(nullptr),
+m_binary(binary),
+m_columnsCount(0),
+m_buffer(bufferSize),
+m_bufferUsed(0),
+m_size(0)
+{
+    if(bufferSize == 0)
+        throw std::runtime_error("the buffer of a scalar sink should not be empty!");
+
+    //The header of an existing binary file gives the number of columns of the appended rows
+    if(append && binary)
+    {
+        std::FILE* pFile = std::fopen(fileName.c_str(), "rb");
+        if(pFile != nullptr)
+        {
+            char magic[8];
+            std::uint32_t columnsCount = 0;
+            const bool hasHeader = std::fread(magic, 1, 8, pFile) == 8 &&
+                                   std::fread(&columnsCount, sizeof(columnsCount), 1, pFile) == 1;
+            std::fclose(pFile);
+
+            if(hasHeader)
+            {
+                if(std::string(magic, 8) != "PFEMSC01")
+                    throw std::runtime_error("cannot append to extractor file " + fileName + ": not a binary scalar file!");
+
+                m_columnsCount = columnsCount;
+            }
+        }
+    }
+
+    if(append)
+        m_pFile = std::fopen(fileName.c_str(), binary ? "ab" : "a");
+    else
+        m_pFile = std::fopen(fileName.c_str(), binary ? "wb" : "w");
+
+    if(m_pFile == nullptr)
+        throw std::runtime_error("cannot open file to write extractor: " + fileName);
+
+    //The rows are already buffered here
+    std::setvbuf(m_pFile, nullptr, _IONBF, 0);
+
+    if(append)
+    {
+        std::fseek(m_pFile, 0, SEEK_END);
+        const long size = std::ftell(m_pFile);
+        m_size = (size > 0) ? static_cast<std::uint64_t>(size) : 0;
+    }
+}
+
+ScalarSink::~ScalarSink()
+{
+    try
+    {
+        sync();
+    }
+    catch(...)
+    {
+        //Nothing better to do while destroying the extractors
+    }
+
+    std::fclose(m_pFile);
+}
+
+void ScalarSink::writeRow(double time, const std::vector<double>& values)
+{
+    if(m_binary)
+    {
+        if(m_columnsCount == 0)
+        {
+            m_columnsCount = values.size() + 1;
+            const std::uint32_t columnsCount = static_cast<std::uint32_t>(m_columnsCount);
+            append("PFEMSC01", 8);
+            append(&columnsCount, sizeof(columnsCount));
+        }
+        else if(values.size() + 1 != m_columnsCount)
+            throw std::runtime_error("the number of columns of a binary scalar sink cannot change!");
+
+        append(&time, sizeof(double));
+        append(values.data(), values.size()*sizeof(double));
+    }
+    else
+    {
+        appendText(time);
+        for(double value : values)
+        {
+            append(",", 1);
+            appendText(value);
+        }
+        append("\n", 1);
+    }
+}
+
+void ScalarSink::flush()
+{
+    if(m_bufferUsed == 0)
+        return;
+
+    const std::size_t size = m_bufferUsed;
+    m_bufferUsed = 0;
+
+    if(std::fwrite(m_buffer.data(), 1, size, m_pFile) != size)
+        throw std::runtime_error("an error occured while writing an extractor file!");
+}
+
+void ScalarSink::sync()
+{
+    flush();
+
+#ifdef _WIN32
+    _commit(_fileno(m_pFile));
+#else
+    fsync(fileno(m_pFile));
+#endif
+}
+
+std::size_t ScalarSink::getMemoryUsage() const noexcept
+{
+    return m_buffer.capacity();
+}
+
+std::uint64_t ScalarSink::getSize() const noexcept
+{
+    return m_size;
+}
+
+void ScalarSink::resize(std::uint64_t size)
+{
+    flush();
+
+#ifdef _WIN32
+    const bool ok = _chsize_s(_fileno(m_pFile), static_cast<__int64>(size)) == 0;
+#else
+    const bool ok = ftruncate(fileno(m_pFile), static_cast<off_t>(size)) == 0;
+#endif
+    if(!ok)
+        throw std::runtime_error("cannot resize an extractor file!");
+
+    m_size = size;
+
+    //An emptied binary file gets its header back with the next row
+    if(m_size == 0)
+        m_columnsCount = 0;
+}
+
+void ScalarSink::append(const void* pData, std::size_t size)
+{
+    if(m_bufferUsed + size > m_buffer.size())
+    {
+        flush();
+
+        if(size > m_buffer.size())
+        {
+            if(std::fwrite(pData, 1, size, m_pFile) != size)
+                throw std::runtime_error("an error occured while writing an extractor file!");
+
+            m_size += size;
+            return;
+        }
+    }
+
+    std::memcpy(m_buffer.data() + m_bufferUsed, pData, size);
+    m_bufferUsed += size;
+    m_size += size;
+}
+
+void ScalarSink::appendText(double value)
+{
+    //Same formatting as std::to_string, without the allocation
+    char text[512];
+    const int size = std::snprintf(text, sizeof(text), "%f", value);
+    if(size > 0)
+        append(text, std::min(static_cast<std::size_t>(size), sizeof(text) - 1));
+}
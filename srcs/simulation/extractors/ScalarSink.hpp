@@ -0,0 +1,71 @@
+#pragma once
+#ifndef SCALARSINK_HPP_INCLUDED
+#define SCALARSINK_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../simulation_defines.h"
+
+/**
+ * \class ScalarSink
+ * \brief Buffered writer of time series rows (time followed by scalar values) shared by the scalar extractors.
+ *
+ * Rows are accumulated in a large buffer which is only handed to the OS when full or on flush(),
+ * and only synchronised to the disk on sync() (checkpoints and end of simulation).
+ * In text mode, each row is a comma separated line. In binary mode, the file starts with
+ * the magic "PFEMSC01" and the uint32 number of columns, followed by fixed size rows of doubles.
+ * On restart, the rows are appended to the existing file, which is first cut back to its size at the checkpoint.
+ */
+class SIMULATION_API ScalarSink
+{
+    public:
+        ScalarSink()                                    = delete;
+        /**
+         * \param fileName The file name in which data will be written.
+         * \param binary Should the rows be written as raw doubles instead of text ?
+         * \param append Should the rows be appended to the file if it exists (restart) ?
+         * \param bufferSize The size in bytes of the write buffer.
+         */
+        ScalarSink(const std::string& fileName, bool binary, bool append = false, std::size_t bufferSize = 1 << 20);
+        ScalarSink(const ScalarSink& scalarSink)            = delete;
+        ScalarSink& operator=(const ScalarSink& scalarSink) = delete;
+        ScalarSink(ScalarSink&& scalarSink)                 = delete;
+        ScalarSink& operator=(ScalarSink&& scalarSink)      = delete;
+        ~ScalarSink();
+
+        /// \param time The simulation time of the row.
+        /// \param values The values of the row (the same number at each call in binary mode).
+        void writeRow(double time, const std::vector<double>& values);
+
+        /// \brief Hand the buffered rows to the OS.
+        void flush();
+
+        /// \brief Flush the buffered rows and wait until they are on the disk.
+        void sync();
+
+        /// \return The memory allocated by the write buffer, in bytes.
+        std::size_t getMemoryUsage() const noexcept;
+
+        /// \return The size in bytes of the file once the buffered rows are written.
+        std::uint64_t getSize() const noexcept;
+
+        /// \brief Cut the file back to a previous size (the rows written after a checkpoint are dropped on restart).
+        /// \param size The new size in bytes of the file, as returned by getSize.
+        void resize(std::uint64_t size);
+
+    private:
+        std::FILE* m_pFile;
+        bool m_binary;
+        std::size_t m_columnsCount;     /**< Number of columns of a binary row (0 until the first row). */
+        std::vector<char> m_buffer;
+        std::size_t m_bufferUsed;
+        std::uint64_t m_size;           /**< Size of the file once the buffered rows are written. */
+
+        void append(const void* pData, std::size_t size);
+        void appendText(double value);
+};
+
+#endif // SCALARSINK_HPP_INCLUDED
@@ -0,0 +1,497 @@
+#include "TimeSeriesExtractor.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifdef PFEM_USE_HDF5
+    #include <hdf5.h>
+    static_assert(std::is_same<hid_t, std::int64_t>::value, "hid_t is expected to be a 64 bits signed integer!");
+#endif
+
+#include "../Problem.hpp"
+#include "../utility/Memory.hpp"
+
+template<typename T>
+static void writeRaw(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void writeRaw(std::ofstream& file, const std::vector<T>& values)
+{
+    file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size()*sizeof(T)));
+}
+
+TimeSeriesExtractor::TimeSeriesExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
+                                         const std::vector<std::string>& whatToWrite, std::string format) :
+Extractor(pProblem, outFileName, timeBetweenWriting),
+m_format(std::move(format)),
+m_writeCount(0),
+m_recordsEnd(0),
+m_h5File(-1),
+m_h5IndexStep(-1),
+m_h5IndexTime(-1)
+{
+    if(m_format != "HDF5" && m_format != "Binary")
+        throw std::runtime_error("unknown time series format " + m_format);
+
+#ifndef PFEM_USE_HDF5
+    if(m_format == "HDF5")
+        throw std::runtime_error("HDF5 time series requested but PFEM was built without HDF5 (USE_HDF5)!");
+#endif
+
+    std::vector<std::string> writtableData = m_pProblem->getWrittableDataName();
+    std::vector<std::string> meshWrittableData = m_pProblem->getMeshWrittableDataName();
+
+    for(std::string dataToWrite: whatToWrite)
+    {
+        if(std::find(writtableData.begin(), writtableData.end(), dataToWrite) != writtableData.end())
+            m_whatToWrite.push_back(dataToWrite);
+        else if(std::find(meshWrittableData.begin(), meshWrittableData.end(), dataToWrite) != meshWrittableData.end())
+            m_meshToWrite.push_back(dataToWrite);
+        else
+            throw std::runtime_error("the problem " + m_pProblem->getID() + " cannot write data named " + dataToWrite + " using TimeSeriesExtractor!");
+    }
+
+    for(const std::string& dataToWrite : m_whatToWrite)
+        m_fieldsToWrite.push_back(m_pProblem->getWrittableField(dataToWrite));
+
+    for(const std::string& dataToWrite : m_meshToWrite)
+        m_fieldsToWrite.push_back(m_pProblem->getWrittableField(dataToWrite));
+
+    if(m_format == "HDF5")
+        openHDF5(m_pProblem->isRestarted());
+    else
+        openBinary(m_pProblem->isRestarted());
+}
+
+TimeSeriesExtractor::~TimeSeriesExtractor()
+{
+    if(m_format == "HDF5")
+        closeHDF5();
+    else
+        m_outFile.close();
+}
+
+std::string TimeSeriesExtractor::getDefaultFormat()
+{
+#ifdef PFEM_USE_HDF5
+    return "HDF5";
+#else
+    return "Binary";
+#endif
+}
+
+void TimeSeriesExtractor::update(bool force)
+{
+    if(m_pProblem->getCurrentSimTime() < m_nextWriteTrigger && !force)
+        return;
+
+    fillBuffers();
+
+    if(m_format == "HDF5")
+        writeHDF5();
+    else
+        writeBinary();
+
+    m_writeCount++;
+
+    if(!force)
+        m_nextWriteTrigger += m_timeBetweenWriting;
+}
+
+std::size_t TimeSeriesExtractor::getMemoryUsage() const
+{
+    return getMemorySize(m_index) + getMemorySize(m_coordinates) + getMemorySize(m_connectivity) +
+           getMemorySize(m_fields) + getMemorySize(m_fieldsComponents);
+}
+
+std::vector<double> TimeSeriesExtractor::getCheckpointData() const
+{
+    std::vector<double> data = {static_cast<double>(m_writeCount), static_cast<double>(m_recordsEnd)};
+    for(const IndexEntry& entry : m_index)
+    {
+        data.push_back(static_cast<double>(entry.offset));
+        data.push_back(static_cast<double>(entry.step));
+        data.push_back(entry.time);
+    }
+
+    return data;
+}
+
+void TimeSeriesExtractor::setCheckpointData(const std::vector<double>& data)
+{
+    //Without a saved state, the file is started again
+    if(data.size() < 2)
+    {
+        if(m_format == "HDF5")
+        {
+            closeHDF5();
+            openHDF5(false);
+        }
+        else
+        {
+            m_outFile.close();
+            openBinary(false);
+        }
+
+        return;
+    }
+
+    m_writeCount = static_cast<std::size_t>(data[0]);
+    m_recordsEnd = static_cast<std::uint64_t>(data[1]);
+    if(m_format == "Binary" && data.size() != 2 + 3*m_writeCount)
+        throw std::runtime_error("invalid time series extractor state in the checkpoint!");
+
+    m_index.clear();
+    for(std::size_t i = 2 ; i + 2 < data.size() ; i += 3)
+    {
+        IndexEntry entry;
+        entry.offset = static_cast<std::uint64_t>(data[i]);
+        entry.step = static_cast<std::uint64_t>(data[i + 1]);
+        entry.time = data[i + 2];
+        m_index.push_back(entry);
+    }
+
+    if(m_format == "HDF5")
+        restoreHDF5();
+    else
+        restoreBinary();
+}
+
+void TimeSeriesExtractor::fillBuffers()
+{
+    const Mesh& mesh = m_pProblem->getMesh();
+    const std::size_t nodesCount = mesh.getNodesCount();
+    const std::size_t elementsCount = mesh.getElementsCount();
+    const unsigned short nodesPerElm = mesh.getNodesPerElm();
+
+    m_coordinates.resize(3*nodesCount);
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        const Node& node = mesh.getNode(n);
+        m_coordinates[3*n] = node.getCoordinate(0);
+        m_coordinates[3*n + 1] = node.getCoordinate(1);
+        m_coordinates[3*n + 2] = (mesh.getDim() == 2) ? 0 : node.getCoordinate(2);
+    }
+
+    m_connectivity.resize(nodesPerElm*elementsCount);
+    #pragma omp parallel for default(shared)
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+    {
+        const Element& element = mesh.getElement(elm);
+        for(unsigned short n = 0 ; n < nodesPerElm ; ++n)
+            m_connectivity[nodesPerElm*elm + n] = static_cast<std::int64_t>(element.getNodeIndex(n));
+    }
+
+    m_fields.resize(m_fieldsToWrite.size());
+    m_fieldsComponents.resize(m_fieldsToWrite.size());
+    for(std::size_t i = 0 ; i < m_fieldsToWrite.size() ; ++i)
+    {
+        m_fieldsComponents[i] = m_fieldsToWrite[i].componentsCount;
+        m_fields[i].resize(m_fieldsComponents[i]*nodesCount);
+        m_pProblem->getWrittableData(m_fieldsToWrite[i], m_fields[i].data());
+    }
+}
+
+void TimeSeriesExtractor::openBinary(bool append)
+{
+    //The records of an existing file are restored from the checkpoint (see restoreBinary)
+    if(append)
+    {
+        m_outFile.open(m_outFileName, std::ios::binary | std::ios::in | std::ios::out);
+        if(m_outFile.is_open())
+            return;
+    }
+
+    m_outFile.open(m_outFileName, std::ios::binary | std::ios::trunc);
+    if(!m_outFile.is_open())
+        throw std::runtime_error("cannot open file to write time series extractor: " + m_outFileName);
+
+    const char magic[8] = {'P', 'F', 'E', 'M', 'T', 'S', '0', '1'};
+    m_outFile.write(magic, sizeof(magic));
+    writeRaw(m_outFile, std::uint32_t(1)); //version
+    writeRaw<std::uint32_t>(m_outFile, m_pProblem->getMesh().getDim());
+    writeRaw<std::uint32_t>(m_outFile, m_whatToWrite.size() + m_meshToWrite.size());
+
+    for(std::size_t i = 0 ; i < m_whatToWrite.size() + m_meshToWrite.size() ; ++i)
+    {
+        const std::string& name = (i < m_whatToWrite.size()) ? m_whatToWrite[i] : m_meshToWrite[i - m_whatToWrite.size()];
+        writeRaw<std::uint32_t>(m_outFile, name.size());
+        m_outFile.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+
+    m_recordsEnd = static_cast<std::uint64_t>(m_outFile.tellp());
+
+    //Empty index so that the file is valid even before the first write
+    m_index.clear();
+    writeBinaryFooter();
+    m_outFile.flush();
+}
+
+void TimeSeriesExtractor::writeBinary()
+{
+    const Mesh& mesh = m_pProblem->getMesh();
+
+    IndexEntry entry;
+    entry.offset = m_recordsEnd;
+    entry.step = static_cast<std::uint64_t>(m_pProblem->getCurrentSimStep());
+    entry.time = m_pProblem->getCurrentSimTime();
+    m_index.push_back(entry);
+
+    //The new record overwrites the previous footer
+    m_outFile.seekp(static_cast<std::streamoff>(m_recordsEnd));
+    writeRaw(m_outFile, entry.step);
+    writeRaw(m_outFile, entry.time);
+    writeRaw<std::uint64_t>(m_outFile, mesh.getNodesCount());
+    writeRaw<std::uint64_t>(m_outFile, mesh.getElementsCount());
+    writeRaw<std::uint32_t>(m_outFile, mesh.getNodesPerElm());
+    writeRaw<std::uint32_t>(m_outFile, m_fields.size());
+    writeRaw(m_outFile, m_coordinates);
+    writeRaw(m_outFile, m_connectivity);
+    for(std::size_t i = 0 ; i < m_fields.size() ; ++i)
+    {
+        writeRaw<std::uint32_t>(m_outFile, m_fieldsComponents[i]);
+        writeRaw(m_outFile, m_fields[i]);
+    }
+
+    m_recordsEnd = static_cast<std::uint64_t>(m_outFile.tellp());
+
+    writeBinaryFooter();
+    m_outFile.flush();
+
+    if(!m_outFile)
+        throw std::runtime_error("error while writing time series file: " + m_outFileName);
+}
+
+void TimeSeriesExtractor::writeBinaryFooter()
+{
+    for(const IndexEntry& indexEntry : m_index)
+    {
+        writeRaw(m_outFile, indexEntry.offset);
+        writeRaw(m_outFile, indexEntry.step);
+        writeRaw(m_outFile, indexEntry.time);
+    }
+    writeRaw<std::uint64_t>(m_outFile, m_index.size());
+    const char indexMagic[8] = {'P', 'F', 'E', 'M', 'I', 'D', 'X', '1'};
+    m_outFile.write(indexMagic, sizeof(indexMagic));
+}
+
+void TimeSeriesExtractor::restoreBinary()
+{
+    if(std::filesystem::file_size(m_outFileName) < m_recordsEnd)
+        throw std::runtime_error("the time series file " + m_outFileName + " is shorter than in the checkpoint!");
+
+    //The records written after the checkpoint are replaced by the footer of the checkpoint
+    m_outFile.seekp(static_cast<std::streamoff>(m_recordsEnd));
+    writeBinaryFooter();
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(m_outFile.tellp());
+    m_outFile.close();
+
+    std::filesystem::resize_file(m_outFileName, fileSize);
+
+    m_outFile.open(m_outFileName, std::ios::binary | std::ios::in | std::ios::out);
+    if(!m_outFile.is_open())
+        throw std::runtime_error("cannot open file to write time series extractor: " + m_outFileName);
+}
+
+#ifdef PFEM_USE_HDF5
+
+static void writeH5Dataset(hid_t group, const std::string& name, hid_t type,
+                           std::size_t rows, std::size_t cols, const void* pData)
+{
+    hsize_t dims[2] = {rows, cols};
+    hid_t space = H5Screate_simple(2, dims, nullptr);
+
+    //Chunked along the rows so that part of a snapshot can be read without loading it all
+    hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+    if(rows > 0 && cols > 0)
+    {
+        hsize_t chunk[2] = {std::min<hsize_t>(rows, 16384), cols};
+        H5Pset_chunk(properties, 2, chunk);
+    }
+
+    hid_t dataset = H5Dcreate2(group, name.c_str(), type, space, H5P_DEFAULT, properties, H5P_DEFAULT);
+    if(dataset < 0)
+        throw std::runtime_error("cannot create HDF5 dataset " + name);
+
+    if(rows > 0 && cols > 0)
+        H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, pData);
+
+    H5Dclose(dataset);
+    H5Pclose(properties);
+    H5Sclose(space);
+}
+
+static void writeH5Attribute(hid_t object, const std::string& name, hid_t type, const void* pValue)
+{
+    hid_t space = H5Screate(H5S_SCALAR);
+    hid_t attribute = H5Acreate2(object, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attribute, type, pValue);
+    H5Aclose(attribute);
+    H5Sclose(space);
+}
+
+static hid_t createH5Index(hid_t group, const std::string& name, hid_t type)
+{
+    hsize_t dims[1] = {0};
+    hsize_t maxDims[1] = {H5S_UNLIMITED};
+    hsize_t chunk[1] = {1024};
+    hid_t space = H5Screate_simple(1, dims, maxDims);
+    hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(properties, 1, chunk);
+
+    hid_t dataset = H5Dcreate2(group, name.c_str(), type, space, H5P_DEFAULT, properties, H5P_DEFAULT);
+    H5Pclose(properties);
+    H5Sclose(space);
+
+    if(dataset < 0)
+        throw std::runtime_error("cannot create HDF5 dataset " + name);
+
+    return dataset;
+}
+
+static void appendH5Index(hid_t dataset, hsize_t position, hid_t type, const void* pValue)
+{
+    hsize_t newSize[1] = {position + 1};
+    H5Dset_extent(dataset, newSize);
+
+    hid_t fileSpace = H5Dget_space(dataset);
+    hsize_t start[1] = {position};
+    hsize_t count[1] = {1};
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+    hid_t memSpace = H5Screate_simple(1, count, nullptr);
+
+    H5Dwrite(dataset, type, memSpace, fileSpace, H5P_DEFAULT, pValue);
+
+    H5Sclose(memSpace);
+    H5Sclose(fileSpace);
+}
+
+void TimeSeriesExtractor::openHDF5(bool append)
+{
+    //The snapshots of an existing file are restored from the checkpoint (see restoreHDF5)
+    if(append && H5Fis_hdf5(m_outFileName.c_str()) > 0)
+    {
+        m_h5File = H5Fopen(m_outFileName.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+        if(m_h5File < 0)
+            throw std::runtime_error("cannot open file to write time series extractor: " + m_outFileName);
+
+        m_h5IndexStep = H5Dopen2(m_h5File, "index/step", H5P_DEFAULT);
+        m_h5IndexTime = H5Dopen2(m_h5File, "index/time", H5P_DEFAULT);
+        if(m_h5IndexStep < 0 || m_h5IndexTime < 0)
+            throw std::runtime_error("the time series file " + m_outFileName + " has no index!");
+
+        return;
+    }
+
+    m_h5File = H5Fcreate(m_outFileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if(m_h5File < 0)
+        throw std::runtime_error("cannot open file to write time series extractor: " + m_outFileName);
+
+    hid_t steps = H5Gcreate2(m_h5File, "steps", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5Gclose(steps);
+
+    hid_t index = H5Gcreate2(m_h5File, "index", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    m_h5IndexStep = createH5Index(index, "step", H5T_NATIVE_UINT64);
+    m_h5IndexTime = createH5Index(index, "time", H5T_NATIVE_DOUBLE);
+    H5Gclose(index);
+
+    const std::uint32_t dim = m_pProblem->getMesh().getDim();
+    writeH5Attribute(m_h5File, "dim", H5T_NATIVE_UINT32, &dim);
+}
+
+void TimeSeriesExtractor::writeHDF5()
+{
+    const Mesh& mesh = m_pProblem->getMesh();
+    const std::uint64_t step = static_cast<std::uint64_t>(m_pProblem->getCurrentSimStep());
+    const double time = m_pProblem->getCurrentSimTime();
+
+    char groupName[32];
+    std::snprintf(groupName, sizeof(groupName), "steps/%08zu", m_writeCount);
+    hid_t group = H5Gcreate2(m_h5File, groupName, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if(group < 0)
+        throw std::runtime_error("cannot create HDF5 group " + std::string(groupName));
+
+    writeH5Attribute(group, "step", H5T_NATIVE_UINT64, &step);
+    writeH5Attribute(group, "time", H5T_NATIVE_DOUBLE, &time);
+
+    writeH5Dataset(group, "coordinates", H5T_NATIVE_DOUBLE, mesh.getNodesCount(), 3, m_coordinates.data());
+    writeH5Dataset(group, "connectivity", H5T_NATIVE_INT64, mesh.getElementsCount(), mesh.getNodesPerElm(), m_connectivity.data());
+    for(std::size_t i = 0 ; i < m_fields.size() ; ++i)
+    {
+        const std::string& name = (i < m_whatToWrite.size()) ? m_whatToWrite[i] : m_meshToWrite[i - m_whatToWrite.size()];
+        writeH5Dataset(group, name, H5T_NATIVE_DOUBLE, mesh.getNodesCount(), m_fieldsComponents[i], m_fields[i].data());
+    }
+
+    H5Gclose(group);
+
+    appendH5Index(m_h5IndexStep, m_writeCount, H5T_NATIVE_UINT64, &step);
+    appendH5Index(m_h5IndexTime, m_writeCount, H5T_NATIVE_DOUBLE, &time);
+
+    H5Fflush(m_h5File, H5F_SCOPE_GLOBAL);
+}
+
+void TimeSeriesExtractor::restoreHDF5()
+{
+    //The snapshots written after the checkpoint are removed
+    for(std::size_t i = m_writeCount ; ; ++i)
+    {
+        char groupName[32];
+        std::snprintf(groupName, sizeof(groupName), "steps/%08zu", i);
+        if(H5Lexists(m_h5File, groupName, H5P_DEFAULT) <= 0)
+            break;
+
+        H5Ldelete(m_h5File, groupName, H5P_DEFAULT);
+    }
+
+    hsize_t newSize[1] = {m_writeCount};
+    H5Dset_extent(m_h5IndexStep, newSize);
+    H5Dset_extent(m_h5IndexTime, newSize);
+
+    H5Fflush(m_h5File, H5F_SCOPE_GLOBAL);
+}
+
+void TimeSeriesExtractor::closeHDF5()
+{
+    if(m_h5IndexStep >= 0)
+        H5Dclose(m_h5IndexStep);
+    if(m_h5IndexTime >= 0)
+        H5Dclose(m_h5IndexTime);
+    if(m_h5File >= 0)
+        H5Fclose(m_h5File);
+
+    m_h5IndexStep = -1;
+    m_h5IndexTime = -1;
+    m_h5File = -1;
+}
+
+#else
+
+void TimeSeriesExtractor::openHDF5(bool append)
+{
+    (void) append;
+    throw std::runtime_error("PFEM was built without HDF5 (USE_HDF5)!");
+}
+
+void TimeSeriesExtractor::writeHDF5()
+{
+    throw std::runtime_error("PFEM was built without HDF5 (USE_HDF5)!");
+}
+
+void TimeSeriesExtractor::restoreHDF5()
+{
+    throw std::runtime_error("PFEM was built without HDF5 (USE_HDF5)!");
+}
+
+void TimeSeriesExtractor::closeHDF5()
+{
+}
+
+#endif // PFEM_USE_HDF5
@@ -0,0 +1,101 @@
+#pragma once
+#ifndef TIMESERIESEXTRACTOR_HPP_INCLUDED
+#define TIMESERIESEXTRACTOR_HPP_INCLUDED
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include "Extractor.hpp"
+
+/**
+ * \class TimeSeriesExtractor
+ * \brief Extractor appending every snapshot (coordinates, connectivity, fields, step and time)
+ *        into one single indexed file.
+ *
+ * Two formats are available:
+ *  - "HDF5" (if PFEM is built with USE_HDF5): one group /steps/<index> per snapshot, holding one dataset per
+ *    array and the step and time as attributes, plus the chunked extendible datasets /index/step and /index/time.
+ *  - "Binary": a self-contained format. The file starts with a header (magic "PFEMTS01", version, field names)
+ *    followed by one record per snapshot and ends with an index of (offset, step, time) for every record,
+ *    the number of records and the magic "PFEMIDX1". A reader seeks to any snapshot in O(1) from the footer.
+ *
+ * On restart, the snapshots are appended to the existing file, from which the snapshots written after the
+ * checkpoint are first removed.
+ */
+class SIMULATION_API TimeSeriesExtractor : public Extractor
+{
+    public:
+        TimeSeriesExtractor()                                                     = delete;
+        /**
+         * \param pProblem A pointer to the problem from which data will be extracted.
+         * \param outFileName The file name in which data will be written.
+         * \param timeBetweenWriting The simulation time between each write.
+         * \param whatToWrite A vector containing the name of which data to write.
+         * \param format The container format: "HDF5" or "Binary".
+         */
+        TimeSeriesExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
+                            const std::vector<std::string>& whatToWrite, std::string format);
+        TimeSeriesExtractor(const TimeSeriesExtractor& timeSeriesExtractor)            = delete;
+        TimeSeriesExtractor& operator=(const TimeSeriesExtractor& timeSeriesExtractor) = delete;
+        TimeSeriesExtractor(TimeSeriesExtractor&& timeSeriesExtractor)                 = delete;
+        TimeSeriesExtractor& operator=(TimeSeriesExtractor&& timeSeriesExtractor)      = delete;
+        ~TimeSeriesExtractor() override;
+
+        /// Update the extractor state and write data if necessary
+        void update(bool force) override;
+
+        std::size_t getMemoryUsage() const override;
+
+        std::vector<double> getCheckpointData() const override;
+        void setCheckpointData(const std::vector<double>& data) override;
+
+        /// \return The default format: "HDF5" if PFEM was built with it, "Binary" otherwise.
+        static std::string getDefaultFormat();
+
+    private:
+        /**
+         * \struct IndexEntry
+         * \brief Position of one snapshot record inside the binary file.
+         */
+        struct IndexEntry
+        {
+            std::uint64_t offset;
+            std::uint64_t step;
+            double time;
+        };
+
+        std::vector<std::string> m_whatToWrite;
+        std::vector<std::string> m_meshToWrite;
+        std::vector<WrittableField> m_fieldsToWrite;    /**< Fields of m_whatToWrite then m_meshToWrite, resolved once. */
+        std::string m_format;
+        std::size_t m_writeCount;
+
+        //Binary format
+        std::ofstream m_outFile;
+        std::vector<IndexEntry> m_index;
+        std::uint64_t m_recordsEnd;     /**< Offset of the footer, overwritten by the next record. */
+
+        //HDF5 format (hid_t values)
+        std::int64_t m_h5File;
+        std::int64_t m_h5IndexStep;
+        std::int64_t m_h5IndexTime;
+
+        //Buffers kept between writes to avoid reallocations
+        std::vector<double> m_coordinates;
+        std::vector<std::int64_t> m_connectivity;
+        std::vector<std::vector<double>> m_fields;
+        std::vector<unsigned int> m_fieldsComponents;
+
+        void fillBuffers();
+        void openBinary(bool append);
+        void writeBinary();
+        void writeBinaryFooter();
+        void restoreBinary();
+        void openHDF5(bool append);
+        void writeHDF5();
+        void restoreHDF5();
+        void closeHDF5();
+};
+
+#endif // TIMESERIESEXTRACTOR_HPP_INCLUDED
@@ -0,0 +1,315 @@
+#include "VTUExtractor.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef PFEM_USE_ZLIB
+    #include <zlib.h>
+#endif
+
+#include "../Problem.hpp"
+#include "../utility/Memory.hpp"
+
+static const char* getByteOrder()
+{
+    const std::uint16_t one = 1;
+    return (*reinterpret_cast<const std::uint8_t*>(&one) == 1) ? "LittleEndian" : "BigEndian";
+}
+
+static const std::string pvdFooter = "  </Collection>\n</VTKFile>\n";
+
+VTUExtractor::VTUExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
+                           const std::vector<std::string>& whatToWrite, std::string writeAs, bool compress) :
+Extractor(pProblem, outFileName, timeBetweenWriting),
+m_writeAs(std::move(writeAs)),
+m_compress(compress),
+m_writeCount(0)
+{
+    if(!(m_writeAs == "Nodes" || m_writeAs == "Elements" || m_writeAs == "NodesElements"))
+        throw std::runtime_error("unknown data type for results writing " + m_writeAs);
+
+#ifndef PFEM_USE_ZLIB
+    if(m_compress)
+        throw std::runtime_error("VTU compression requested but PFEM was built without zlib (USE_ZLIB)!");
+#endif
+
+    std::vector<std::string> writtableData = m_pProblem->getWrittableDataName();
+    std::vector<std::string> meshWrittableData = m_pProblem->getMeshWrittableDataName();
+
+    for(std::string dataToWrite: whatToWrite)
+    {
+        if(std::find(writtableData.begin(), writtableData.end(), dataToWrite) != writtableData.end())
+            m_whatToWrite.push_back(dataToWrite);
+        else if(std::find(meshWrittableData.begin(), meshWrittableData.end(), dataToWrite) != meshWrittableData.end())
+            m_meshToWrite.push_back(dataToWrite);
+        else
+            throw std::runtime_error("the problem " + m_pProblem->getID() + " cannot write data named " + dataToWrite + " using VTUExtractor!");
+    }
+
+    for(const std::string& dataToWrite : m_whatToWrite)
+        m_fieldsToWrite.push_back(m_pProblem->getWrittableField(dataToWrite));
+
+    for(const std::string& dataToWrite : m_meshToWrite)
+        m_fieldsToWrite.push_back(m_pProblem->getWrittableField(dataToWrite));
+
+    m_baseName = m_outFileName.substr(0, std::min(m_outFileName.find(".pvd"), m_outFileName.find(".vtu")));
+
+    //On restart, the existing .pvd is only rewritten once its entries are restored from the checkpoint
+    if(!m_pProblem->isRestarted())
+        writePVDHeader();
+}
+
+VTUExtractor::~VTUExtractor()
+{
+    m_pvdFile.close();
+}
+
+void VTUExtractor::update(bool force)
+{
+    if(m_pProblem->getCurrentSimTime() < m_nextWriteTrigger && !force)
+        return;
+
+    const std::string fileName = m_baseName + "_" + std::to_string(m_writeCount) + ".vtu";
+
+    fillBuffers();
+    writeVTU(fileName);
+    m_pvdTimes.push_back(m_pProblem->getCurrentSimTime());
+    writePVDEntry(m_pvdTimes.back(), fileName);
+
+    m_writeCount++;
+
+    if(!force)
+        m_nextWriteTrigger += m_timeBetweenWriting;
+}
+
+std::size_t VTUExtractor::getMemoryUsage() const
+{
+    return getMemorySize(m_points) + getMemorySize(m_connectivity) + getMemorySize(m_offsets) + getMemorySize(m_types) +
+           getMemorySize(m_fields) + getMemorySize(m_fieldsComponents) + getMemorySize(m_pvdTimes);
+}
+
+std::vector<double> VTUExtractor::getCheckpointData() const
+{
+    std::vector<double> data = {static_cast<double>(m_writeCount)};
+    data.insert(data.end(), m_pvdTimes.begin(), m_pvdTimes.end());
+
+    return data;
+}
+
+void VTUExtractor::setCheckpointData(const std::vector<double>& data)
+{
+    if(!data.empty())
+    {
+        m_writeCount = static_cast<std::size_t>(data[0]);
+        m_pvdTimes.assign(data.begin() + 1, data.end());
+        if(m_pvdTimes.size() != m_writeCount)
+            throw std::runtime_error("invalid VTU extractor state in the checkpoint!");
+    }
+
+    //The entries written after the checkpoint are dropped, their .vtu files will be overwritten
+    writePVDHeader();
+    for(std::size_t i = 0 ; i < m_pvdTimes.size() ; ++i)
+        writePVDEntry(m_pvdTimes[i], m_baseName + "_" + std::to_string(i) + ".vtu");
+}
+
+void VTUExtractor::fillBuffers()
+{
+    const Mesh& mesh = m_pProblem->getMesh();
+    const std::size_t nodesCount = mesh.getNodesCount();
+    const unsigned short nodesPerElm = mesh.getNodesPerElm();
+
+    m_points.resize(3*nodesCount);
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        const Node& node = mesh.getNode(n);
+        m_points[3*n] = node.getCoordinate(0);
+        m_points[3*n + 1] = node.getCoordinate(1);
+        m_points[3*n + 2] = (mesh.getDim() == 2) ? 0 : node.getCoordinate(2);
+    }
+
+    const bool writeElements = (m_writeAs == "Elements" || m_writeAs == "NodesElements");
+    const bool writeNodes = (m_writeAs == "Nodes" || m_writeAs == "NodesElements");
+    const std::size_t elementsCount = writeElements ? mesh.getElementsCount() : 0;
+    const std::size_t verticesCount = writeNodes ? nodesCount : 0;
+
+    m_connectivity.resize(nodesPerElm*elementsCount + verticesCount);
+    m_offsets.resize(elementsCount + verticesCount);
+    m_types.resize(elementsCount + verticesCount);
+
+    const std::uint8_t elementType = (mesh.getDim() == 2) ? 5 : 10; //VTK_TRIANGLE or VTK_TETRA
+    #pragma omp parallel for default(shared)
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+    {
+        const Element& element = mesh.getElement(elm);
+        for(unsigned short n = 0 ; n < nodesPerElm ; ++n)
+            m_connectivity[nodesPerElm*elm + n] = static_cast<std::int64_t>(element.getNodeIndex(n));
+
+        m_offsets[elm] = static_cast<std::int64_t>(nodesPerElm*(elm + 1));
+        m_types[elm] = elementType;
+    }
+
+    const std::size_t connectivityShift = nodesPerElm*elementsCount;
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < verticesCount ; ++n)
+    {
+        m_connectivity[connectivityShift + n] = static_cast<std::int64_t>(n);
+        m_offsets[elementsCount + n] = static_cast<std::int64_t>(connectivityShift + n + 1);
+        m_types[elementsCount + n] = 1; //VTK_VERTEX
+    }
+
+    m_fields.resize(m_fieldsToWrite.size());
+    m_fieldsComponents.resize(m_fieldsToWrite.size());
+    for(std::size_t i = 0 ; i < m_fieldsToWrite.size() ; ++i)
+    {
+        m_fieldsComponents[i] = m_fieldsToWrite[i].componentsCount;
+        m_fields[i].resize(m_fieldsComponents[i]*nodesCount);
+        m_pProblem->getWrittableData(m_fieldsToWrite[i], m_fields[i].data());
+    }
+}
+
+VTUExtractor::DataBlock VTUExtractor::makeBlock(const void* pData, std::size_t size) const
+{
+    DataBlock block;
+    block.pData = static_cast<const char*>(pData);
+    block.size = size;
+
+    if(!m_compress)
+    {
+        block.header = {size};
+        return block;
+    }
+
+#ifdef PFEM_USE_ZLIB
+    //Same layout as vtkZLibDataCompressor: [#blocks][block size][last partial block size][compressed sizes...]
+    constexpr std::size_t blockSize = 1 << 16;
+    const std::size_t blocksCount = (size + blockSize - 1)/blockSize;
+    block.header = {blocksCount, blockSize, size % blockSize};
+
+    block.compressed.resize(blocksCount*compressBound(blockSize));
+    std::size_t compressedSize = 0;
+    for(std::size_t b = 0 ; b < blocksCount ; ++b)
+    {
+        const std::size_t uncompressedSize = std::min(blockSize, size - b*blockSize);
+        uLongf destSize = compressBound(uncompressedSize);
+        if(compress2(reinterpret_cast<Bytef*>(block.compressed.data() + compressedSize), &destSize,
+                     reinterpret_cast<const Bytef*>(block.pData + b*blockSize), uncompressedSize, Z_BEST_SPEED) != Z_OK)
+            throw std::runtime_error("zlib failed to compress VTU data!");
+
+        block.header.push_back(destSize);
+        compressedSize += destSize;
+    }
+    block.compressed.resize(compressedSize);
+#endif
+
+    return block;
+}
+
+void VTUExtractor::writeVTU(const std::string& fileName)
+{
+    const std::size_t nodesCount = m_points.size()/3;
+
+    std::vector<DataBlock> blocks;
+    for(std::size_t i = 0 ; i < m_fields.size() ; ++i)
+        blocks.push_back(makeBlock(m_fields[i].data(), m_fields[i].size()*sizeof(double)));
+    blocks.push_back(makeBlock(m_points.data(), m_points.size()*sizeof(double)));
+    blocks.push_back(makeBlock(m_connectivity.data(), m_connectivity.size()*sizeof(std::int64_t)));
+    blocks.push_back(makeBlock(m_offsets.data(), m_offsets.size()*sizeof(std::int64_t)));
+    blocks.push_back(makeBlock(m_types.data(), m_types.size()*sizeof(std::uint8_t)));
+
+    std::vector<std::size_t> offsets(blocks.size());
+    std::size_t offset = 0;
+    for(std::size_t i = 0 ; i < blocks.size() ; ++i)
+    {
+        offsets[i] = offset;
+        offset += blocks[i].header.size()*sizeof(std::uint64_t) + (m_compress ? blocks[i].compressed.size() : blocks[i].size);
+    }
+
+    std::ofstream file(fileName, std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("cannot open file to write VTU extractor: " + fileName);
+
+    file << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << getByteOrder() << "\" header_type=\"UInt64\""
+         << (m_compress ? " compressor=\"vtkZLibDataCompressor\"" : "") << ">\n"
+         << "  <UnstructuredGrid>\n"
+         << "    <Piece NumberOfPoints=\"" << nodesCount << "\" NumberOfCells=\"" << m_types.size() << "\">\n"
+         << "      <PointData>\n";
+
+    for(std::size_t i = 0 ; i < m_fields.size() ; ++i)
+    {
+        const std::string& name = (i < m_whatToWrite.size()) ? m_whatToWrite[i] : m_meshToWrite[i - m_whatToWrite.size()];
+        file << "        <DataArray type=\"Float64\" Name=\"" << name << "\" NumberOfComponents=\"" << m_fieldsComponents[i]
+             << "\" format=\"appended\" offset=\"" << offsets[i] << "\"/>\n";
+    }
+
+    const std::size_t first = m_fields.size();
+    file << "      </PointData>\n"
+         << "      <Points>\n"
+         << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << offsets[first] << "\"/>\n"
+         << "      </Points>\n"
+         << "      <Cells>\n"
+         << "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\"" << offsets[first + 1] << "\"/>\n"
+         << "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\"" << offsets[first + 2] << "\"/>\n"
+         << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << offsets[first + 3] << "\"/>\n"
+         << "      </Cells>\n"
+         << "    </Piece>\n"
+         << "  </UnstructuredGrid>\n"
+         << "  <AppendedData encoding=\"raw\">\n"
+         << "_";
+
+    //fillBuffers copied the mesh into the VTK layout; when not compressed, these buffers are written as is,
+    //without a second copy
+    for(const DataBlock& block : blocks)
+    {
+        file.write(reinterpret_cast<const char*>(block.header.data()),
+                   static_cast<std::streamsize>(block.header.size()*sizeof(std::uint64_t)));
+        if(m_compress)
+            file.write(block.compressed.data(), static_cast<std::streamsize>(block.compressed.size()));
+        else
+            file.write(block.pData, static_cast<std::streamsize>(block.size));
+    }
+
+    file << "\n  </AppendedData>\n"
+         << "</VTKFile>\n";
+
+    if(!file)
+        throw std::runtime_error("error while writing VTU file: " + fileName);
+}
+
+void VTUExtractor::writePVDHeader()
+{
+    if(m_pvdFile.is_open())
+        m_pvdFile.close();
+
+    m_pvdFile.open(m_baseName + ".pvd", std::ios::trunc);
+    if(!m_pvdFile.is_open())
+        throw std::runtime_error("cannot open file to write VTU extractor: " + m_baseName + ".pvd");
+
+    m_pvdFile << "<?xml version=\"1.0\"?>\n"
+              << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"" << getByteOrder() << "\">\n"
+              << "  <Collection>\n";
+    m_pvdEntriesEnd = m_pvdFile.tellp();
+    m_pvdFile << pvdFooter << std::flush;
+}
+
+void VTUExtractor::writePVDEntry(double time, const std::string& fileName)
+{
+    //The .pvd references the .vtu files relatively to its own location
+    const std::size_t slash = fileName.find_last_of("/\\");
+    const std::string relativeName = (slash == std::string::npos) ? fileName : fileName.substr(slash + 1);
+
+    //The time is written exactly, small time steps would otherwise give several entries with the same time
+    std::ostringstream timeStream;
+    timeStream.precision(std::numeric_limits<double>::max_digits10);
+    timeStream << time;
+
+    m_pvdFile.seekp(m_pvdEntriesEnd);
+    m_pvdFile << "    <DataSet timestep=\"" << timeStream.str()
+              << "\" group=\"\" part=\"0\" file=\"" << relativeName << "\"/>\n";
+    m_pvdEntriesEnd = m_pvdFile.tellp();
+    m_pvdFile << pvdFooter << std::flush;
+}
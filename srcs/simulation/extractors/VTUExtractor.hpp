@@ -0,0 +1,87 @@
+#pragma once
+#ifndef VTUEXTRACTOR_HPP_INCLUDED
+#define VTUEXTRACTOR_HPP_INCLUDED
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include "Extractor.hpp"
+
+/**
+ * \class VTUExtractor
+ * \brief Extractor to save data inside VTK unstructured grid files (binary appended data)
+ *        indexed by a ParaView .pvd file. Does not require gmsh.
+ *
+ * On restart, the .pvd is rewritten from the entries saved in the checkpoint and the numbering
+ * of the .vtu files continues from there.
+ */
+class SIMULATION_API VTUExtractor : public Extractor
+{
+    public:
+        VTUExtractor()                                           = delete;
+        /**
+         * \param pProblem A pointer to the problem from which data will be extracted.
+         * \param outFileName The file name of the .pvd index (the .vtu files are written next to it).
+         * \param timeBetweenWriting The simulation time between each write.
+         * \param whatToWrite A vector containing the name of which data to write.
+         * \param writeAs Hot to save the data. Can be "Nodes", "Elements" or "NodesElements".
+         * \param compress Should the data be compressed using zlib ?
+         */
+        VTUExtractor(Problem* pProblem, const std::string& outFileName, double timeBetweenWriting,
+                     const std::vector<std::string>& whatToWrite, std::string writeAs, bool compress);
+        VTUExtractor(const VTUExtractor& vtuExtractor)            = delete;
+        VTUExtractor& operator=(const VTUExtractor& vtuExtractor) = delete;
+        VTUExtractor(VTUExtractor&& vtuExtractor)                 = delete;
+        VTUExtractor& operator=(VTUExtractor&& vtuExtractor)      = delete;
+        ~VTUExtractor() override;
+
+        /// Update the extractor state and write data if necessary
+        void update(bool force) override;
+
+        std::size_t getMemoryUsage() const override;
+
+        std::vector<double> getCheckpointData() const override;
+        void setCheckpointData(const std::vector<double>& data) override;
+
+    private:
+        /**
+         * \struct DataBlock
+         * \brief One appended data array, ready to be written.
+         */
+        struct DataBlock
+        {
+            const char* pData;              /**< Raw data (used when not compressed). */
+            std::size_t size;               /**< Size in bytes of the raw data. */
+            std::vector<std::uint64_t> header;
+            std::vector<char> compressed;   /**< Compressed data (used when compressed). */
+        };
+
+        std::vector<std::string> m_whatToWrite;
+        std::vector<std::string> m_meshToWrite;
+        std::vector<WrittableField> m_fieldsToWrite;    /**< Fields of m_whatToWrite then m_meshToWrite, resolved once. */
+        std::string m_writeAs;
+        bool m_compress;
+
+        std::string m_baseName;         /**< Path of the .vtu files without the index and extension. */
+        std::ofstream m_pvdFile;
+        std::streampos m_pvdEntriesEnd; /**< Position of the .pvd footer, overwritten by each new entry. */
+        std::size_t m_writeCount;
+        std::vector<double> m_pvdTimes; /**< Time of each .pvd entry (the file of entry i is m_baseName_i.vtu). */
+
+        //Buffers kept between writes to avoid reallocations
+        std::vector<double> m_points;
+        std::vector<std::int64_t> m_connectivity;
+        std::vector<std::int64_t> m_offsets;
+        std::vector<std::uint8_t> m_types;
+        std::vector<std::vector<double>> m_fields;
+        std::vector<unsigned int> m_fieldsComponents;
+
+        void fillBuffers();
+        DataBlock makeBlock(const void* pData, std::size_t size) const;
+        void writeVTU(const std::string& fileName);
+        void writePVDHeader();
+        void writePVDEntry(double time, const std::string& fileName);
+};
+
+#endif // VTUEXTRACTOR_HPP_INCLUDED
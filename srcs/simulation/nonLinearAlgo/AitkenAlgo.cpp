@@ -0,0 +1,139 @@
+#include "AitkenAlgo.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "../../mesh/Mesh.hpp"
+
+AitkenAlgo::AitkenAlgo(std::function<void(const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> prepare,
+                       std::function<bool(std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                          const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> solve,
+                       std::function<double(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                            const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes,
+                       std::function<void(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                          const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> update,
+                       unsigned int maxIter, double minRes, double initialRelax):
+NonLinearAlgo(prepare, solve, computeRes, update),
+m_maxIter(maxIter),
+m_minRes(minRes),
+m_initialRelax(initialRelax)
+{
+    if(m_initialRelax <= 0 || m_initialRelax > 1)
+        throw std::runtime_error("the initial Aitken relaxation factor should be in ]0, 1]!");
+
+    if(!m_update)
+        throw std::runtime_error("the Aitken algorithm requires an update function!");
+}
+
+AitkenAlgo::~AitkenAlgo()
+{
+
+}
+
+void AitkenAlgo::displayParams()
+{
+    std::cout << " * Non-linear algorithm: Aitken\n"
+              << " * Initial relaxation factor: " << m_initialRelax << "\n"
+              << " * Maximum residual: " << m_minRes << "\n"
+              << " * Maximum iteration count: " << m_maxIter << std::endl;
+}
+
+bool AitkenAlgo::solve(Mesh* pMesh, const std::vector<Eigen::VectorXd>& qPrevVec, bool verboseOutput)
+{
+    m_prepare(qPrevVec);
+
+    std::vector<Eigen::VectorXd> qIterVec(qPrevVec.size());
+    std::vector<Eigen::VectorXd> qIterPrevVec(qPrevVec.size());
+
+    for(std::size_t i = 0 ; i < qIterVec.size() ; ++i)
+    {
+        qIterVec[i].resize(qPrevVec[i].rows()); qIterVec[i].setZero();
+        qIterPrevVec[i] = qPrevVec[i];
+    }
+
+    //r = g - x where x is the iterate given to the fixed point map and g the iterate it returns
+    Eigen::VectorXd rPrev;
+    double omega = m_initialRelax;
+
+    unsigned int iterCount = 0;
+    double res = std::numeric_limits<double>::max();
+    double resPrev = 0;
+    m_lastIterCount = 0;
+    m_lastContraction = 0;
+    m_lastResidual = 0;
+
+    while(res > m_minRes)
+    {
+        if(verboseOutput && !m_runOnce)
+        {
+            std::cout << " - Aitken algorithm (mesh position) - iteration ("
+                      << iterCount << ")" << std::endl;
+        }
+
+        if(iterCount > m_maxIter)
+        {
+            if(verboseOutput && !m_runOnce)
+            {
+                std::cout << "\t * Iteration count " << iterCount
+                      << " greater than maximum: " << m_maxIter << std::endl;
+            }
+
+            pMesh->restoreNodesList();
+            return false;
+        }
+
+        if(!m_solve(qIterVec, qPrevVec))
+            return false;
+
+        resPrev = res;
+        res = m_computeRes(qIterVec, qIterPrevVec);
+        m_lastIterCount = iterCount + 1;
+        m_lastResidual = res;
+        if(iterCount > 0 && resPrev > 0)
+            m_lastContraction = res/resPrev;
+
+        if(verboseOutput && !m_runOnce)
+            std::cout << "\t * Relative 2-norm of q: " << res << " vs "
+                      << m_minRes << std::endl;
+
+        if(std::isnan(res))
+        {
+            if(verboseOutput)
+                std::cout << "\t * NaN residual" << std::endl;
+
+            pMesh->restoreNodesList();
+            return false;
+        }
+
+        iterCount++;
+
+        if(m_runOnce || res <= m_minRes)
+            break;
+
+        Eigen::VectorXd x = m_stack(qIterPrevVec);
+        Eigen::VectorXd r = m_stack(qIterVec) - x;
+
+        if(rPrev.rows() == r.rows())
+        {
+            Eigen::VectorXd deltaR = r - rPrev;
+            double deltaRNorm2 = deltaR.squaredNorm();
+            if(deltaRNorm2 > 0)
+            {
+                double newOmega = -omega*rPrev.dot(deltaR)/deltaRNorm2;
+                if(std::isfinite(newOmega))
+                    omega = newOmega;
+            }
+        }
+        rPrev = r;
+
+        if(verboseOutput)
+            std::cout << "\t * Relaxation factor: " << omega << std::endl;
+
+        m_unstack(x + omega*r, qIterPrevVec);
+        m_update(qIterPrevVec, qPrevVec);
+    }
+
+    return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef AITKENALGO_HPP_INCLUDED
+#define AITKENALGO_HPP_INCLUDED
+
+#include <functional>
+
+#include "NonLinearAlgo.hpp"
+
+
+/**
+ * \class AitkenAlgo
+ * \brief Represents a Picard non-linear algorithm with Aitken dynamic relaxation
+ *        to solve a Ax = b system of equations.
+ */
+class AitkenAlgo : public NonLinearAlgo
+{
+    public:
+        AitkenAlgo(std::function<void(const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> prepare,
+                   std::function<bool(std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                      const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> solve,
+                   std::function<double(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                        const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes,
+                   std::function<void(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                      const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> update,
+                   unsigned int maxIter, double minRes, double initialRelax);
+
+        ~AitkenAlgo() override;
+
+        void displayParams() override;
+        bool solve(Mesh* pMesh, const std::vector<Eigen::VectorXd>& qPrevVec, bool verboseOutput) override;
+    private:
+        unsigned int m_maxIter;
+        double m_minRes;
+        double m_initialRelax; /**< Relaxation factor of the first iteration of each solve. */
+};
+
+#endif // AITKENALGO_HPP_INCLUDED
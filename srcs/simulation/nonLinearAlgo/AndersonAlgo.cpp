@@ -0,0 +1,172 @@
+#include "AndersonAlgo.hpp"
+
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "../../mesh/Mesh.hpp"
+
+AndersonAlgo::AndersonAlgo(std::function<void(const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> prepare,
+                           std::function<bool(std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                              const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> solve,
+                           std::function<double(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                                const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes,
+                           std::function<void(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                              const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> update,
+                           unsigned int maxIter, double minRes, unsigned int depth):
+NonLinearAlgo(prepare, solve, computeRes, update),
+m_maxIter(maxIter),
+m_minRes(minRes),
+m_depth(depth)
+{
+    if(m_depth == 0)
+        throw std::runtime_error("the Anderson depth should be greater than 0!");
+
+    if(!m_update)
+        throw std::runtime_error("the Anderson algorithm requires an update function!");
+}
+
+AndersonAlgo::~AndersonAlgo()
+{
+
+}
+
+void AndersonAlgo::displayParams()
+{
+    std::cout << " * Non-linear algorithm: Anderson\n"
+              << " * Anderson depth: " << m_depth << "\n"
+              << " * Maximum residual: " << m_minRes << "\n"
+              << " * Maximum iteration count: " << m_maxIter << std::endl;
+}
+
+bool AndersonAlgo::solve(Mesh* pMesh, const std::vector<Eigen::VectorXd>& qPrevVec, bool verboseOutput)
+{
+    m_prepare(qPrevVec);
+
+    std::vector<Eigen::VectorXd> qIterVec(qPrevVec.size());
+    std::vector<Eigen::VectorXd> qIterPrevVec(qPrevVec.size());
+
+    for(std::size_t i = 0 ; i < qIterVec.size() ; ++i)
+    {
+        qIterVec[i].resize(qPrevVec[i].rows()); qIterVec[i].setZero();
+        qIterPrevVec[i] = qPrevVec[i];
+    }
+
+    //x is the iterate given to the fixed point map, g the iterate it returns and f = g - x
+    Eigen::VectorXd gPrev, fPrev;
+    std::deque<Eigen::VectorXd> deltaG;
+    std::deque<Eigen::VectorXd> deltaF;
+
+    unsigned int iterCount = 0;
+    double res = std::numeric_limits<double>::max();
+    double resPrev = 0;
+    m_lastIterCount = 0;
+    m_lastContraction = 0;
+    m_lastResidual = 0;
+
+    while(res > m_minRes)
+    {
+        if(verboseOutput && !m_runOnce)
+        {
+            std::cout << " - Anderson algorithm (mesh position) - iteration ("
+                      << iterCount << ")" << std::endl;
+        }
+
+        if(iterCount > m_maxIter)
+        {
+            if(verboseOutput && !m_runOnce)
+            {
+                std::cout << "\t * Iteration count " << iterCount
+                      << " greater than maximum: " << m_maxIter << std::endl;
+            }
+
+            pMesh->restoreNodesList();
+            return false;
+        }
+
+        if(!m_solve(qIterVec, qPrevVec))
+            return false;
+
+        resPrev = res;
+        res = m_computeRes(qIterVec, qIterPrevVec);
+        m_lastIterCount = iterCount + 1;
+        m_lastResidual = res;
+        if(iterCount > 0 && resPrev > 0)
+            m_lastContraction = res/resPrev;
+
+        if(verboseOutput && !m_runOnce)
+            std::cout << "\t * Relative 2-norm of q: " << res << " vs "
+                      << m_minRes << std::endl;
+
+        if(std::isnan(res))
+        {
+            if(verboseOutput)
+                std::cout << "\t * NaN residual" << std::endl;
+
+            pMesh->restoreNodesList();
+            return false;
+        }
+
+        iterCount++;
+
+        if(m_runOnce || res <= m_minRes)
+            break;
+
+        Eigen::VectorXd x = m_stack(qIterPrevVec);
+        Eigen::VectorXd g = m_stack(qIterVec);
+        Eigen::VectorXd f = g - x;
+
+        if(fPrev.rows() == f.rows())
+        {
+            deltaG.push_back(g - gPrev);
+            deltaF.push_back(f - fPrev);
+
+            if(deltaF.size() > m_depth)
+            {
+                deltaG.pop_front();
+                deltaF.pop_front();
+            }
+        }
+
+        gPrev = g;
+        fPrev = f;
+
+        if(deltaF.empty())
+        {
+            //Plain Picard step, the mesh already holds g
+            for(std::size_t i = 0 ; i < qIterVec.size() ; ++i)
+                qIterPrevVec[i] = qIterVec[i];
+
+            continue;
+        }
+
+        Eigen::MatrixXd dF(f.rows(), deltaF.size());
+        Eigen::MatrixXd dG(g.rows(), deltaG.size());
+        for(std::size_t j = 0 ; j < deltaF.size() ; ++j)
+        {
+            dF.col(static_cast<Eigen::Index>(j)) = deltaF[j];
+            dG.col(static_cast<Eigen::Index>(j)) = deltaG[j];
+        }
+
+        Eigen::VectorXd gamma = dF.colPivHouseholderQr().solve(f);
+        Eigen::VectorXd xNext = g - dG*gamma;
+
+        if(!xNext.allFinite())
+        {
+            //Ill-conditioned history, restart from a plain Picard step
+            deltaG.clear();
+            deltaF.clear();
+            for(std::size_t i = 0 ; i < qIterVec.size() ; ++i)
+                qIterPrevVec[i] = qIterVec[i];
+
+            continue;
+        }
+
+        m_unstack(xNext, qIterPrevVec);
+        m_update(qIterPrevVec, qPrevVec);
+    }
+
+    return true;
+}
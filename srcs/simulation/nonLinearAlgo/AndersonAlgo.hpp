@@ -0,0 +1,37 @@
+#pragma once
+#ifndef ANDERSONALGO_HPP_INCLUDED
+#define ANDERSONALGO_HPP_INCLUDED
+
+#include <functional>
+
+#include "NonLinearAlgo.hpp"
+
+
+/**
+ * \class AndersonAlgo
+ * \brief Represents a Picard non-linear algorithm accelerated with Anderson mixing over
+ *        the last iterates to solve a Ax = b system of equations.
+ */
+class AndersonAlgo : public NonLinearAlgo
+{
+    public:
+        AndersonAlgo(std::function<void(const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> prepare,
+                     std::function<bool(std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                        const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> solve,
+                     std::function<double(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                          const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes,
+                     std::function<void(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                        const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> update,
+                     unsigned int maxIter, double minRes, unsigned int depth);
+
+        ~AndersonAlgo() override;
+
+        void displayParams() override;
+        bool solve(Mesh* pMesh, const std::vector<Eigen::VectorXd>& qPrevVec, bool verboseOutput) override;
+    private:
+        unsigned int m_maxIter;
+        double m_minRes;
+        unsigned int m_depth; /**< Number of previous iterates used in the mixing. */
+};
+
+#endif // ANDERSONALGO_HPP_INCLUDED
@@ -6,10 +6,13 @@ NonLinearAlgo::NonLinearAlgo(std::function<void(const std::vector<Eigen::VectorX
                              std::function<bool(std::vector<Eigen::VectorXd>& /** qIterVec **/,
                                                 const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> solve,
                              std::function<double(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
-                                                  const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes):
+                                                  const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes,
+                             std::function<void(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                                const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> update):
 m_prepare(prepare),
 m_solve(solve),
-m_computeRes(computeRes)
+m_computeRes(computeRes),
+m_update(update)
 {
 
 }
@@ -32,3 +35,30 @@ bool NonLinearAlgo::solve(Mesh* pMesh, const std::vector<Eigen::VectorXd>& qPrev
     throw std::runtime_error("Unimplemented function by the child class -> NonLinearAlgo::solve(pMesh, qPrev)");
 }
 
+
+Eigen::VectorXd NonLinearAlgo::m_stack(const std::vector<Eigen::VectorXd>& qVec) const
+{
+    Eigen::Index size = 0;
+    for(const auto& q : qVec)
+        size += q.rows();
+
+    Eigen::VectorXd qStack(size);
+    Eigen::Index offset = 0;
+    for(const auto& q : qVec)
+    {
+        qStack.segment(offset, q.rows()) = q;
+        offset += q.rows();
+    }
+
+    return qStack;
+}
+
+void NonLinearAlgo::m_unstack(const Eigen::VectorXd& q, std::vector<Eigen::VectorXd>& qVec) const
+{
+    Eigen::Index offset = 0;
+    for(auto& qi : qVec)
+    {
+        qi = q.segment(offset, qi.rows());
+        offset += qi.rows();
+    }
+}
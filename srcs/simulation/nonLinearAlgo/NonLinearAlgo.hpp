@@ -19,7 +19,9 @@ class NonLinearAlgo
                       std::function<bool(std::vector<Eigen::VectorXd>& /** qIterVec **/,
                                          const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> solve,
                       std::function<double(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
-                                           const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes);
+                                           const std::vector<Eigen::VectorXd>& /** qIterPrevVec **/)> computeRes,
+                      std::function<void(const std::vector<Eigen::VectorXd>& /** qIterVec **/,
+                                         const std::vector<Eigen::VectorXd>& /** qPrevVec **/)> update = nullptr);
 
         virtual ~NonLinearAlgo();
 
@@ -30,8 +32,29 @@ class NonLinearAlgo
             m_runOnce = runOnce;
         }
 
+        /// \return The number of iterations done during the last call to solve.
+        unsigned int getLastIterCount() const noexcept
+        {
+            return m_lastIterCount;
+        }
+
+        /// \return The ratio between the two last residuals of the last call to solve (0 if only one iteration was done).
+        double getLastContraction() const noexcept
+        {
+            return m_lastContraction;
+        }
+
+        /// \return The last residual computed during the last call to solve (0 if none was computed).
+        double getLastResidual() const noexcept
+        {
+            return m_lastResidual;
+        }
+
     protected:
         bool m_runOnce = false;
+        unsigned int m_lastIterCount = 0;
+        double m_lastContraction = 0;
+        double m_lastResidual = 0;
         std::function<void(const std::vector<Eigen::VectorXd>&)> m_prepare;
 
         std::function<bool(std::vector<Eigen::VectorXd>&,
@@ -39,6 +62,20 @@ class NonLinearAlgo
 
         std::function<double(const std::vector<Eigen::VectorXd>&,
                              const std::vector<Eigen::VectorXd>&)> m_computeRes;
+
+        /** Push an iterate which was not produced by m_solve (e.g. a relaxed one) to the mesh
+         *  and rebuild what the next call to m_solve requires. */
+        std::function<void(const std::vector<Eigen::VectorXd>&,
+                           const std::vector<Eigen::VectorXd>&)> m_update;
+
+        /// \param qVec The vector of unknowns vectors.
+        /// \return All the unknowns vectors stacked in one vector.
+        Eigen::VectorXd m_stack(const std::vector<Eigen::VectorXd>& qVec) const;
+
+        /// \brief Split a stacked vector back into the unknowns vectors (which must already have the right sizes).
+        /// \param q The stacked vector.
+        /// \param qVec The vector of unknowns vectors.
+        void m_unstack(const Eigen::VectorXd& q, std::vector<Eigen::VectorXd>& qVec) const;
 };
 
 #endif // NONLINEARALGO_HPP_INCLUDED
@@ -24,7 +24,8 @@ PicardAlgo::~PicardAlgo()
 
 void PicardAlgo::displayParams()
 {
-    std::cout << " * Maximum residual: " << m_minRes << "\n"
+    std::cout << " * Non-linear algorithm: Picard\n"
+              << " * Maximum residual: " << m_minRes << "\n"
               << " * Maximum iteration count: " << m_maxIter << std::endl;
 }
 
@@ -43,6 +44,10 @@ bool PicardAlgo::solve(Mesh* pMesh, const std::vector<Eigen::VectorXd>& qPrevVec
 
     unsigned int iterCount = 0;
     double res = std::numeric_limits<double>::max();
+    double resPrev = 0;
+    m_lastIterCount = 0;
+    m_lastContraction = 0;
+    m_lastResidual = 0;
 
     while(res > m_minRes)
     {
@@ -67,7 +72,12 @@ bool PicardAlgo::solve(Mesh* pMesh, const std::vector<Eigen::VectorXd>& qPrevVec
         if(!m_solve(qIterVec, qPrevVec))
             return false;
 
+        resPrev = res;
         res = m_computeRes(qIterVec, qIterPrevVec);
+        m_lastIterCount = iterCount + 1;
+        m_lastResidual = res;
+        if(iterCount > 0 && resPrev > 0)
+            m_lastContraction = res/resPrev;
 
         if(verboseOutput && !m_runOnce)
             std::cout << "\t * Relative 2-norm of q: " << res << " vs "
@@ -12,7 +12,7 @@
 #endif
 
 #include "../../Equation.hpp"
-#include "../../nonLinearAlgo/PicardAlgo.hpp"
+#include "../../nonLinearAlgo/NonLinearAlgo.hpp"
 
 class Problem;
 class Mesh;
@@ -32,6 +32,10 @@ class HeatEqIncompNewton : public Equation
 
         void displayParams() const override;
 
+        MemoryUsage getMemoryUsage() const override;
+
+        const NonLinearAlgo* getNonLinearAlgo() const noexcept override;
+
         bool solve() override;
 
     private:
@@ -43,9 +47,10 @@ class HeatEqIncompNewton : public Equation
 
         std::unique_ptr<MatrixBuilder<dim>> m_pMatBuilder; /**< Class responsible of building the required matrices. */
         std::unique_ptr<MatrixBuilder<dim>> m_pMatBuilder2; /**< Class responsible of building the required matrices. */
-        std::unique_ptr<PicardAlgo> m_pPicardAlgo;
+        std::unique_ptr<NonLinearAlgo> m_pNonLinearAlgo;
         Eigen::SparseMatrix<double> m_A;
         Eigen::VectorXd m_b;
+        bool m_isAbOutdated = false;    /**< Was the temperature changed since m_A and m_b were assembled ? */
         EigenSparseSolver m_solver;
         Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper> m_solverIt;
 
@@ -109,42 +109,68 @@ Equation(pProblem, pSolver, pMesh, solverParams, materialParams, bcFlags, states
     else
         throw std::runtime_error("unknown residual type: " + residual);
 
-    m_pPicardAlgo = std::make_unique<PicardAlgo>([&](const auto& qPrevVec){
-        m_clock.start();
-        m_A.resize(qPrevVec[0].rows(), qPrevVec[0].rows());
-        m_b.resize(qPrevVec[0].rows()); m_b.setZero();
-        m_accumalatedTimes["Prepare Picard Algo"] += m_clock.end();
+    m_pNonLinearAlgo = m_buildNonLinearAlgo([&](const auto& qPrevVec){
+        {
+            PROFILE_SCOPE("Prepare Picard Algo");
+            m_A.resize(qPrevVec[0].rows(), qPrevVec[0].rows());
+            m_b.resize(qPrevVec[0].rows()); m_b.setZero();
+        }
 
-        m_clock.start();
-        m_pMesh->saveNodesList();
-        m_accumalatedTimes["Save/restore nodeslist"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Save/restore nodeslist");
+            m_pMesh->saveNodesList();
+        }
 
         m_buildAb(qPrevVec[0]);
-        m_clock.start();
-        m_applyBC(qPrevVec[0]);
-        m_accumalatedTimes["Apply boundary conditions"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Apply boundary conditions");
+            m_applyBC(qPrevVec[0]);
+        }
+        m_isAbOutdated = false;
     },
     [&](auto& qIterVec, const auto& qPrevVec){
-        m_clock.start();
-        m_solverIt.compute(m_A);
-        m_accumalatedTimes["Compute matrix"] += m_clock.end();
+        //The system is only assembled once per iteration, for the temperature currently held by the mesh
+        if(m_isAbOutdated)
+        {
+            m_buildAb(qPrevVec[0]);
+            {
+                PROFILE_SCOPE("Apply boundary conditions");
+                m_applyBC(qPrevVec[0]);
+            }
+            m_isAbOutdated = false;
+        }
+
+        {
+            PROFILE_SCOPE("Compute matrix");
+            m_solverIt.compute(m_A);
+        }
 
         if(m_solverIt.info() == Eigen::Success)
         {
-            m_clock.start();
-            qIterVec[0] = m_solverIt.solveWithGuess(m_b, qPrevVec[0]);
-            m_accumalatedTimes["Solve system"] += m_clock.end();
+            {
+                PROFILE_SCOPE("Solve system");
+                qIterVec[0] = m_solverIt.solveWithGuess(m_b, qPrevVec[0]);
+                m_linearIterCount += static_cast<std::size_t>(m_solverIt.iterations());
+            }
 
-            m_clock.start();
-            setNodesStatesfromQ(m_pMesh, qIterVec[0], m_statesIndex[0], m_statesIndex[0]);
-            m_accumalatedTimes["Update solution"] += m_clock.end();
+            {
+                PROFILE_SCOPE("Update solution");
+                setNodesStatesfromQ(m_pMesh, qIterVec[0], m_statesIndex[0], m_statesIndex[0]);
+            }
 
+            //The Ax_f residual needs the system of the new iterate, otherwise it is assembled by the next iteration
             if(m_phaseChange)
             {
-                m_buildAb(qPrevVec[0]);
-                m_clock.start();
-                m_applyBC(qPrevVec[0]);
-                m_accumalatedTimes["Apply boundary conditions"] += m_clock.end();
+                if(m_residual == Res::Ax_f)
+                {
+                    m_buildAb(qPrevVec[0]);
+                    {
+                        PROFILE_SCOPE("Apply boundary conditions");
+                        m_applyBC(qPrevVec[0]);
+                    }
+                }
+                else
+                    m_isAbOutdated = true;
             }
             return true;
         }
@@ -152,14 +178,15 @@ Equation(pProblem, pSolver, pMesh, solverParams, materialParams, bcFlags, states
         {
             if(m_pProblem->isOutputVerbose())
                 std::cout << "\t * The Eigen::SparseLU solver failed to factorize the A matrix!" << std::endl;
-            m_clock.start();
-            m_pMesh->restoreNodesList();
-            m_accumalatedTimes["Save/restore nodeslist"] += m_clock.end();
+            {
+                PROFILE_SCOPE("Save/restore nodeslist");
+                m_pMesh->restoreNodesList();
+            }
             return false;
         }
     },
     [&](const auto& qIterVec, const auto& qIterPrevVec) -> double {
-        m_clock.start();
+        PROFILE_SCOPE("Compute Picard Algo residual");
         Mesh* p_Mesh = this->m_pMesh;
 
         if(m_residual == Res::T)
@@ -181,7 +208,6 @@ Equation(pProblem, pSolver, pMesh, solverParams, materialParams, bcFlags, states
                 res = std::numeric_limits<double>::max();
             else
                 res = std::sqrt(num/den);
-            m_accumalatedTimes["Compute Picard Algo residual"] += m_clock.end();
             return res;
         }
         else
@@ -189,10 +215,21 @@ Equation(pProblem, pSolver, pMesh, solverParams, materialParams, bcFlags, states
             return (m_A*qIterVec[0] - m_b).norm();
         }
 
+    },
+    [&](const auto& qIterVec, const auto& qPrevVec){
+        (void) qPrevVec;
+        {
+            PROFILE_SCOPE("Update solution");
+            setNodesStatesfromQ(m_pMesh, qIterVec[0], m_statesIndex[0], m_statesIndex[0]);
+        }
+
+        //Assembled by the next call to the solve function
+        if(m_phaseChange)
+            m_isAbOutdated = true;
     }, maxIter, minRes);
 
     if(!m_phaseChange)
-        m_pPicardAlgo->runOnlyOnce(true); //When k, cv independant of T, no need of Picard
+        m_pNonLinearAlgo->runOnlyOnce(true); //When k, cv independant of T, no need of Picard
 
     m_needNormalCurv = true;
 }
@@ -210,7 +247,22 @@ void HeatEqIncompNewton<dim>::displayParams() const
               << " * Specific heat capacity: " << m_cv << " J/(kg K)\n"
               << " * Heat conduction: " << m_k << " W/(mK)" << std::endl;
 
-    m_pPicardAlgo->displayParams();
+    m_pNonLinearAlgo->displayParams();
+}
+
+template<unsigned short dim>
+MemoryUsage HeatEqIncompNewton<dim>::getMemoryUsage() const
+{
+    MemoryUsage usage = Equation::getMemoryUsage();
+    usage.matrices = getMemorySize(m_A) + getMemorySize(m_b);
+
+    return usage;
+}
+
+template<unsigned short dim>
+const NonLinearAlgo* HeatEqIncompNewton<dim>::getNonLinearAlgo() const noexcept
+{
+    return m_pNonLinearAlgo.get();
 }
 
 template<unsigned short dim>
@@ -220,7 +272,7 @@ bool HeatEqIncompNewton<dim>::solve()
         std::cout << "Heat Equation" << std::endl;
 
     std::vector<Eigen::VectorXd> qPrevVec = {getQFromNodesStates(m_pMesh, m_statesIndex[0], m_statesIndex[0])};
-    return m_pPicardAlgo->solve(m_pMesh, qPrevVec, m_pProblem->isOutputVerbose());
+    return m_pNonLinearAlgo->solve(m_pMesh, qPrevVec, m_pProblem->isOutputVerbose());
 }
 
 template<unsigned short dim>
@@ -315,6 +367,8 @@ void HeatEqIncompNewton<dim>::m_buildAb(const Eigen::VectorXd& qPrev)
         //std::cout << doublet.first << ", " << doublet.second << std::endl;
         m_b[doublet.first] += doublet.second;
     }
+
+    m_assemblyMemory = getMemorySize(indexA) + getMemorySize(indexb);
 }
 
 template<unsigned short dim>
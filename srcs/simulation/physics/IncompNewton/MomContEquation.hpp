@@ -12,7 +12,7 @@
 #endif
 
 #include "../../Equation.hpp"
-#include "../../nonLinearAlgo/PicardAlgo.hpp"
+#include "../../nonLinearAlgo/NonLinearAlgo.hpp"
 
 class Problem;
 class Mesh;
@@ -32,6 +32,10 @@ class MomContEqIncompNewton : public Equation
 
         void displayParams() const override;
 
+        MemoryUsage getMemoryUsage() const override;
+
+        const NonLinearAlgo* getNonLinearAlgo() const noexcept override;
+
         bool solve() override;
 
     private:
@@ -44,7 +48,7 @@ class MomContEqIncompNewton : public Equation
 
         std::unique_ptr<MatrixBuilder<dim>> m_pMatBuilder; /**< Class responsible of building the required matrices. */
         std::unique_ptr<MatrixBuilder<dim>> m_pMatBuilder2; /**< Class responsible of building the required matrices. */
-        std::unique_ptr<PicardAlgo> m_pPicardAlgo;
+        std::unique_ptr<NonLinearAlgo> m_pNonLinearAlgo;
         EigenSparseSolver m_solver;
         Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper> m_solverIt;
         Res m_residual;
@@ -69,8 +73,9 @@ class MomContEqIncompNewton : public Equation
         //PSPG
         Eigen::SparseMatrix<double> m_A;
         Eigen::VectorXd m_b;
+        bool m_isAbOutdated = false;    /**< Were the nodes moved since m_A and m_b were assembled ? */
 
-        void m_setupPicardPSPG(unsigned int maxIter, double minRes);
+        void m_setupNonLinearAlgoPSPG(unsigned int maxIter, double minRes);
 
         void m_buildAbPSPG(const Eigen::VectorXd& qPrev);
         void m_applyBCPSPG(const Eigen::VectorXd& qPrev);
@@ -87,7 +92,7 @@ class MomContEqIncompNewton : public Equation
         Eigen::VectorXd m_bPcorrStep;
         Eigen::VectorXd m_bVStep;
 
-        void m_setupPicardFracStep(unsigned int maxIter, double minRes);
+        void m_setupNonLinearAlgoFracStep(unsigned int maxIter, double minRes);
 
         void m_buildMatFracStep(const std::vector<Eigen::VectorXd>& qPrev);
         void m_buildMatPcorrStep(const Eigen::VectorXd& qVTilde, const Eigen::VectorXd& qPprev);
@@ -244,11 +244,11 @@ Equation(pProblem, pSolver, pMesh, solverParams, materialParams, bcFlags, states
 
     if(m_pSolver->getID() == "PSPG")
     {
-        m_setupPicardPSPG(maxIter, minRes);
+        m_setupNonLinearAlgoPSPG(maxIter, minRes);
     }
     else if(m_pSolver->getID() == "FracStep")
     {
-        m_setupPicardFracStep(maxIter, minRes);
+        m_setupNonLinearAlgoFracStep(maxIter, minRes);
     }
 
 
@@ -280,7 +280,25 @@ void MomContEqIncompNewton<dim>::displayParams() const
     else if constexpr (dim == 3)
         std::cout << " * Body force: (" << m_bodyForce[0] << ", " << m_bodyForce[1] << "," << m_bodyForce[2] << ")" << std::endl;
 
-    m_pPicardAlgo->displayParams();
+    m_pNonLinearAlgo->displayParams();
+}
+
+template<unsigned short dim>
+MemoryUsage MomContEqIncompNewton<dim>::getMemoryUsage() const
+{
+    MemoryUsage usage = Equation::getMemoryUsage();
+    usage.matrices = getMemorySize(m_A) + getMemorySize(m_b) +
+                     getMemorySize(m_M) + getMemorySize(m_MK_dt) + getMemorySize(m_L) +
+                     getMemorySize(m_DTelm) + getMemorySize(m_Lelm) +
+                     getMemorySize(m_bVAppStep) + getMemorySize(m_bPcorrStep) + getMemorySize(m_bVStep);
+
+    return usage;
+}
+
+template<unsigned short dim>
+const NonLinearAlgo* MomContEqIncompNewton<dim>::getNonLinearAlgo() const noexcept
+{
+    return m_pNonLinearAlgo.get();
 }
 
 template<unsigned short dim>
@@ -291,18 +309,18 @@ bool MomContEqIncompNewton<dim>::solve()
 
     if(m_pSolver->getID() == "PSPG")
     {
-        m_clock.start();
+        PROFILE_TIMER(updateSolutionsTimer, "Update solutions");
         std::vector<Eigen::VectorXd> qPrev = {getQFromNodesStates(m_pMesh, m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim())};
-        m_accumalatedTimes["Update solutions"] += m_clock.end();
-        return m_pPicardAlgo->solve(m_pMesh, qPrev, m_pProblem->isOutputVerbose());
+        updateSolutionsTimer.stop();
+        return m_pNonLinearAlgo->solve(m_pMesh, qPrev, m_pProblem->isOutputVerbose());
     }
     else if(m_pSolver->getID() == "FracStep")
     {
-        m_clock.start();
+        PROFILE_TIMER(updateSolutionsTimer, "Update solutions");
         std::vector<Eigen::VectorXd> qPrev = {getQFromNodesStates(m_pMesh, m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim() - 1),
                                               getQFromNodesStates(m_pMesh, m_pMesh->getDim(), m_pMesh->getDim())};
-        m_accumalatedTimes["Update solutions"] += m_clock.end();
-        return m_pPicardAlgo->solve(m_pMesh, qPrev, m_pProblem->isOutputVerbose());
+        updateSolutionsTimer.stop();
+        return m_pNonLinearAlgo->solve(m_pMesh, qPrev, m_pProblem->isOutputVerbose());
     }
 
     return false;
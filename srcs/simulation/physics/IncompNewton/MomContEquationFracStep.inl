@@ -7,7 +7,7 @@
 template<unsigned short dim>
 void MomContEqIncompNewton<dim>::m_buildMatFracStep(const std::vector<Eigen::VectorXd>& qPrev)
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatricesAssemblyTimer, "Prepare matrices assembly");
     constexpr unsigned short nodPerEl = dim + 1;
     constexpr unsigned int tripletPerElmM = (dim*nodPerEl*nodPerEl);
     unsigned int tripletPerElmMKDT = (dim*nodPerEl*nodPerEl + dim*nodPerEl*dim*nodPerEl);
@@ -26,178 +26,185 @@ void MomContEqIncompNewton<dim>::m_buildMatFracStep(const std::vector<Eigen::Vec
     std::vector<std::pair<std::size_t, double>> indexbVappStep(doubletPerElm*nElm); m_bVAppStep.setZero();
     m_DTelm.resize(nElm);
     m_Lelm.resize(nElm);
-    m_accumalatedTimes["Prepare matrices assembly"] += m_clock.end();
+    prepareMatricesAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < nElm ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
-
-        GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
-        BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
-        auto Me_s = m_pMatBuilder->getM(element);
-        auto Me_dt_s = static_cast<Eigen::Matrix<double, nodPerEl, nodPerEl>>((1/dt)*Me_s);
-        auto Me = MatrixBuilder<dim>::diagBlock(Me_s);
-        auto Me_dt = MatrixBuilder<dim>::diagBlock(Me_dt_s);
-        auto Ke = m_pMatBuilder->getK(element, Be);
-        m_DTelm[elm] = m_pMatBuilder->getD(element, Be).transpose();
-        m_Lelm[elm] = m_pMatBuilder->getL(element, Be, gradNe);
-        auto Fe = m_pMatBuilder->getF(element, m_bodyForce, Be);
-
-        Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me2;
-
-        if(m_phaseChange)
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < nElm ; ++elm)
         {
-            Eigen::Matrix<double, nodPerEl, nodPerEl> Me2_s = m_pMatBuilder2->getM(element);
-            Me2 = MatrixBuilder<dim>::diagBlock(Me2_s);
-        }
-
-        auto vPrev = getElementVecState<dim>(qPrev[0], element, 0, nNodes);
-        auto pPrev = getElementState<dim>(qPrev[1], element, 0, nNodes);
+            const Element& element = m_pMesh->getElement(elm);
+
+            GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
+            BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
+            auto Me_s = m_pMatBuilder->getM(element);
+            auto Me_dt_s = static_cast<Eigen::Matrix<double, nodPerEl, nodPerEl>>((1/dt)*Me_s);
+            auto Me = MatrixBuilder<dim>::diagBlock(Me_s);
+            auto Me_dt = MatrixBuilder<dim>::diagBlock(Me_dt_s);
+            auto Ke = m_pMatBuilder->getK(element, Be);
+            m_DTelm[elm] = m_pMatBuilder->getD(element, Be).transpose();
+            m_Lelm[elm] = m_pMatBuilder->getL(element, Be, gradNe);
+            auto Fe = m_pMatBuilder->getF(element, m_bodyForce, Be);
+
+            Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me2;
+
+            if(m_phaseChange)
+            {
+                Eigen::Matrix<double, nodPerEl, nodPerEl> Me2_s = m_pMatBuilder2->getM(element);
+                Me2 = MatrixBuilder<dim>::diagBlock(Me2_s);
+            }
 
-        auto MvPreve_dt = Me_dt*vPrev;
-        auto DTpPreve = m_gammaFS*m_DTelm[elm]*pPrev;
+            auto vPrev = getElementVecState<dim>(qPrev[0], element, 0, nNodes);
+            auto pPrev = getElementState<dim>(qPrev[1], element, 0, nNodes);
 
-        std::size_t countM = 0;
-        std::size_t countMK_dt = 0;
-        std::size_t countL = 0;
-        std::size_t countbVappStep = 0;
+            auto MvPreve_dt = Me_dt*vPrev;
+            auto DTpPreve = m_gammaFS*m_DTelm[elm]*pPrev;
 
-        for(unsigned short i = 0 ; i < nodPerEl ; ++i)
-        {
-            const Node& ni = m_pMesh->getNode(element.getNodeIndex(i));
+            std::size_t countM = 0;
+            std::size_t countMK_dt = 0;
+            std::size_t countL = 0;
+            std::size_t countbVappStep = 0;
 
-            for(unsigned short j = 0 ; j < nodPerEl ; ++j)
+            for(unsigned short i = 0 ; i < nodPerEl ; ++i)
             {
-                for(unsigned short d = 0 ; d < dim ; ++d)
+                const Node& ni = m_pMesh->getNode(element.getNodeIndex(i));
+
+                for(unsigned short j = 0 ; j < nodPerEl ; ++j)
                 {
-                    /********************************************************************
-                                                 Build M and M/dt
-                    ********************************************************************/
-                    if(!(ni.isBound() || ni.isFree()))
+                    for(unsigned short d = 0 ; d < dim ; ++d)
                     {
-                        indexM[tripletPerElmM*elm + countM] =
-                            Eigen::Triplet<double>(element.getNodeIndex(i) + d*nNodes,
-                                                   element.getNodeIndex(j) + d*nNodes,
-                                                   Me(i + d*nodPerEl, j + d*nodPerEl));
-
-                        indexMK_dt[tripletPerElmMKDT*elm + countMK_dt] =
-                            Eigen::Triplet<double>(element.getNodeIndex(i) + d*nNodes,
-                                                   element.getNodeIndex(j) + d*nNodes,
-                                                   Me_dt(i + d*nodPerEl, j + d*nodPerEl));
-
-                        if(m_phaseChange)
+                        /********************************************************************
+                                                     Build M and M/dt
+                        ********************************************************************/
+                        if(!(ni.isBound() || ni.isFree()))
                         {
-                            countMK_dt++;
+                            indexM[tripletPerElmM*elm + countM] =
+                                Eigen::Triplet<double>(element.getNodeIndex(i) + d*nNodes,
+                                                       element.getNodeIndex(j) + d*nNodes,
+                                                       Me(i + d*nodPerEl, j + d*nodPerEl));
+
                             indexMK_dt[tripletPerElmMKDT*elm + countMK_dt] =
                                 Eigen::Triplet<double>(element.getNodeIndex(i) + d*nNodes,
                                                        element.getNodeIndex(j) + d*nNodes,
-                                                       Me2(i + d*nodPerEl, j + d*nodPerEl));
+                                                       Me_dt(i + d*nodPerEl, j + d*nodPerEl));
+
+                            if(m_phaseChange)
+                            {
+                                countMK_dt++;
+                                indexMK_dt[tripletPerElmMKDT*elm + countMK_dt] =
+                                    Eigen::Triplet<double>(element.getNodeIndex(i) + d*nNodes,
+                                                           element.getNodeIndex(j) + d*nNodes,
+                                                           Me2(i + d*nodPerEl, j + d*nodPerEl));
+                            }
                         }
-                    }
 
-                    countM++;
-                    countMK_dt++;
-
-                    /********************************************************************
-                                                  Build K
-                    ********************************************************************/
-                    for(unsigned short d2 = 0 ; d2 < dim ; ++d2)
-                    {
+                        countM++;
+                        countMK_dt++;
 
-                        if(!(ni.isBound() || ni.isFree()))
+                        /********************************************************************
+                                                      Build K
+                        ********************************************************************/
+                        for(unsigned short d2 = 0 ; d2 < dim ; ++d2)
                         {
-                            indexMK_dt[tripletPerElmMKDT*elm + countMK_dt] =
-                                Eigen::Triplet<double>(element.getNodeIndex(i) + d*nNodes,
-                                                       element.getNodeIndex(j) + d2*nNodes,
-                                                       Ke(i + d*nodPerEl, j + d2*nodPerEl));
+
+                            if(!(ni.isBound() || ni.isFree()))
+                            {
+                                indexMK_dt[tripletPerElmMKDT*elm + countMK_dt] =
+                                    Eigen::Triplet<double>(element.getNodeIndex(i) + d*nNodes,
+                                                           element.getNodeIndex(j) + d2*nNodes,
+                                                           Ke(i + d*nodPerEl, j + d2*nodPerEl));
+                            }
+                            countMK_dt++;
                         }
-                        countMK_dt++;
                     }
-                }
 
-                /********************************************************************
-                                            Build L
-                ********************************************************************/
-                if(!ni.isFree())
-                {
-                    indexL[tripletPerElmDtL*elm + countL] =
-                        Eigen::Triplet<double>(element.getNodeIndex(i),
-                                               element.getNodeIndex(j),
-                                               m_Lelm[elm](i,j));
+                    /********************************************************************
+                                                Build L
+                    ********************************************************************/
+                    if(!ni.isFree())
+                    {
+                        indexL[tripletPerElmDtL*elm + countL] =
+                            Eigen::Triplet<double>(element.getNodeIndex(i),
+                                                   element.getNodeIndex(j),
+                                                   m_Lelm[elm](i,j));
+                    }
+                    countL++;
                 }
-                countL++;
-            }
 
-            /************************************************************************
-                                              Build f
-            ************************************************************************/
-            for(unsigned short d = 0 ; d < dim ; ++d)
-            {
-                if(!(ni.isBound() || ni.isFree()))
+                /************************************************************************
+                                                  Build f
+                ************************************************************************/
+                for(unsigned short d = 0 ; d < dim ; ++d)
                 {
-                    indexbVappStep[doubletPerElm*elm + countbVappStep] = std::make_pair(element.getNodeIndex(i) + d*nNodes, Fe(i + d*nodPerEl));
-                    countbVappStep++;
+                    if(!(ni.isBound() || ni.isFree()))
+                    {
+                        indexbVappStep[doubletPerElm*elm + countbVappStep] = std::make_pair(element.getNodeIndex(i) + d*nNodes, Fe(i + d*nodPerEl));
+                        countbVappStep++;
 
-                    indexbVappStep[doubletPerElm*elm + countbVappStep] = std::make_pair(element.getNodeIndex(i) + d*nNodes, MvPreve_dt(i + d*nodPerEl));
-                    countbVappStep++;
+                        indexbVappStep[doubletPerElm*elm + countbVappStep] = std::make_pair(element.getNodeIndex(i) + d*nNodes, MvPreve_dt(i + d*nodPerEl));
+                        countbVappStep++;
 
-                    indexbVappStep[doubletPerElm*elm + countbVappStep] = std::make_pair(element.getNodeIndex(i) + d*nNodes, DTpPreve(i + d*nodPerEl));
-                    countbVappStep++;
+                        indexbVappStep[doubletPerElm*elm + countbVappStep] = std::make_pair(element.getNodeIndex(i) + d*nNodes, DTpPreve(i + d*nodPerEl));
+                        countbVappStep++;
+                    }
                 }
             }
         }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
     }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
 
     //Best would be to know the number of nodes in which case :/
     //This can still be fasten using OpenMP but will never be as good as using []
     //with preallocated memory
-    m_clock.start();
-    for(std::size_t n = 0 ; n < nNodes ; ++n)
     {
-        const Node& node = m_pMesh->getNode(n);
-
-        if(node.isFree())
+        PROFILE_SCOPE("Push back (n, n, 1)");
+        for(std::size_t n = 0 ; n < nNodes ; ++n)
         {
-            indexL.push_back(Eigen::Triplet<double>(n, n, 1));
-        }
+            const Node& node = m_pMesh->getNode(n);
 
-        if(node.isBound() || node.isFree())
-        {
-            for(unsigned short d = 0 ; d < dim ; ++d)
+            if(node.isFree())
             {
-                indexMK_dt.push_back(Eigen::Triplet<double>(n + d*nNodes,
+                indexL.push_back(Eigen::Triplet<double>(n, n, 1));
+            }
+
+            if(node.isBound() || node.isFree())
+            {
+                for(unsigned short d = 0 ; d < dim ; ++d)
+                {
+                    indexMK_dt.push_back(Eigen::Triplet<double>(n + d*nNodes,
+                                                                n + d*nNodes,
+                                                                1));
+
+                    indexM.push_back(Eigen::Triplet<double>(n + d*nNodes,
                                                             n + d*nNodes,
                                                             1));
-
-                indexM.push_back(Eigen::Triplet<double>(n + d*nNodes,
-                                                        n + d*nNodes,
-                                                        1));
+                }
             }
         }
     }
-    m_accumalatedTimes["Push back (n, n, 1)"] += m_clock.end();
 
     /********************************************************************************
                                         Compute A and b
     ********************************************************************************/
-    m_clock.start();
-    m_M.setFromTriplets(indexM.begin(), indexM.end());
-    m_MK_dt.setFromTriplets(indexMK_dt.begin(), indexMK_dt.end());
-    m_L.setFromTriplets(indexL.begin(), indexL.end());
-    m_accumalatedTimes["Assemble matrices"] += m_clock.end();
-
-    m_clock.start();
-    for(const auto& doublet : indexbVappStep)
     {
-        //std::cout << doublet.first << ", " << doublet.second << std::endl;
-        m_bVAppStep[doublet.first] += doublet.second;
+        PROFILE_SCOPE("Assemble matrices");
+        m_M.setFromTriplets(indexM.begin(), indexM.end());
+        m_MK_dt.setFromTriplets(indexMK_dt.begin(), indexMK_dt.end());
+        m_L.setFromTriplets(indexL.begin(), indexL.end());
+    }
+
+    {
+        PROFILE_SCOPE("Assemble b v app step");
+        for(const auto& doublet : indexbVappStep)
+        {
+            //std::cout << doublet.first << ", " << doublet.second << std::endl;
+            m_bVAppStep[doublet.first] += doublet.second;
+        }
     }
-    m_accumalatedTimes["Assemble b v app step"] += m_clock.end();
+
+    m_assemblyMemory = getMemorySize(indexM) + getMemorySize(indexMK_dt) + getMemorySize(indexL) +
+                       getMemorySize(indexbVappStep);
 }
 
 template<unsigned short dim>
@@ -291,7 +298,7 @@ void MomContEqIncompNewton<dim>::m_applyBCVAppStep(const Eigen::VectorXd& qPrev)
 template<unsigned short dim>
 void MomContEqIncompNewton<dim>::m_buildMatPcorrStep(const Eigen::VectorXd& qVTilde, const Eigen::VectorXd& qPprev)
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatricesAssemblyTimer, "Prepare matrices assembly");
     constexpr unsigned short nodPerEl = dim + 1;
     constexpr unsigned int doubletPerElm = 2*nodPerEl;
 
@@ -301,48 +308,50 @@ void MomContEqIncompNewton<dim>::m_buildMatPcorrStep(const Eigen::VectorXd& qVTi
     const double dt = m_pSolver->getTimeStep();
 
     std::vector<std::pair<std::size_t, double>> indexbPcorrStep(doubletPerElm*nElm); m_bPcorrStep.setZero();
-    m_accumalatedTimes["Prepare matrices assembly"] += m_clock.end();
+    prepareMatricesAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < nElm ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < nElm ; ++elm)
+        {
+            const Element& element = m_pMesh->getElement(elm);
 
-        auto vTilde = getElementVecState<dim>(qVTilde, element, 0, nNodes);
-        auto pPrev = getElementState<dim>(qPprev, element, 0, nNodes);
+            auto vTilde = getElementVecState<dim>(qVTilde, element, 0, nNodes);
+            auto pPrev = getElementState<dim>(qPprev, element, 0, nNodes);
 
-        auto rho_dt_DvTilde = (m_rho/dt)*m_DTelm[elm].transpose()*vTilde;
-        auto LpPrev = m_gammaFS*m_Lelm[elm]*pPrev;
+            auto rho_dt_DvTilde = (m_rho/dt)*m_DTelm[elm].transpose()*vTilde;
+            auto LpPrev = m_gammaFS*m_Lelm[elm]*pPrev;
 
-        std::size_t countbPcorrStep = 0;
-        for(unsigned short i = 0 ; i < nodPerEl ; ++i)
-        {
-            const Node& node = element.getNode(i);
-            if(!node.isFree() && !node.isOnFreeSurface())
+            std::size_t countbPcorrStep = 0;
+            for(unsigned short i = 0 ; i < nodPerEl ; ++i)
             {
-                /************************************************************************
-                                                  Build f
-                ************************************************************************/
-                indexbPcorrStep[doubletPerElm*elm + countbPcorrStep] = std::make_pair(element.getNodeIndex(i), -rho_dt_DvTilde(i));
-                countbPcorrStep++;
-
-                indexbPcorrStep[doubletPerElm*elm + countbPcorrStep] = std::make_pair(element.getNodeIndex(i), LpPrev(i));
-                countbPcorrStep++;
+                const Node& node = element.getNode(i);
+                if(!node.isFree() && !node.isOnFreeSurface())
+                {
+                    /************************************************************************
+                                                      Build f
+                    ************************************************************************/
+                    indexbPcorrStep[doubletPerElm*elm + countbPcorrStep] = std::make_pair(element.getNodeIndex(i), -rho_dt_DvTilde(i));
+                    countbPcorrStep++;
+
+                    indexbPcorrStep[doubletPerElm*elm + countbPcorrStep] = std::make_pair(element.getNodeIndex(i), LpPrev(i));
+                    countbPcorrStep++;
+                }
             }
         }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
     }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
 
-    m_clock.start();
-    for(const auto& doublet : indexbPcorrStep)
     {
-        //std::cout << doublet.first << ", " << doublet.second << std::endl;
-        m_bPcorrStep[doublet.first] += doublet.second;
+        PROFILE_SCOPE("Assemble p corr step");
+        for(const auto& doublet : indexbPcorrStep)
+        {
+            //std::cout << doublet.first << ", " << doublet.second << std::endl;
+            m_bPcorrStep[doublet.first] += doublet.second;
+        }
     }
-    m_accumalatedTimes["Assemble p corr step"] += m_clock.end();
 }
 
 template<unsigned short dim>
@@ -378,7 +387,7 @@ void MomContEqIncompNewton<dim>::m_applyBCPCorrStep()
 template<unsigned short dim>
 void MomContEqIncompNewton<dim>::m_buildMatVStep(const Eigen::VectorXd& qDeltaP)
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatricesAssemblyTimer, "Prepare matrices assembly");
     constexpr unsigned short nodPerEl = dim + 1;
     const unsigned int doubletPerElm = dim*nodPerEl;
     const double dt = m_pSolver->getTimeStep();
@@ -387,46 +396,48 @@ void MomContEqIncompNewton<dim>::m_buildMatVStep(const Eigen::VectorXd& qDeltaP)
     const std::size_t nNodes = m_pMesh->getNodesCount();
 
     std::vector<std::pair<std::size_t, double>> indexbVStep(doubletPerElm*nElm); m_bVStep.setZero();
-    m_accumalatedTimes["Prepare matrices assembly"] += m_clock.end();
+    prepareMatricesAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < nElm ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
-
-        auto deltaP = getElementState<dim>(qDeltaP, element, 0, nNodes);
-        auto DTdeltaP = m_DTelm[elm]*deltaP;
-
-        std::size_t countbVStep = 0;
-        for(unsigned short i = 0 ; i < nodPerEl ; ++i)
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < nElm ; ++elm)
         {
-            const Node& node = element.getNode(i);
+            const Element& element = m_pMesh->getElement(elm);
+
+            auto deltaP = getElementState<dim>(qDeltaP, element, 0, nNodes);
+            auto DTdeltaP = m_DTelm[elm]*deltaP;
 
-            if(!node.isFree() && !node.isBound())
+            std::size_t countbVStep = 0;
+            for(unsigned short i = 0 ; i < nodPerEl ; ++i)
             {
-                /************************************************************************
-                                                  Build f
-                ************************************************************************/
-                for(unsigned short d = 0 ; d < dim ; ++d)
+                const Node& node = element.getNode(i);
+
+                if(!node.isFree() && !node.isBound())
                 {
-                    indexbVStep[doubletPerElm*elm + countbVStep] = std::make_pair(element.getNodeIndex(i) + d*nNodes, dt*DTdeltaP(i + d*nodPerEl));
-                    countbVStep++;
+                    /************************************************************************
+                                                      Build f
+                    ************************************************************************/
+                    for(unsigned short d = 0 ; d < dim ; ++d)
+                    {
+                        indexbVStep[doubletPerElm*elm + countbVStep] = std::make_pair(element.getNodeIndex(i) + d*nNodes, dt*DTdeltaP(i + d*nodPerEl));
+                        countbVStep++;
+                    }
                 }
             }
         }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
     }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
 
-    m_clock.start();
-    for(const auto& doublet : indexbVStep)
     {
-        //std::cout << doublet.first << ", " << doublet.second << std::endl;
-        m_bVStep[doublet.first] += doublet.second;
+        PROFILE_SCOPE("Assemble b v corr step");
+        for(const auto& doublet : indexbVStep)
+        {
+            //std::cout << doublet.first << ", " << doublet.second << std::endl;
+            m_bVStep[doublet.first] += doublet.second;
+        }
     }
-    m_accumalatedTimes["Assemble b v corr step"] += m_clock.end();
 }
 
 template<unsigned short dim>
@@ -462,115 +473,127 @@ void MomContEqIncompNewton<dim>::m_applyBCVStep()
 }
 
 template<unsigned short dim>
-void MomContEqIncompNewton<dim>::m_setupPicardFracStep(unsigned int maxIter, double minRes)
+void MomContEqIncompNewton<dim>::m_setupNonLinearAlgoFracStep(unsigned int maxIter, double minRes)
 {
-    m_pPicardAlgo = std::make_unique<PicardAlgo>([&](const auto& qPrevVec){
-        m_clock.start();
-        m_M.resize(qPrevVec[0].rows(), qPrevVec[0].rows());
-        m_MK_dt.resize(qPrevVec[0].rows(), qPrevVec[0].rows());
-        m_L.resize(qPrevVec[1].rows(), qPrevVec[1].rows());
-        m_bVAppStep.resize(qPrevVec[0].rows()); m_bVAppStep.setZero();
-        m_bPcorrStep.resize(qPrevVec[1].rows()); m_bPcorrStep.setZero();
-        m_bVStep.resize(qPrevVec[0].rows()); m_bVStep.setZero();
-        m_accumalatedTimes["Prepare Picard algorithm"] += m_clock.end();
-
-        m_clock.start();
-        m_pMesh->saveNodesList();
-        m_accumalatedTimes["Save/restore nodelist"] += m_clock.end();
+    m_pNonLinearAlgo = m_buildNonLinearAlgo([&](const auto& qPrevVec){
+        {
+            PROFILE_SCOPE("Prepare Picard algorithm");
+            m_M.resize(qPrevVec[0].rows(), qPrevVec[0].rows());
+            m_MK_dt.resize(qPrevVec[0].rows(), qPrevVec[0].rows());
+            m_L.resize(qPrevVec[1].rows(), qPrevVec[1].rows());
+            m_bVAppStep.resize(qPrevVec[0].rows()); m_bVAppStep.setZero();
+            m_bPcorrStep.resize(qPrevVec[1].rows()); m_bPcorrStep.setZero();
+            m_bVStep.resize(qPrevVec[0].rows()); m_bVStep.setZero();
+        }
+
+        {
+            PROFILE_SCOPE("Save/restore nodelist");
+            m_pMesh->saveNodesList();
+        }
     },
     [&](auto& qIterVec, const auto& qPrevVec){
         m_buildMatFracStep(qPrevVec);
-        m_clock.start();
-        m_applyBCVAppStep(qPrevVec[0]);
-        m_accumalatedTimes["Apply boundary conditions v app step"] += m_clock.end();
-        m_clock.start();
-        m_solverIt.compute(m_MK_dt);
-        m_accumalatedTimes["Compute matrix v app step"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Apply boundary conditions v app step");
+            m_applyBCVAppStep(qPrevVec[0]);
+        }
+        {
+            PROFILE_SCOPE("Compute matrix v app step");
+            m_solverIt.compute(m_MK_dt);
+        }
         Eigen::VectorXd qVTilde(qPrevVec[0].rows());
 
         if(m_solverIt.info() == Eigen::Success)
         {
-            m_clock.start();
+            PROFILE_SCOPE("Solve system v app step");
             qVTilde = m_solverIt.solve(m_bVAppStep);
-            m_accumalatedTimes["Solve system v app step"] += m_clock.end();
+            m_linearIterCount += static_cast<std::size_t>(m_solverIt.iterations());
         }
         else
         {
             if(m_pProblem->isOutputVerbose())
                 std::cout << "\t * The Eigen solver failed to factorize the matrix for the velocity guess step!" << std::endl;
-            m_clock.start();
-            m_pMesh->restoreNodesList();
-            m_accumalatedTimes["Save/restore nodelist"] += m_clock.end();
+            {
+                PROFILE_SCOPE("Save/restore nodelist");
+                m_pMesh->restoreNodesList();
+            }
             return false;
         }
 
         m_buildMatPcorrStep(qVTilde, qPrevVec[1]);
-        m_clock.start();
-        m_applyBCPCorrStep();
-        m_accumalatedTimes["Apply boundary conditions p corr step"] += m_clock.end();
-        m_clock.start();
-        m_solverIt.compute(m_L);
-        m_accumalatedTimes["Compute matrix p corr step"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Apply boundary conditions p corr step");
+            m_applyBCPCorrStep();
+        }
+        {
+            PROFILE_SCOPE("Compute matrix p corr step");
+            m_solverIt.compute(m_L);
+        }
         Eigen::VectorXd qDeltaP(qPrevVec[1].rows());
 
         if(m_solverIt.info() == Eigen::Success)
         {
-            m_clock.start();
+            PROFILE_SCOPE("Solve system p corr step");
             qIterVec[1] = m_solverIt.solve(m_bPcorrStep);
-            m_accumalatedTimes["Solve system p corr step"] += m_clock.end();
+            m_linearIterCount += static_cast<std::size_t>(m_solverIt.iterations());
         }
         else
         {
             if(m_pProblem->isOutputVerbose())
                 std::cout << "\t * The Eigen solver failed to factorize the matrix for the pressure correction step!" << std::endl;
-            m_clock.start();
-            m_pMesh->restoreNodesList();
-            m_accumalatedTimes["Save/restore nodelist"] += m_clock.end();
+            {
+                PROFILE_SCOPE("Save/restore nodelist");
+                m_pMesh->restoreNodesList();
+            }
             return false;
         }
 
-        m_clock.start();
-        qDeltaP = qIterVec[1] - m_gammaFS*qPrevVec[1];
-        m_accumalatedTimes["Update solutions"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Update solutions");
+            qDeltaP = qIterVec[1] - m_gammaFS*qPrevVec[1];
+        }
 
         m_buildMatVStep(qDeltaP);
-        m_clock.start();
-        m_applyBCVStep();
-        m_accumalatedTimes["Apply boundary conditions v corr step"] += m_clock.end();
-        m_clock.start();
-        m_solverIt.compute(m_M);
-        m_accumalatedTimes["Compute matrix v corr step"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Apply boundary conditions v corr step");
+            m_applyBCVStep();
+        }
+        {
+            PROFILE_SCOPE("Compute matrix v corr step");
+            m_solverIt.compute(m_M);
+        }
         Eigen::VectorXd qDeltaV(qPrevVec[0].rows());
 
         if(m_solverIt.info() == Eigen::Success)
         {
-            m_clock.start();
+            PROFILE_SCOPE("Solve system v corr step");
             qDeltaV = m_solverIt.solve(m_bVStep);
-            m_accumalatedTimes["Solve system v corr step"] += m_clock.end();
+            m_linearIterCount += static_cast<std::size_t>(m_solverIt.iterations());
         }
         else
         {
             if(m_pProblem->isOutputVerbose())
                 std::cout << "\t * The Eigen solver failed to factorize the matrix for the pressure correction step!" << std::endl;
-            m_clock.start();
-            m_pMesh->restoreNodesList();
-            m_accumalatedTimes["Save/restore nodelist"] += m_clock.end();
+            {
+                PROFILE_SCOPE("Save/restore nodelist");
+                m_pMesh->restoreNodesList();
+            }
             return false;
         }
 
-        m_clock.start();
+        PROFILE_TIMER(updateSolutionsTimer, "Update solutions");
         qIterVec[0] = qVTilde + qDeltaV;
 
         setNodesStatesfromQ(m_pMesh, qIterVec[0], m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim() - 1);
         setNodesStatesfromQ(m_pMesh, qIterVec[1], m_pMesh->getDim(), m_pMesh->getDim());
         Eigen::VectorXd deltaPos = qIterVec[0]*m_pSolver->getTimeStep();
         m_pMesh->updateNodesPositionFromSave(deltaPos);
-        m_accumalatedTimes["Update solutions"] += m_clock.end();
+        updateSolutionsTimer.stop();
 
         return true;
      },
     [&](const auto& qIterVec, const auto& qIterPrevVec) -> double {
-        m_clock.start();
+        PROFILE_SCOPE("Compute Picard Algo residual");
         Mesh* p_Mesh = this->m_pMesh;
         const std::size_t nNodes = p_Mesh->getNodesCount();
 
@@ -618,13 +641,18 @@ void MomContEqIncompNewton<dim>::m_setupPicardFracStep(unsigned int maxIter, dou
                     resP = std::sqrt(num/den);
             }
 
-            m_accumalatedTimes["Compute Picard Algo residual"] += m_clock.end();
-
             return std::max(resV, resP);
         }
         else
         {
             throw std::runtime_error("Ax-f residual currently unsupported for fractionnal step solveur");
         }
+    },
+    [&](const auto& qIterVec, const auto& /** qPrevVec **/){
+        PROFILE_SCOPE("Update solutions");
+        setNodesStatesfromQ(m_pMesh, qIterVec[0], m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim() - 1);
+        setNodesStatesfromQ(m_pMesh, qIterVec[1], m_pMesh->getDim(), m_pMesh->getDim());
+        Eigen::VectorXd deltaPos = qIterVec[0]*m_pSolver->getTimeStep();
+        m_pMesh->updateNodesPositionFromSave(deltaPos);
     }, maxIter, minRes);
 }
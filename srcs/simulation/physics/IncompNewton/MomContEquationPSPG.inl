@@ -6,7 +6,7 @@
 template<unsigned short dim>
 void MomContEqIncompNewton<dim>::m_buildAbPSPG(const Eigen::VectorXd& qPrev)
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatrixAssemblyTimer, "Prepare matrix assembly");
     constexpr unsigned short nodPerEl = dim + 1;
     const unsigned int tripletPerElm = (dim + 1)*nodPerEl*(dim + 1)*nodPerEl;
     const unsigned int doubletPerElm = (dim + 1)*nodPerEl;
@@ -16,133 +16,139 @@ void MomContEqIncompNewton<dim>::m_buildAbPSPG(const Eigen::VectorXd& qPrev)
 
     std::vector<Eigen::Triplet<double>> indexA(tripletPerElm*nElm);
     std::vector<std::pair<std::size_t, double>> indexb(doubletPerElm*nElm); m_b.setZero();
-    m_accumalatedTimes["Prepare matrix assembly"] += m_clock.end();
+    prepareMatrixAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < nElm ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
-        Eigen::Matrix<double, (dim + 1)*nodPerEl, (dim + 1)*nodPerEl> Ae;
-        Eigen::Matrix<double, (dim + 1)*nodPerEl, 1> be;
-
-        double tau = m_computeTauPSPG(element);
-        GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
-        BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
-        Eigen::Matrix<double, nodPerEl, nodPerEl> Me_dt_s = (1/dt)*m_pMatBuilder->getM(element);
-        Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me_dt = MatrixBuilder<dim>::diagBlock(Me_dt_s);
-        Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Ke = m_pMatBuilder->getK(element, Be);
-        Eigen::Matrix<double, nodPerEl, dim*nodPerEl> De = m_pMatBuilder->getD(element, Be);
-        Eigen::Matrix<double, nodPerEl, dim*nodPerEl> Ce_dt = (tau/dt)*m_pMatBuilder->getC(element, Be, gradNe);
-        Eigen::Matrix<double, nodPerEl, nodPerEl> Le = tau*m_pMatBuilder->getL(element, Be, gradNe);
-        Eigen::Matrix<double, dim*nodPerEl, 1> Fe = m_pMatBuilder->getF(element, m_bodyForce, Be);
-        Eigen::Matrix<double, nodPerEl, 1> He = tau*m_pMatBuilder->getH(element, m_bodyForce, Be, gradNe);
-
-        Ae << Me_dt + Ke, -De.transpose(), Ce_dt + De, Le;
-
-        Eigen::Matrix<double, dim*nodPerEl, 1> vPrev = getElementVecState<dim>(qPrev, element, 0, nNodes);
-
-        if(m_phaseChange)
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < nElm ; ++elm)
         {
-            Eigen::Matrix<double, nodPerEl, nodPerEl> Me2_s = m_pMatBuilder2->getM(element);
-            Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me2 = MatrixBuilder<dim>::diagBlock(Me2_s);
-            be << Fe + Me_dt*vPrev - Me2*vPrev, He + Ce_dt*vPrev;
-        }
-        else
-            be << Fe + Me_dt*vPrev, He + Ce_dt*vPrev;
-
-        std::size_t countA = 0;
-        std::size_t countb = 0;
+            const Element& element = m_pMesh->getElement(elm);
+            Eigen::Matrix<double, (dim + 1)*nodPerEl, (dim + 1)*nodPerEl> Ae;
+            Eigen::Matrix<double, (dim + 1)*nodPerEl, 1> be;
+
+            double tau = m_computeTauPSPG(element);
+            GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
+            BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
+            Eigen::Matrix<double, nodPerEl, nodPerEl> Me_dt_s = (1/dt)*m_pMatBuilder->getM(element);
+            Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me_dt = MatrixBuilder<dim>::diagBlock(Me_dt_s);
+            Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Ke = m_pMatBuilder->getK(element, Be);
+            Eigen::Matrix<double, nodPerEl, dim*nodPerEl> De = m_pMatBuilder->getD(element, Be);
+            Eigen::Matrix<double, nodPerEl, dim*nodPerEl> Ce_dt = (tau/dt)*m_pMatBuilder->getC(element, Be, gradNe);
+            Eigen::Matrix<double, nodPerEl, nodPerEl> Le = tau*m_pMatBuilder->getL(element, Be, gradNe);
+            Eigen::Matrix<double, dim*nodPerEl, 1> Fe = m_pMatBuilder->getF(element, m_bodyForce, Be);
+            Eigen::Matrix<double, nodPerEl, 1> He = tau*m_pMatBuilder->getH(element, m_bodyForce, Be, gradNe);
+
+            Ae << Me_dt + Ke, -De.transpose(), Ce_dt + De, Le;
+
+            Eigen::Matrix<double, dim*nodPerEl, 1> vPrev = getElementVecState<dim>(qPrev, element, 0, nNodes);
+
+            if(m_phaseChange)
+            {
+                Eigen::Matrix<double, nodPerEl, nodPerEl> Me2_s = m_pMatBuilder2->getM(element);
+                Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me2 = MatrixBuilder<dim>::diagBlock(Me2_s);
+                be << Fe + Me_dt*vPrev - Me2*vPrev, He + Ce_dt*vPrev;
+            }
+            else
+                be << Fe + Me_dt*vPrev, He + Ce_dt*vPrev;
 
-        for(unsigned short i = 0 ; i < nodPerEl ; ++i)
-        {
-            const Node& ni = m_pMesh->getNode(element.getNodeIndex(i));
+            std::size_t countA = 0;
+            std::size_t countb = 0;
 
-            for(unsigned short j = 0 ; j < nodPerEl ; ++j)
+            for(unsigned short i = 0 ; i < nodPerEl ; ++i)
             {
-                for(unsigned short d1 = 0 ; d1 < dim ; ++d1)
+                const Node& ni = m_pMesh->getNode(element.getNodeIndex(i));
+
+                for(unsigned short j = 0 ; j < nodPerEl ; ++j)
                 {
+                    for(unsigned short d1 = 0 ; d1 < dim ; ++d1)
+                    {
+                        for(unsigned short d2 = 0 ; d2 <= dim ; ++d2)
+                        {
+                            if(!(ni.isBound() || ni.isFree()))
+                            {
+                                indexA[tripletPerElm*elm + countA] =
+                                    Eigen::Triplet<double>(element.getNodeIndex(i) + d1*nNodes,
+                                                           element.getNodeIndex(j) + d2*nNodes,
+                                                           Ae(i + d1*nodPerEl, j + d2*nodPerEl));
+                            }
+                            countA++;
+                        }
+                    }
+
                     for(unsigned short d2 = 0 ; d2 <= dim ; ++d2)
                     {
-                        if(!(ni.isBound() || ni.isFree()))
+                        if(!ni.isFree())
                         {
                             indexA[tripletPerElm*elm + countA] =
-                                Eigen::Triplet<double>(element.getNodeIndex(i) + d1*nNodes,
+                                Eigen::Triplet<double>(element.getNodeIndex(i) + dim*nNodes,
                                                        element.getNodeIndex(j) + d2*nNodes,
-                                                       Ae(i + d1*nodPerEl, j + d2*nodPerEl));
+                                                       Ae(i + dim*nodPerEl, j + d2*nodPerEl));
                         }
+
                         countA++;
                     }
                 }
 
-                for(unsigned short d2 = 0 ; d2 <= dim ; ++d2)
+                for(unsigned short d = 0 ; d <= dim ; ++d)
                 {
-                    if(!ni.isFree())
-                    {
-                        indexA[tripletPerElm*elm + countA] =
-                            Eigen::Triplet<double>(element.getNodeIndex(i) + dim*nNodes,
-                                                   element.getNodeIndex(j) + d2*nNodes,
-                                                   Ae(i + dim*nodPerEl, j + d2*nodPerEl));
-                    }
-
-                    countA++;
+                    indexb[doubletPerElm*elm + countb] = std::make_pair(element.getNodeIndex(i) + d*nNodes, be(i + d*nodPerEl));
+                    countb++;
                 }
             }
-
-            for(unsigned short d = 0 ; d <= dim ; ++d)
-            {
-                indexb[doubletPerElm*elm + countb] = std::make_pair(element.getNodeIndex(i) + d*nNodes, be(i + d*nodPerEl));
-                countb++;
-            }
         }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
     }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
 
 
     //Best would be to know the number of nodes in which case :/
     //This can still be fasten using OpenMP but will never be as good as using []
     //with preallocated memory
-    m_clock.start();
-    for(std::size_t n = 0 ; n < nNodes ; ++n)
     {
-        const Node& node = m_pMesh->getNode(n);
-
-        if(node.isFree())
+        PROFILE_SCOPE("Push back (n, n, 1)");
+        for(std::size_t n = 0 ; n < nNodes ; ++n)
         {
-            indexA.push_back(Eigen::Triplet<double>(n + dim*nNodes,
-                                                    n + dim*nNodes,
-                                                    1));
-        }
+            const Node& node = m_pMesh->getNode(n);
 
-        if(node.isBound() || node.isFree())
-        {
-            for(unsigned short d = 0 ; d < dim ; ++d)
+            if(node.isFree())
             {
-                indexA.push_back(Eigen::Triplet<double>(n + d*nNodes,
-                                                        n + d*nNodes,
+                indexA.push_back(Eigen::Triplet<double>(n + dim*nNodes,
+                                                        n + dim*nNodes,
                                                         1));
             }
+
+            if(node.isBound() || node.isFree())
+            {
+                for(unsigned short d = 0 ; d < dim ; ++d)
+                {
+                    indexA.push_back(Eigen::Triplet<double>(n + d*nNodes,
+                                                            n + d*nNodes,
+                                                            1));
+                }
+            }
         }
     }
-    m_accumalatedTimes["Push back (n, n, 1)"] += m_clock.end();
 
 
     /********************************************************************************
                                         Compute A and b
     ********************************************************************************/
-    m_clock.start();
-    m_A.setFromTriplets(indexA.begin(), indexA.end());
-    m_accumalatedTimes["Assemble matrix"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Assemble matrix");
+        m_A.setFromTriplets(indexA.begin(), indexA.end());
+    }
 
-    m_clock.start();
-    for(const auto& doublet : indexb)
     {
-        //std::cout << doublet.first << ", " << doublet.second << std::endl;
-        m_b[doublet.first] += doublet.second;
+        PROFILE_SCOPE("Assemble vector");
+        for(const auto& doublet : indexb)
+        {
+            //std::cout << doublet.first << ", " << doublet.second << std::endl;
+            m_b[doublet.first] += doublet.second;
+        }
     }
-    m_accumalatedTimes["Assemble vector"] += m_clock.end();
+
+    m_assemblyMemory = getMemorySize(indexA) + getMemorySize(indexb);
 }
 
 template<unsigned short dim>
@@ -259,60 +265,87 @@ double MomContEqIncompNewton<dim>::m_computeTauPSPG(const Element& element) cons
 }
 
 template<unsigned short dim>
-void MomContEqIncompNewton<dim>::m_setupPicardPSPG(unsigned int maxIter, double minRes)
+void MomContEqIncompNewton<dim>::m_setupNonLinearAlgoPSPG(unsigned int maxIter, double minRes)
 {
-    m_pPicardAlgo = std::make_unique<PicardAlgo>([&](const auto& qPrevVec){
-        m_clock.start();
-        m_A.resize(qPrevVec[0].rows(), qPrevVec[0].rows());
-        m_b.resize(qPrevVec[0].rows()); m_b.setZero();
-        m_accumalatedTimes["Prepare Picard algorithm"] += m_clock.end();
-        m_clock.start();
-        m_pMesh->saveNodesList();
-        m_accumalatedTimes["Save/restore nodelist"] += m_clock.end();
+    m_pNonLinearAlgo = m_buildNonLinearAlgo([&](const auto& qPrevVec){
+        {
+            PROFILE_SCOPE("Prepare Picard algorithm");
+            m_A.resize(qPrevVec[0].rows(), qPrevVec[0].rows());
+            m_b.resize(qPrevVec[0].rows()); m_b.setZero();
+        }
+        {
+            PROFILE_SCOPE("Save/restore nodelist");
+            m_pMesh->saveNodesList();
+        }
 
         m_buildAbPSPG(qPrevVec[0]);
-        m_clock.start();
-        m_applyBCPSPG(qPrevVec[0]);
-        m_accumalatedTimes["Apply boundary conditions"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Apply boundary conditions");
+            m_applyBCPSPG(qPrevVec[0]);
+        }
+        m_isAbOutdated = false;
     },
     [&](auto& qIterVec, const auto& qPrevVec){
+        //The system is only assembled once per iteration, for the iterate currently held by the mesh
+        if(m_isAbOutdated)
+        {
+            m_buildAbPSPG(qPrevVec[0]);
+            {
+                PROFILE_SCOPE("Apply boundary conditions");
+                m_applyBCPSPG(qPrevVec[0]);
+            }
+            m_isAbOutdated = false;
+        }
 
-        m_clock.start();
-        m_solver.analyzePattern(m_A);
-        m_accumalatedTimes["Analyse pattern of A matrix"] += m_clock.end();
-        m_clock.start();
-        m_solver.factorize(m_A);
-        m_accumalatedTimes["Factorize A matrix"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Analyse pattern of A matrix");
+            m_solver.analyzePattern(m_A);
+        }
+        {
+            PROFILE_SCOPE("Factorize A matrix");
+            m_solver.factorize(m_A);
+        }
 
         if(m_solver.info() == Eigen::Success)
         {
-            m_clock.start();
-            qIterVec[0] = m_solver.solve(m_b);
-            m_accumalatedTimes["Solve system"] += m_clock.end();
-            m_clock.start();
+            m_factorizationMemory = getFactorizationMemorySize(m_solver);
+            {
+                PROFILE_SCOPE("Solve system");
+                qIterVec[0] = m_solver.solve(m_b);
+            }
+            PROFILE_TIMER(updateSolutionsTimer, "Update solutions");
             setNodesStatesfromQ(m_pMesh, qIterVec[0], m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim());
             Eigen::VectorXd deltaPos = qIterVec[0]*m_pSolver->getTimeStep();
             m_pMesh->updateNodesPositionFromSave(deltaPos);
-            m_accumalatedTimes["Update solutions"] += m_clock.end();
+            updateSolutionsTimer.stop();
+
+            //The Ax_f residual needs the system of the new iterate, otherwise it is assembled by the next iteration
+            if(m_residual == Res::Ax_f)
+            {
+                m_buildAbPSPG(qPrevVec[0]);
+                {
+                    PROFILE_SCOPE("Apply boundary conditions");
+                    m_applyBCPSPG(qPrevVec[0]);
+                }
+            }
+            else
+                m_isAbOutdated = true;
 
-            m_buildAbPSPG(qPrevVec[0]);
-            m_clock.start();
-            m_applyBCPSPG(qPrevVec[0]);
-            m_accumalatedTimes["Apply boundary conditions"] += m_clock.end();
             return true;
         }
         else
         {
             if(m_pProblem->isOutputVerbose())
                 std::cout << "\t * The Eigen::SparseLU solver failed to factorize the A matrix!" << std::endl;
-            m_clock.start();
-            m_pMesh->restoreNodesList();
-            m_accumalatedTimes["Save/restore nodelist"] += m_clock.end();
+            {
+                PROFILE_SCOPE("Save/restore nodelist");
+                m_pMesh->restoreNodesList();
+            }
             return false;
         }
     },
     [&](const auto& qIterVec, const auto& qIterPrevVec) -> double {
-        m_clock.start();
+        PROFILE_SCOPE("Compute Picard Algo residual");
         Mesh* p_Mesh = this->m_pMesh;
         const std::size_t nNodes = p_Mesh->getNodesCount();
 
@@ -360,14 +393,24 @@ void MomContEqIncompNewton<dim>::m_setupPicardPSPG(unsigned int maxIter, double
                     resP = std::sqrt(num/den);
             }
 
-            m_accumalatedTimes["Compute Picard Algo residual"] += m_clock.end();
             return std::max(resV, resP);
         }
         else
         {
             double res = (m_A*qIterVec[0] - m_b).norm();
-            m_accumalatedTimes["Compute Picard Algo residual"] += m_clock.end();
             return res;
         }
+    },
+    [&](const auto& qIterVec, const auto& qPrevVec){
+        (void) qPrevVec;
+        {
+            PROFILE_SCOPE("Update solutions");
+            setNodesStatesfromQ(m_pMesh, qIterVec[0], m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim());
+            Eigen::VectorXd deltaPos = qIterVec[0]*m_pSolver->getTimeStep();
+            m_pMesh->updateNodesPositionFromSave(deltaPos);
+        }
+
+        //Assembled by the next call to the solve function
+        m_isAbOutdated = true;
     }, maxIter, minRes);
 }
@@ -1,11 +1,14 @@
 #include "Problem.hpp"
 
+#include <algorithm>
+
 #include "Solver.hpp"
+#include "../../utility/Reduction.hpp"
 #include "../../extractors/Extractors.hpp"
 
 
-ProbIncompNewton::ProbIncompNewton(std::string luaFilePath) :
-Problem(luaFilePath)
+ProbIncompNewton::ProbIncompNewton(std::string luaFilePath, std::string restartFile) :
+Problem(luaFilePath, restartFile)
 {
     if(m_id != "IncompNewtonNoT" && m_id != "Boussinesq" && m_id != "Bingham" && m_id != "Conduction")
         throw std::runtime_error("the ProbIncompNewton does not know id " + m_id);
@@ -63,127 +66,63 @@ std::vector<std::string> ProbIncompNewton::getWrittableDataName() const
     return {};
 }
 
-std::vector<double> ProbIncompNewton::getWrittableData(const std::string& name, std::size_t nodeIndex) const
+WrittableField ProbIncompNewton::resolveWrittableField(const std::string& name) const
 {
-    const Node& node = m_pMesh->getNode(nodeIndex);
-
-    bool error = false;
+    std::vector<std::string> statesName;
 
-    if(m_id == "IncompNewtonNoT" || m_id == "Bingham")
-    {
-        if(name == "u")
-            return {node.getState(0)};
-        else if(name == "v")
-            return {node.getState(1)};
-        else
-        {
-            if(m_pMesh->getDim() == 2)
-            {
-                if(name == "p")
-                    return {node.getState(2)};
-                else if(name == "ke")
-                    return {0.5*(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1))};
-                else if(name == "magV")
-                    return {std::sqrt(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1))};
-                else if(name == "velocity")
-                    return {node.getState(0), node.getState(1), 0};
-                else
-                    error = true;
-
-            }
-            else
-            {
-                if(name == "w")
-                    return {node.getState(2)};
-                else if(name == "p")
-                    return {node.getState(3)};
-                else if(name == "ke")
-                    return {0.5*(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1) + node.getState(2)*node.getState(2))};
-                else if(name == "magV")
-                    return {std::sqrt(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1) + node.getState(2)*node.getState(2))};
-                else if(name == "velocity")
-                    return {node.getState(0), node.getState(1), node.getState(2)};
-                else
-                    error = true;
-            }
-        }
-    }
-    else if(m_id == "Boussinesq")
+    if(m_id == "Conduction")
+        statesName = {"T"};
+    else
     {
-        if(name == "u")
-            return {node.getState(0)};
-        else if(name == "v")
-            return {node.getState(1)};
+        if(m_pMesh->getDim() == 2)
+            statesName = {"u", "v", "p"};
         else
-        {
-            if(m_pMesh->getDim() == 2)
-            {
-                if(name == "p")
-                    return {node.getState(2)};
-                else if(name == "T")
-                    return {node.getState(3)};
-                else if(name == "ke")
-                    return {0.5*(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1))};
-                else if(name == "magV")
-                    return {std::sqrt(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1))};
-                else if(name == "velocity")
-                    return {node.getState(0), node.getState(1), 0};
-                else
-                    error = true;
-
-            }
-            else
-            {
-                if(name == "w")
-                    return {node.getState(2)};
-                else if(name == "p")
-                    return {node.getState(3)};
-                else if(name == "T")
-                    return {node.getState(4)};
-                else if(name == "ke")
-                    return {0.5*(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1) + node.getState(2)*node.getState(2))};
-                else if(name == "magV")
-                    return {std::sqrt(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1) + node.getState(2)*node.getState(2))};
-                else if(name == "velocity")
-                    return {node.getState(0), node.getState(1), node.getState(2)};
-                else
-                    error = true;
-            }
-        }
+            statesName = {"u", "v", "w", "p"};
+
+        if(m_id == "Boussinesq")
+            statesName.push_back("T");
     }
-    else if(m_id == "Conduction")
+
+    auto it = std::find(statesName.begin(), statesName.end(), name);
+    if(it != statesName.end())
+        return {WrittableField::Kind::State, static_cast<unsigned int>(it - statesName.begin()), 1};
+
+    if(m_id != "Conduction")
     {
-        if(name == "T")
-            return {node.getState(0)};
-        else
-            error = true;
+        if(name == "ke")
+            return {WrittableField::Kind::KineticEnergy, 0, 1};
+        else if(name == "magV")
+            return {WrittableField::Kind::VelocityMagnitude, 0, 1};
+        else if(name == "velocity")
+            return {WrittableField::Kind::Velocity, 0, 3};
     }
 
-    if(error)
-        throw std::runtime_error("The data " + name + " cannot be extract from problem " + getID());
-
-    return {}; //silence waring
+    throw std::runtime_error("The data " + name + " cannot be extract from problem " + getID());
 }
 
 std::vector<std::string> ProbIncompNewton::getGlobalWrittableDataName() const
 {
-    return {"mass"};
+    std::vector<std::string> globalDataName = {"mass"};
+
+    if(m_id != "Conduction")
+    {
+        std::vector<std::string> diagnosticsName = getDiagnosticsName();
+        globalDataName.insert(globalDataName.end(), diagnosticsName.begin(), diagnosticsName.end());
+    }
+
+    return globalDataName;
 }
 
 double ProbIncompNewton::getGlobalWrittableData(const std::string& name) const
 {
     if(name == "mass")
     {
-        double mass = 0;
-
-        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
-        {
-            const Element& element = m_pMesh->getElement(elm);
-            mass += element.getSize();
-        }
-
-        return mass;
+        return parallelSum(m_pMesh->getElementsCount(), [&](std::size_t elm){
+            return m_pMesh->getElement(elm).getSize();
+        });
     }
+    else if(m_id != "Conduction")
+        return Problem::getGlobalWrittableData(name);
     else
         throw std::runtime_error("The global data " + name + " cannot be extract from problem " + getID());
 }
@@ -20,7 +20,7 @@
 class SIMULATION_API ProbIncompNewton : public Problem
 {
     public:
-        ProbIncompNewton(std::string luaFilePath);
+        ProbIncompNewton(std::string luaFilePath, std::string restartFile = "");
         ProbIncompNewton(const ProbIncompNewton& problem)             = delete;
         ProbIncompNewton& operator=(const ProbIncompNewton& problem)  = delete;
         ProbIncompNewton(ProbIncompNewton&& problem)                  = delete;
@@ -30,10 +30,12 @@ class SIMULATION_API ProbIncompNewton : public Problem
         void displayParams() const override;
 
         std::vector<std::string> getWrittableDataName() const override;
-        std::vector<double> getWrittableData(const std::string& name, std::size_t nodeIndex) const override;
         std::vector<std::string> getGlobalWrittableDataName() const override;
         double getGlobalWrittableData(const std::string& name) const override;
 
+    protected:
+        WrittableField resolveWrittableField(const std::string& name) const override;
+
     private:
 
 };
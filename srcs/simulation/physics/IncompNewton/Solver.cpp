@@ -1,3 +1,7 @@
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
 #include "Problem.hpp"
 #include "Solver.hpp"
 #include "MomContEquation.hpp"
@@ -10,7 +14,14 @@ std::make_unique<Eq<dim>>( \
 ); \
 
 SolverIncompNewton::SolverIncompNewton(Problem* pProblem, Mesh* pMesh, std::vector<SolTable> problemParams):
-Solver(pProblem, pMesh, problemParams)
+Solver(pProblem, pMesh, problemParams),
+m_predictiveDT(false),
+m_targetIterCount(3),
+m_targetContraction(0.1),
+m_maxCFL(1),
+m_prevDTError(0),
+m_acceptedStepsCount(0),
+m_rejectedStepsCount(0)
 {
     //Check if the asked problem and solver are supported
     if(m_pProblem->getID() != "IncompNewtonNoT" && m_pProblem->getID() != "Bingham" && m_pProblem->getID() != "Boussinesq" && m_pProblem->getID() != "Conduction")
@@ -178,6 +189,26 @@ Solver(pProblem, pMesh, problemParams)
     m_coeffDTDecrease = m_solverParams[0].checkAndGet<double>("coeffDTDecrease");
     m_coeffDTincrease = m_solverParams[0].checkAndGet<double>("coeffDTincrease");
 
+    if(m_solverParams[0].doesVarExist("predictiveDT"))
+        m_predictiveDT = m_solverParams[0].checkAndGet<bool>("predictiveDT");
+
+    if(m_predictiveDT)
+    {
+        if(m_solverParams[0].doesVarExist("targetIterCount"))
+            m_targetIterCount = m_solverParams[0].checkAndGet<unsigned int>("targetIterCount");
+        if(m_solverParams[0].doesVarExist("targetContraction"))
+            m_targetContraction = m_solverParams[0].checkAndGet<double>("targetContraction");
+        if(m_solverParams[0].doesVarExist("maxCFL"))
+            m_maxCFL = m_solverParams[0].checkAndGet<double>("maxCFL");
+
+        if(m_targetIterCount == 0)
+            throw std::runtime_error("the target iteration count should be greater than 0!");
+        if(m_targetContraction <= 0 || m_targetContraction >= 1)
+            throw std::runtime_error("the target contraction should be in ]0, 1[!");
+        if(m_maxCFL <= 0)
+            throw std::runtime_error("the maximum CFL number should be greater than 0!");
+    }
+
     m_timeStep = m_initialDT;
 
     //Should we compute the normals and the curvature ?
@@ -204,10 +235,45 @@ void SolverIncompNewton::displayParams() const
               << "Maximum dt: " << m_maxDT << "\n"
               << "Initial dt: " << m_initialDT << std::endl;
 
+    if(m_predictiveDT)
+    {
+        std::cout << "Predictive dt controller: \n"
+                  << " * Target non-linear iteration count: " << m_targetIterCount << "\n"
+                  << " * Target residual contraction: " << m_targetContraction << "\n"
+                  << " * Maximum CFL number: " << m_maxCFL << std::endl;
+    }
+
     for(auto& pEquation : m_pEquations)
         pEquation->displayParams();
 }
 
+void SolverIncompNewton::displayTimeStats() const
+{
+    const std::size_t stepsCount = m_acceptedStepsCount + m_rejectedStepsCount;
+    std::cout << std::setw(40) << std::left << "Accepted time steps" << ": " << std::setw(10) << std::right << m_acceptedStepsCount << "\n"
+              << std::setw(40) << std::left << "Rejected time steps" << ": " << std::setw(10) << std::right << m_rejectedStepsCount << "\n"
+              << std::setw(40) << std::left << "Rejection rate" << ": " << std::setw(10) << std::right
+              << ((stepsCount == 0) ? 0 : 100*static_cast<double>(m_rejectedStepsCount)/static_cast<double>(stepsCount)) << " %" << std::endl;
+
+    Solver::displayTimeStats();
+}
+
+std::vector<double> SolverIncompNewton::getCheckpointData() const
+{
+    std::vector<double> data = Solver::getCheckpointData();
+    data.push_back(m_prevDTError);
+
+    return data;
+}
+
+void SolverIncompNewton::setCheckpointData(const std::vector<double>& data)
+{
+    Solver::setCheckpointData(data);
+
+    if(data.size() > 2)
+        m_prevDTError = data[2];
+}
+
 bool SolverIncompNewton::solveOneTimeStep()
 {
     return m_solveFunc();
@@ -217,6 +283,9 @@ void SolverIncompNewton::computeNextDT()
 {
     if(!m_solveSucceed)
     {
+        m_rejectedStepsCount++;
+        m_prevDTError = 0;
+
         if(m_adaptDT)
             m_timeStep /= m_coeffDTDecrease;
         else
@@ -224,23 +293,106 @@ void SolverIncompNewton::computeNextDT()
     }
     else
     {
+        m_acceptedStepsCount++;
+
         if(m_adaptDT)
-            m_timeStep = std::min(m_maxDT, m_timeStep*m_coeffDTincrease);
+        {
+            if(m_predictiveDT)
+            {
+                //PI controller on the non-linear algorithms error indicator
+                constexpr double kI = 0.3;
+                constexpr double kP = 0.4;
+
+                const double error = m_computeDTError();
+                double factor = std::pow(1/error, kI);
+                if(m_prevDTError > 0)
+                    factor *= std::pow(m_prevDTError/error, kP);
+                m_prevDTError = error;
+
+                factor = std::max(1/m_coeffDTDecrease, std::min(factor, m_coeffDTincrease));
+                m_timeStep = std::min(m_timeStep*factor, m_computeCFLTimeStep());
+                m_timeStep = std::min(m_maxDT, m_timeStep);
+
+                if(std::isnan(m_timeStep))
+                    throw std::runtime_error("NaN time step!");
+            }
+            else
+                m_timeStep = std::min(m_maxDT, m_timeStep*m_coeffDTincrease);
+        }
+    }
+
+    if(m_pProblem->isOutputVerbose())
+    {
+        std::cout << "Time steps accepted/rejected: " << m_acceptedStepsCount
+                  << "/" << m_rejectedStepsCount << std::endl;
     }
 }
 
+double SolverIncompNewton::m_computeDTError() const
+{
+    double error = 0;
+    for(const auto& pEquation : m_pEquations)
+    {
+        const NonLinearAlgo* pAlgo = pEquation->getNonLinearAlgo();
+        if(pAlgo == nullptr || pAlgo->getLastIterCount() == 0)
+            continue;
+
+        error = std::max(error, static_cast<double>(pAlgo->getLastIterCount())/m_targetIterCount);
+
+        const double contraction = pAlgo->getLastContraction();
+        if(contraction > 0)
+            error = std::max(error, contraction/m_targetContraction);
+    }
+
+    //Avoid infinite growth when nothing limits the step
+    return std::max(error, 1e-2);
+}
+
+double SolverIncompNewton::m_computeCFLTimeStep() const
+{
+    if(m_pProblem->getID() == "Conduction")
+        return std::numeric_limits<double>::max();
+
+    const unsigned short dim = m_pMesh->getDim();
+    double timeStep2 = std::numeric_limits<double>::max();
+
+    #pragma omp parallel for default(shared) reduction(min:timeStep2)
+    for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
+    {
+        const Element& element = m_pMesh->getElement(elm);
+        double he = 2*element.getRin();
+
+        double maxSquaredSpeed = 0;
+        for(std::size_t n = 0 ; n < m_pMesh->getNodesPerElm() ; ++n)
+        {
+            const Node& node = element.getNode(n);
+
+            double u2 = 0;
+            for(unsigned short d = 0 ; d < dim ; ++d)
+                u2 += node.getState(d)*node.getState(d);
+
+            maxSquaredSpeed = std::max(maxSquaredSpeed, u2);
+        }
+
+        if(maxSquaredSpeed > 0)
+            timeStep2 = std::min(timeStep2, m_maxCFL*m_maxCFL*he*he/maxSquaredSpeed);
+    }
+
+    return std::sqrt(timeStep2);
+}
+
 bool SolverIncompNewton::m_solveIncompNewtonNoT()
 {
-    m_clock.start();
-    m_solveSucceed = m_pEquations[0]->solve();
-    m_accumalatedTimes["Solving momentum continuity equation"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Solving momentum continuity equation");
+        m_solveSucceed = m_pEquations[0]->solve();
+    }
 
     if(m_solveSucceed)
     {
-        m_clock.start();
+        PROFILE_SCOPE("Remeshing");
         m_pProblem->updateTime(m_timeStep);
         m_pMesh->remesh(m_pProblem->isOutputVerbose());
-        m_accumalatedTimes["Remeshing"] += m_clock.end();
     }
 
     return m_solveSucceed;
@@ -250,34 +402,36 @@ bool SolverIncompNewton::m_solveBoussinesq()
 {
     if(m_solveHeatFirst)
     {
-        m_clock.start();
-        m_solveSucceed = m_pEquations[1]->solve();
-        m_accumalatedTimes["Solving heat equation"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Solving heat equation");
+            m_solveSucceed = m_pEquations[1]->solve();
+        }
         if(!m_solveSucceed)
             return m_solveSucceed;
     }
 
-    m_clock.start();
-    m_solveSucceed = m_pEquations[0]->solve();
-    m_accumalatedTimes["Solving momentum continuity equation"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Solving momentum continuity equation");
+        m_solveSucceed = m_pEquations[0]->solve();
+    }
     if(!m_solveSucceed)
         return m_solveSucceed;
 
     if(!m_solveHeatFirst)
     {
-        m_clock.start();
-        m_solveSucceed = m_pEquations[1]->solve();
-        m_accumalatedTimes["Solving heat equation"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Solving heat equation");
+            m_solveSucceed = m_pEquations[1]->solve();
+        }
         if(!m_solveSucceed)
             return m_solveSucceed;
     }
 
     if(m_solveSucceed)
     {
-        m_clock.start();
+        PROFILE_SCOPE("Remeshing");
         m_pProblem->updateTime(m_timeStep);
         m_pMesh->remesh(m_pProblem->isOutputVerbose());
-        m_accumalatedTimes["Remeshing"] += m_clock.end();
     }
 
     return m_solveSucceed;
@@ -285,9 +439,10 @@ bool SolverIncompNewton::m_solveBoussinesq()
 
 bool SolverIncompNewton::m_solveConduction()
 {
-    m_clock.start();
-    m_solveSucceed = m_pEquations[0]->solve();
-    m_accumalatedTimes["Solving heat equation"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Solving heat equation");
+        m_solveSucceed = m_pEquations[0]->solve();
+    }
 
     if(m_solveSucceed)
         m_pProblem->updateTime(m_timeStep);
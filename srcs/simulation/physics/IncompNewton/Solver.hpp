@@ -15,14 +15,27 @@ class SIMULATION_API SolverIncompNewton: public Solver
         ~SolverIncompNewton() override;
 
         void displayParams() const override;
+        void displayTimeStats() const override;
 
         bool solveOneTimeStep() override;
         void computeNextDT() override;
 
+        std::vector<double> getCheckpointData() const override;
+        void setCheckpointData(const std::vector<double>& data) override;
+
     protected:
         double m_coeffDTincrease;
         double m_coeffDTDecrease;
 
+        bool m_predictiveDT;            /**< Use the PI controller based on the non-linear algorithms statistics ? */
+        unsigned int m_targetIterCount; /**< Number of non-linear iterations the controller aims at. */
+        double m_targetContraction;     /**< Residual contraction rate the controller aims at. */
+        double m_maxCFL;                /**< Maximum CFL number allowed by the controller. */
+        double m_prevDTError;           /**< Error indicator of the previous accepted step (0 if none). */
+
+        std::size_t m_acceptedStepsCount;
+        std::size_t m_rejectedStepsCount;
+
         bool m_solveHeatFirst;
         bool m_useIterativSolver;
 
@@ -31,6 +44,12 @@ class SIMULATION_API SolverIncompNewton: public Solver
         bool m_solveBoussinesq();
         bool m_solveConduction();
 
+        /// \return The error indicator (1 meaning on target) of the last step computed from the non-linear algorithms statistics.
+        double m_computeDTError() const;
+
+        /// \return The largest time step satisfying the CFL condition with the current velocities.
+        double m_computeCFLTimeStep() const;
+
 };
 
 #endif // SOLVERINCOMPNEWTON_HPP_INCLUDED
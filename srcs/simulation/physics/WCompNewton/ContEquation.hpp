@@ -22,6 +22,8 @@ class ContEqWCompNewton : public Equation
 
         void displayParams() const override;
 
+        MemoryUsage getMemoryUsage() const override;
+
         double getSquaredSpeedEquiv(const Node& node) const override;
         bool solve() override;
         void preCompute() override;
@@ -66,6 +68,9 @@ class ContEqWCompNewton : public Equation
         void m_buildSystemdpdt();
         void m_applyBCdpdt();
 
+        void m_keepInactiveNodesState(Eigen::VectorXd& q, unsigned int state);
+        void m_fillInactiveNodesMass();
+
         void m_buildSystemFIC();
         void m_applyBCFIC();
         double m_computeTauFIC(const Element& element) const;
@@ -1,6 +1,6 @@
 #include "ContEquation.hpp"
 #include "../../Problem.hpp"
-#include "../../Solver.hpp"
+#include "Solver.hpp"
 #include "../../utility/StatesFromToQ.hpp"
 
 template<unsigned short dim>
@@ -113,6 +113,16 @@ void ContEqWCompNewton<dim>::displayParams() const
               << " * Version: " << static_cast<int>(m_version) << std::endl;
 }
 
+template<unsigned short dim>
+MemoryUsage ContEqWCompNewton<dim>::getMemoryUsage() const
+{
+    MemoryUsage usage = Equation::getMemoryUsage();
+    usage.matrices = getMemorySize(m_MeLumped) + getMemorySize(m_F0e) +
+                     getMemorySize(m_invM) + getMemorySize(m_F0);
+
+    return usage;
+}
+
 template<unsigned short dim>
 double ContEqWCompNewton<dim>::getSquaredSpeedEquiv(const Node& node) const
 {
@@ -125,43 +135,52 @@ bool ContEqWCompNewton<dim>::solve()
     if(m_pProblem->isOutputVerbose())
         std::cout << "Continuity Equation" << std::endl;
 
-    m_clock.start();
+    PROFILE_TIMER(prepareMatrixAssemblyTimer, "Prepare matrix assembly");
     Eigen::VectorXd qRho(m_pMesh->getNodesCount());
     Eigen::VectorXd qP(m_pMesh->getNodesCount());
-    m_accumalatedTimes["Prepare matrix assembly"] += m_clock.end();
+    prepareMatrixAssemblyTimer.stop();
 
     if(m_version == EqType::DPDt)
     {
         m_buildSystemdpdt();
-        m_clock.start();
-        m_applyBCdpdt();
-        m_accumalatedTimes["Apply boundary conditions"] += m_clock.end();
-        qP = m_invM*m_F0;
-        m_accumalatedTimes["Solve system"] += m_clock.end();
-
-        m_clock.start();
-        setNodesStatesfromQ(m_pMesh, qP, m_statesIndex[0], m_statesIndex[0]);
-
-        qRho = m_getRhoFromPTaitMurnagham(qP);
-        setNodesStatesfromQ(m_pMesh, qRho, m_statesIndex[1], m_statesIndex[1]);
-        m_accumalatedTimes["Update solutions"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Apply boundary conditions");
+            m_applyBCdpdt();
+        }
+        {
+            PROFILE_SCOPE("Solve system");
+            qP = m_invM*m_F0;
+            m_keepInactiveNodesState(qP, m_statesIndex[0]);
+        }
+
+        {
+            PROFILE_SCOPE("Update solutions");
+            setNodesStatesfromQ(m_pMesh, qP, m_statesIndex[0], m_statesIndex[0]);
+
+            qRho = m_getRhoFromPTaitMurnagham(qP);
+            setNodesStatesfromQ(m_pMesh, qRho, m_statesIndex[1], m_statesIndex[1]);
+        }
     }
     else
     {
         m_buildSystem();
-        m_clock.start();
-        m_applyBC();
-        m_accumalatedTimes["Apply boundary conditions"] += m_clock.end();
-        m_clock.start();
-        qRho = m_invM*m_F0;
-        m_accumalatedTimes["Solve system"] += m_clock.end();
-
-        m_clock.start();
-        setNodesStatesfromQ(m_pMesh, qRho, m_statesIndex[1], m_statesIndex[1]);
-
-        qP = m_getPFromRhoTaitMurnagham(qRho);
-        setNodesStatesfromQ(m_pMesh, qP, m_statesIndex[0], m_statesIndex[0]);
-        m_accumalatedTimes["Update solutions"] += m_clock.end();
+        {
+            PROFILE_SCOPE("Apply boundary conditions");
+            m_applyBC();
+        }
+        {
+            PROFILE_SCOPE("Solve system");
+            qRho = m_invM*m_F0;
+            m_keepInactiveNodesState(qRho, m_statesIndex[1]);
+        }
+
+        {
+            PROFILE_SCOPE("Update solutions");
+            setNodesStatesfromQ(m_pMesh, qRho, m_statesIndex[1], m_statesIndex[1]);
+
+            qP = m_getPFromRhoTaitMurnagham(qRho);
+            setNodesStatesfromQ(m_pMesh, qP, m_statesIndex[0], m_statesIndex[0]);
+        }
     }
 
     return true;
@@ -174,6 +193,41 @@ void ContEqWCompNewton<dim>::preCompute()
         m_buildF0();
 }
 
+template<unsigned short dim>
+void ContEqWCompNewton<dim>::m_keepInactiveNodesState(Eigen::VectorXd& q, unsigned int state)
+{
+    const SolverWCompNewton* pSolver = static_cast<const SolverWCompNewton*>(m_pSolver);
+    if(!pSolver->isLocalTimeStepping())
+        return;
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < m_pMesh->getNodesCount() ; ++n)
+    {
+        if(!pSolver->isNodeActive(n))
+            q[n] = m_pMesh->getNode(n).getState(state);
+    }
+}
+
+template<unsigned short dim>
+void ContEqWCompNewton<dim>::m_fillInactiveNodesMass()
+{
+    const SolverWCompNewton* pSolver = static_cast<const SolverWCompNewton*>(m_pSolver);
+    if(!pSolver->isLocalTimeStepping())
+        return;
+
+    auto& invMDiag = m_invM.diagonal();
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < m_pMesh->getNodesCount() ; ++n)
+    {
+        if(!pSolver->isNodeActive(n))
+        {
+            invMDiag[n] = 1;
+            m_F0(n) = 0;
+        }
+    }
+}
+
 template<unsigned short dim>
 void ContEqWCompNewton<dim>::m_applyBC()
 {
@@ -195,45 +249,55 @@ void ContEqWCompNewton<dim>::m_applyBC()
 template<unsigned short dim>
 void ContEqWCompNewton<dim>::m_buildF0()
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatrixAssemblyTimer, "Prepare matrix assembly");
+    const SolverWCompNewton* pSolver = static_cast<const SolverWCompNewton*>(m_pSolver);
     constexpr unsigned short nodPerEl = dim + 1;
 
     m_F0.resize(m_pMesh->getNodesCount()); m_F0.setZero();
 
     std::vector<Eigen::Matrix<double, nodPerEl, 1>> F0e(m_pMesh->getElementsCount());
-    m_accumalatedTimes["Prepare matrix assembly"] += m_clock.end();
+    prepareMatrixAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
+        {
+            if(!pSolver->isElementActive(elm))
+                continue;
+
+            const Element& element = m_pMesh->getElement(elm);
 
-        Eigen::Matrix<double, nodPerEl, 1> Rho = getElementState<dim>(element, m_statesIndex[1]);
+            Eigen::Matrix<double, nodPerEl, 1> Rho = getElementState<dim>(element, m_statesIndex[1]);
 
-        Eigen::Matrix<double, nodPerEl, nodPerEl> Mrhoe = m_pMatBuilder->getM(element);
+            Eigen::Matrix<double, nodPerEl, nodPerEl> Mrhoe = m_pMatBuilder->getM(element);
 
-        F0e[elm] = Mrhoe*Rho;
+            F0e[elm] = Mrhoe*Rho;
+        }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
     }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
 
-    m_clock.start();
-    for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Assemble matrix");
+        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
+        {
+            if(!pSolver->isElementActive(elm))
+                continue;
+
+            const Element& element = m_pMesh->getElement(elm);
 
-        for(uint8_t i = 0 ; i < m_pMesh->getNodesPerElm() ; ++i)
-            m_F0(element.getNodeIndex(i)) += F0e[elm](i);
+            for(uint8_t i = 0 ; i < m_pMesh->getNodesPerElm() ; ++i)
+                m_F0(element.getNodeIndex(i)) += F0e[elm](i);
+        }
     }
-    m_accumalatedTimes["Assemble matrix"] += m_clock.end();
 }
 
 template<unsigned short dim>
 void ContEqWCompNewton<dim>::m_buildSystem()
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatrixAssemblyTimer, "Prepare matrix assembly");
+    const SolverWCompNewton* pSolver = static_cast<const SolverWCompNewton*>(m_pSolver);
     constexpr unsigned short nodPerEl = dim + 1;
 
     m_invM.resize(m_pMesh->getNodesCount()); m_invM.setZero();
@@ -246,58 +310,70 @@ void ContEqWCompNewton<dim>::m_buildSystem()
         m_F0.resize(m_pMesh->getNodesCount()); m_F0.setZero();
         F0e.resize(m_pMesh->getElementsCount());
     }
-    m_accumalatedTimes["Prepare matrix assembly"] += m_clock.end();
+    prepareMatrixAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
-
-        Eigen::Matrix<double, nodPerEl, nodPerEl> Me = m_pMatBuilder->getM(element);
-        MeLumped[elm] = MatrixBuilder<dim>:: template lump2<nodPerEl>(Me);
-
-        if(m_version == EqType::DRhoDt)
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
         {
-            Eigen::Matrix<double, nodPerEl, 1> Rho = getElementState<dim>(element, m_statesIndex[1]);
-            Eigen::Matrix<double, dim*nodPerEl, 1> V = getElementVecState<dim>(element, m_statesIndex[2]);
+            if(!pSolver->isElementActive(elm))
+                continue;
 
-            GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
-            BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
-            Eigen::Matrix<double, nodPerEl, dim*nodPerEl> Drhoe = m_pMatBuilder->getD(element, Be);
+            const Element& element = m_pMesh->getElement(elm);
 
-            F0e[elm] = - m_pSolver->getTimeStep()*Drhoe*V;
+            Eigen::Matrix<double, nodPerEl, nodPerEl> Me = m_pMatBuilder->getM(element);
+            MeLumped[elm] = MatrixBuilder<dim>:: template lump2<nodPerEl>(Me);
 
-            if(m_stabilization != Stab::None)
-                F0e[elm] += Me*Rho;
-            else
-                F0e[elm] += MeLumped[elm]*Rho;
+            if(m_version == EqType::DRhoDt)
+            {
+                Eigen::Matrix<double, nodPerEl, 1> Rho = getElementState<dim>(element, m_statesIndex[1]);
+                Eigen::Matrix<double, dim*nodPerEl, 1> V = getElementVecState<dim>(element, m_statesIndex[2]);
+
+                GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
+                BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
+                Eigen::Matrix<double, nodPerEl, dim*nodPerEl> Drhoe = m_pMatBuilder->getD(element, Be);
+
+                //Each row belongs to one node, which advances with its own time step
+                Eigen::Matrix<double, nodPerEl, 1> DrhoeV = Drhoe*V;
+                for(unsigned short i = 0 ; i < nodPerEl ; ++i)
+                    F0e[elm](i) = - pSolver->getNodeTimeStep(element.getNodeIndex(i))*DrhoeV(i);
+
+                if(m_stabilization != Stab::None)
+                    F0e[elm] += Me*Rho;
+                else
+                    F0e[elm] += MeLumped[elm]*Rho;
+            }
         }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
     }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
 
-    m_clock.start();
-    auto& invMDiag = m_invM.diagonal();
-
-    for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Assemble matrix");
+        auto& invMDiag = m_invM.diagonal();
 
-        for(unsigned short i = 0 ; i < nodPerEl ; ++i)
+        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
         {
-            invMDiag[element.getNodeIndex(i)] += MeLumped[elm].diagonal()[i];
+            if(!pSolver->isElementActive(elm))
+                continue;
 
-            if(m_version == EqType::DRhoDt)
+            const Element& element = m_pMesh->getElement(elm);
+
+            for(unsigned short i = 0 ; i < nodPerEl ; ++i)
             {
-                m_F0(element.getNodeIndex(i)) += F0e[elm](i);
+                invMDiag[element.getNodeIndex(i)] += MeLumped[elm].diagonal()[i];
+
+                if(m_version == EqType::DRhoDt)
+                {
+                    m_F0(element.getNodeIndex(i)) += F0e[elm](i);
+                }
             }
         }
-    }
 
-    MatrixBuilder<dim>::inverse(m_invM);
-    m_accumalatedTimes["Assemble matrix"] += m_clock.end();
+        m_fillInactiveNodesMass();
+        MatrixBuilder<dim>::inverse(m_invM);
+    }
 }
 
 template<unsigned short dim>
@@ -352,7 +428,8 @@ void ContEqWCompNewton<dim>::m_applyBCdpdt()
 template<unsigned short dim>
 void ContEqWCompNewton<dim>::m_buildSystemdpdt()
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatrixAssemblyTimer, "Prepare matrix assembly");
+    const SolverWCompNewton* pSolver = static_cast<const SolverWCompNewton*>(m_pSolver);
     constexpr unsigned short nodPerEl = dim + 1;
 
     m_invM.resize(m_pMesh->getNodesCount()); m_invM.setZero();
@@ -361,53 +438,62 @@ void ContEqWCompNewton<dim>::m_buildSystemdpdt()
     m_F0.resize(m_pMesh->getNodesCount()); m_F0.setZero();
     m_F0e.resize(m_pMesh->getElementsCount());
 
-    m_accumalatedTimes["Prepare matrix assembly"] += m_clock.end();
-
-    double dt = m_pSolver->getTimeStep();
+    prepareMatrixAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
+        {
+            if(!pSolver->isElementActive(elm))
+                continue;
 
-        Eigen::Matrix<double, nodPerEl, nodPerEl> Me = m_pMatBuilder->getM(element);
-        m_MeLumped[elm] = MatrixBuilder<dim>:: template lump2<nodPerEl>(Me);
+            const Element& element = m_pMesh->getElement(elm);
 
-        Eigen::Matrix<double, nodPerEl, 1> P = getElementState<dim>(element, m_statesIndex[0]);
-        Eigen::Matrix<double, dim*nodPerEl, 1> V = getElementVecState<dim>(element, m_statesIndex[2]);
+            Eigen::Matrix<double, nodPerEl, nodPerEl> Me = m_pMatBuilder->getM(element);
+            m_MeLumped[elm] = MatrixBuilder<dim>:: template lump2<nodPerEl>(Me);
 
-        GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
-        BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
-        Eigen::Matrix<double, nodPerEl, dim*nodPerEl> Drhoe = m_pMatBuilder->getD(element, Be);
+            Eigen::Matrix<double, nodPerEl, 1> P = getElementState<dim>(element, m_statesIndex[0]);
+            Eigen::Matrix<double, dim*nodPerEl, 1> V = getElementVecState<dim>(element, m_statesIndex[2]);
 
-        m_F0e[elm] = - dt*Drhoe*V;
+            GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
+            BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
+            Eigen::Matrix<double, nodPerEl, dim*nodPerEl> Drhoe = m_pMatBuilder->getD(element, Be);
 
-        if(m_stabilization == Stab::Meduri)
-            m_F0e[elm] += Me*P;
-        else
-            m_F0e[elm] += m_MeLumped[elm]*P;
-    }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
+            Eigen::Matrix<double, nodPerEl, 1> DrhoeV = Drhoe*V;
+            for(unsigned short i = 0 ; i < nodPerEl ; ++i)
+                m_F0e[elm](i) = - pSolver->getNodeTimeStep(element.getNodeIndex(i))*DrhoeV(i);
 
-    m_clock.start();
-    auto& invMDiag = m_invM.diagonal();
+            if(m_stabilization == Stab::Meduri)
+                m_F0e[elm] += Me*P;
+            else
+                m_F0e[elm] += m_MeLumped[elm]*P;
+        }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
+    }
 
-    for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Assemble matrix");
+        auto& invMDiag = m_invM.diagonal();
 
-        for(unsigned short i = 0 ; i < nodPerEl ; ++i)
+        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
         {
-            invMDiag[element.getNodeIndex(i)] += m_MeLumped[elm].diagonal()[i];
+            if(!pSolver->isElementActive(elm))
+                continue;
+
+            const Element& element = m_pMesh->getElement(elm);
 
-            m_F0(element.getNodeIndex(i)) += m_F0e[elm](i);
+            for(unsigned short i = 0 ; i < nodPerEl ; ++i)
+            {
+                invMDiag[element.getNodeIndex(i)] += m_MeLumped[elm].diagonal()[i];
+
+                m_F0(element.getNodeIndex(i)) += m_F0e[elm](i);
+            }
         }
-    }
 
-    MatrixBuilder<dim>::inverse(m_invM);
+        m_fillInactiveNodesMass();
+        MatrixBuilder<dim>::inverse(m_invM);
 
-    m_accumalatedTimes["Assemble matrix"] += m_clock.end();
+    }
 }
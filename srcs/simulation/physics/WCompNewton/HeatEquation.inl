@@ -121,6 +121,15 @@ void HeatEqWCompNewton<dim>::displayParams() const
     }
 }
 
+template<unsigned short dim>
+MemoryUsage HeatEqWCompNewton<dim>::getMemoryUsage() const
+{
+    MemoryUsage usage = Equation::getMemoryUsage();
+    usage.matrices = getMemorySize(m_invM) + getMemorySize(m_F);
+
+    return usage;
+}
+
 template<unsigned short dim>
 double HeatEqWCompNewton<dim>::getDiffusionParam(const Node& node) const
 {
@@ -135,17 +144,19 @@ bool HeatEqWCompNewton<dim>::solve()
 
     m_buildSystem();
 
-    m_clock.start();
-    m_applyBC();
-    m_accumalatedTimes["Apply boundary conditions"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Apply boundary conditions");
+        m_applyBC();
+    }
 
-    m_clock.start();
+    PROFILE_TIMER(solveSystemTimer, "Solve system");
     Eigen::VectorXd qT = m_invM*m_F;
-    m_accumalatedTimes["Solve system"] += m_clock.end();
+    solveSystemTimer.stop();
 
-    m_clock.start();
-    setNodesStatesfromQ(m_pMesh, qT, m_statesIndex[0], m_statesIndex[0]);
-    m_accumalatedTimes["Update solutions"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Update solutions");
+        setNodesStatesfromQ(m_pMesh, qT, m_statesIndex[0], m_statesIndex[0]);
+    }
 
     return true;
 }
@@ -246,7 +257,7 @@ void HeatEqWCompNewton<dim>::m_applyBC()
 template<unsigned short dim>
 void HeatEqWCompNewton<dim>::m_buildSystem()
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatrixAssemblyTimer, "Prepare matrix assembly");
     constexpr unsigned short nodPerEl = dim + 1;
     const std::size_t elementsCount = m_pMesh->getElementsCount();
     const std::size_t nodesCount = m_pMesh->getNodesCount();
@@ -256,45 +267,47 @@ void HeatEqWCompNewton<dim>::m_buildSystem()
 
     m_F.resize(nodesCount); m_F.setZero();
     std::vector<Eigen::Matrix<double, nodPerEl, 1>> FTote(elementsCount);
-    m_accumalatedTimes["Prepare matrix assembly"] += m_clock.end();
+    prepareMatrixAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+        {
+            const Element& element = m_pMesh->getElement(elm);
 
-        Eigen::Matrix<double, nodPerEl, 1> T = getElementState<dim>(element, m_statesIndex[0]);
+            Eigen::Matrix<double, nodPerEl, 1> T = getElementState<dim>(element, m_statesIndex[0]);
 
-        GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
-        BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
-        Me[elm] = m_pMatBuilder->getM(element);
-        MatrixBuilder<dim>:: template lump<nodPerEl>(Me[elm]);
-        Eigen::Matrix<double, nodPerEl, nodPerEl> Le = m_pMatBuilder->getL(element, Be, gradNe);
+            GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
+            BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
+            Me[elm] = m_pMatBuilder->getM(element);
+            MatrixBuilder<dim>:: template lump<nodPerEl>(Me[elm]);
+            Eigen::Matrix<double, nodPerEl, nodPerEl> Le = m_pMatBuilder->getL(element, Be, gradNe);
 
-        FTote[elm] = - m_pSolver->getTimeStep()*Le*T + Me[elm]*T;
+            FTote[elm] = - m_pSolver->getTimeStep()*Le*T + Me[elm]*T;
+        }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
     }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
 
-    m_clock.start();
-    auto& invMDiag = m_invM.diagonal();
-
-    for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Assemble matrix");
+        auto& invMDiag = m_invM.diagonal();
 
-        for(unsigned short i = 0 ; i < dim + 1 ; ++i)
+        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
         {
-            invMDiag[element.getNodeIndex(i)] += Me[elm].diagonal()[i];
+            const Element& element = m_pMesh->getElement(elm);
 
-            m_F(element.getNodeIndex(i)) += FTote[elm](i);
+            for(unsigned short i = 0 ; i < dim + 1 ; ++i)
+            {
+                invMDiag[element.getNodeIndex(i)] += Me[elm].diagonal()[i];
+
+                m_F(element.getNodeIndex(i)) += FTote[elm](i);
+            }
         }
-    }
 
-    MatrixBuilder<dim>::inverse(m_invM);
-    m_accumalatedTimes["Assemble matrix"] += m_clock.end();
+        MatrixBuilder<dim>::inverse(m_invM);
+    }
 }
 
 template<unsigned short dim>
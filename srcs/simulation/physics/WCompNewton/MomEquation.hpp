@@ -22,6 +22,8 @@ class MomEqWCompNewton : public Equation
 
         void displayParams() const override;
 
+        MemoryUsage getMemoryUsage() const override;
+
         double getSquaredSpeedEquiv(const Node& node) const override;
         double getDiffusionParam(const Node& node) const override;
         bool solve() override;
@@ -1,6 +1,6 @@
 #include "MomEquation.hpp"
 #include "../../Problem.hpp"
-#include "../../Solver.hpp"
+#include "Solver.hpp"
 #include "../../utility/StatesFromToQ.hpp"
 #include "../../utility/Clock.hpp"
 
@@ -180,6 +180,15 @@ void MomEqWCompNewton<dim>::displayParams() const
     }
 }
 
+template<unsigned short dim>
+MemoryUsage MomEqWCompNewton<dim>::getMemoryUsage() const
+{
+    MemoryUsage usage = Equation::getMemoryUsage();
+    usage.matrices = getMemorySize(m_invM) + getMemorySize(m_F);
+
+    return usage;
+}
+
 template<unsigned short dim>
 double MomEqWCompNewton<dim>::getSquaredSpeedEquiv(const Node& node) const
 {
@@ -203,24 +212,52 @@ bool MomEqWCompNewton<dim>::solve()
     if(m_pProblem->isOutputVerbose())
         std::cout << "Momentum Equation" << std::endl;
 
-    m_clock.start();
+    const SolverWCompNewton* pSolver = static_cast<const SolverWCompNewton*>(m_pSolver);
+
+    PROFILE_TIMER(updateSolutionsTimer, "Update solutions");
     Eigen::VectorXd qV1half = getQFromNodesStates(m_pMesh, m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim() - 1);
-    m_accumalatedTimes["Update solutions"] += m_clock.end();
+    Eigen::VectorXd qDT;
+    if(pSolver->isLocalTimeStepping())
+        qDT = pSolver->getNodesTimeStep(m_pMesh->getDim());
+    updateSolutionsTimer.stop();
 
     m_buildSystem();
 
-    m_clock.start();
-    m_applyBC();
-    m_accumalatedTimes["Apply boundary conditions"] += m_clock.end();
-    m_clock.start();
+    {
+        PROFILE_SCOPE("Apply boundary conditions");
+        m_applyBC();
+    }
+    PROFILE_TIMER(solveSystemTimer, "Solve system");
     Eigen::VectorXd qAcc = m_invM*m_F;
-    m_accumalatedTimes["Solve system"] += m_clock.end();
+    solveSystemTimer.stop();
+
+    {
+        PROFILE_SCOPE("Update solutions");
+        if(pSolver->isLocalTimeStepping())
+        {
+            //Nodes which are not active keep the acceleration of their last update
+            const std::size_t nodesCount = m_pMesh->getNodesCount();
 
-    m_clock.start();
-    Eigen::VectorXd qV = qV1half + 0.5*m_pSolver->getTimeStep()*qAcc;
-    setNodesStatesfromQ(m_pMesh, qV, m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim() - 1);
-    setNodesStatesfromQ(m_pMesh, qAcc, m_statesIndex[1], m_statesIndex[1] + m_pMesh->getDim() - 1);
-    m_accumalatedTimes["Update solutions"] += m_clock.end();
+            #pragma omp parallel for default(shared)
+            for(std::size_t n = 0 ; n < nodesCount ; ++n)
+            {
+                if(pSolver->isNodeActive(n))
+                    continue;
+
+                const Node& node = m_pMesh->getNode(n);
+                for(unsigned short d = 0 ; d < dim ; ++d)
+                    qAcc[n + d*nodesCount] = node.getState(m_statesIndex[1] + d);
+            }
+        }
+
+        Eigen::VectorXd qV;
+        if(pSolver->isLocalTimeStepping())
+            qV = qV1half + 0.5*qDT.cwiseProduct(qAcc);
+        else
+            qV = qV1half + 0.5*pSolver->getTimeStep()*qAcc;
+        setNodesStatesfromQ(m_pMesh, qV, m_statesIndex[0], m_statesIndex[0] + m_pMesh->getDim() - 1);
+        setNodesStatesfromQ(m_pMesh, qAcc, m_statesIndex[1], m_statesIndex[1] + m_pMesh->getDim() - 1);
+    }
 
     return true;
 }
@@ -228,7 +265,8 @@ bool MomEqWCompNewton<dim>::solve()
 template<unsigned short dim>
 void MomEqWCompNewton<dim>::m_buildSystem()
 {
-    m_clock.start();
+    PROFILE_TIMER(prepareMatrixAssemblyTimer, "Prepare matrix assembly");
+    const SolverWCompNewton* pSolver = static_cast<const SolverWCompNewton*>(m_pSolver);
     const std::size_t elementsCount = m_pMesh->getElementsCount();
     const std::size_t nodesCount = m_pMesh->getNodesCount();
     constexpr unsigned short nodPerEl = dim + 1;
@@ -239,66 +277,91 @@ void MomEqWCompNewton<dim>::m_buildSystem()
     m_F.resize(dim*nodesCount); m_F.setZero();
     std::vector<Eigen::Matrix<double, dim*nodPerEl, 1>> FTote(elementsCount);
 
-    m_accumalatedTimes["Prepare matrix assembly"] += m_clock.end();
+    prepareMatrixAssemblyTimer.stop();
 
-    m_clock.start();
-    Eigen::setNbThreads(1);
-    #pragma omp parallel for default(shared)
-    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Compute triplets");
+        Eigen::setNbThreads(1);
+        #pragma omp parallel for default(shared)
+        for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+        {
+            if(!pSolver->isElementActive(elm))
+                continue;
 
-        Eigen::Matrix<double, dim*nodPerEl, 1> V = getElementVecState<dim>(element, m_statesIndex[0]);
-        Eigen::Matrix<double, nodPerEl, 1> P = getElementState<dim>(element, m_statesIndex[2]);
+            const Element& element = m_pMesh->getElement(elm);
 
-        GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
-        BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
+            Eigen::Matrix<double, dim*nodPerEl, 1> V = getElementVecState<dim>(element, m_statesIndex[0]);
+            Eigen::Matrix<double, nodPerEl, 1> P = getElementState<dim>(element, m_statesIndex[2]);
 
-        Eigen::Matrix<double, nodPerEl, nodPerEl> MeTemp = m_pMatBuilder->getM(element);
-        Me[elm] = MatrixBuilder<dim>::diagBlock(MeTemp);
-        MatrixBuilder<dim>:: template lump<dim*nodPerEl>(Me[elm]);
-        Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Ke = m_pMatBuilder->getK(element, Be);
-        Eigen::Matrix<double, nodPerEl, dim*nodPerEl> De = m_pMatBuilder->getD(element, Be);
-        Eigen::Matrix<double, dim*nodPerEl, 1> Fe = m_pMatBuilder->getF(element, m_bodyForce, Be);
+            GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
+            BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
 
-        FTote[elm] = -Ke*V + De.transpose()*P + Fe;
+            Eigen::Matrix<double, nodPerEl, nodPerEl> MeTemp = m_pMatBuilder->getM(element);
+            Me[elm] = MatrixBuilder<dim>::diagBlock(MeTemp);
+            MatrixBuilder<dim>:: template lump<dim*nodPerEl>(Me[elm]);
+            Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Ke = m_pMatBuilder->getK(element, Be);
+            Eigen::Matrix<double, nodPerEl, dim*nodPerEl> De = m_pMatBuilder->getD(element, Be);
+            Eigen::Matrix<double, dim*nodPerEl, 1> Fe = m_pMatBuilder->getF(element, m_bodyForce, Be);
 
-        if(m_phaseChange)
-        {
-            Eigen::Matrix<double, nodPerEl, nodPerEl> MeTemp2 = m_pMatBuilder2->getM(element);
-            Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me2 = MatrixBuilder<dim>::diagBlock(MeTemp2);
-            FTote[elm] -= Me2*V;
+            FTote[elm] = -Ke*V + De.transpose()*P + Fe;
+
+            if(m_phaseChange)
+            {
+                Eigen::Matrix<double, nodPerEl, nodPerEl> MeTemp2 = m_pMatBuilder2->getM(element);
+                Eigen::Matrix<double, dim*nodPerEl, dim*nodPerEl> Me2 = MatrixBuilder<dim>::diagBlock(MeTemp2);
+                FTote[elm] -= Me2*V;
+            }
         }
+        Eigen::setNbThreads(m_pProblem->getThreadCount());
     }
-    Eigen::setNbThreads(m_pProblem->getThreadCount());
-    m_accumalatedTimes["Compute triplets"] += m_clock.end();
-
-    m_clock.start();
-    auto& invMDiag = m_invM.diagonal();
 
-    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
     {
-        const Element& element = m_pMesh->getElement(elm);
+        PROFILE_SCOPE("Assemble matrix");
+        auto& invMDiag = m_invM.diagonal();
 
-        for(unsigned short i = 0 ; i < dim + 1 ; ++i)
+        for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
         {
-            for(unsigned short d = 0 ; d < dim ; ++d)
+            if(!pSolver->isElementActive(elm))
+                continue;
+
+            const Element& element = m_pMesh->getElement(elm);
+
+            for(unsigned short i = 0 ; i < dim + 1 ; ++i)
             {
-                /********************************************************************
-                                             Build M
-                ********************************************************************/
-                invMDiag[element.getNodeIndex(i) + d*nodesCount] += Me[elm](i + d*nodPerEl, i + d*nodPerEl);
-
-                /************************************************************************
-                                                Build f
-                ************************************************************************/
-                m_F(element.getNodeIndex(i) + d*nodesCount) += FTote[elm](i + d*nodPerEl);
+                for(unsigned short d = 0 ; d < dim ; ++d)
+                {
+                    /********************************************************************
+                                                 Build M
+                    ********************************************************************/
+                    invMDiag[element.getNodeIndex(i) + d*nodesCount] += Me[elm](i + d*nodPerEl, i + d*nodPerEl);
+
+                    /************************************************************************
+                                                    Build f
+                    ************************************************************************/
+                    m_F(element.getNodeIndex(i) + d*nodesCount) += FTote[elm](i + d*nodPerEl);
+                }
             }
         }
-    }
 
-    MatrixBuilder<dim>::inverse(m_invM);
-    m_accumalatedTimes["Assemble matrix"] += m_clock.end();
+        //Nodes which are not active may have no assembled mass, their result is discarded anyway
+        if(pSolver->isLocalTimeStepping())
+        {
+            #pragma omp parallel for default(shared)
+            for(std::size_t n = 0 ; n < nodesCount ; ++n)
+            {
+                if(pSolver->isNodeActive(n))
+                    continue;
+
+                for(unsigned short d = 0 ; d < dim ; ++d)
+                {
+                    invMDiag[n + d*nodesCount] = 1;
+                    m_F(n + d*nodesCount) = 0;
+                }
+            }
+        }
+
+        MatrixBuilder<dim>::inverse(m_invM);
+    }
 }
 
 template<unsigned short dim>
@@ -306,6 +369,7 @@ void MomEqWCompNewton<dim>::m_applyBC()
 {
     assert(m_pMesh->getNodesCount() != 0);
 
+    const SolverWCompNewton* pSolver = static_cast<const SolverWCompNewton*>(m_pSolver);
     const std::size_t nodesCount = m_pMesh->getNodesCount();
     const std::size_t facetsCount = m_pMesh->getFacetsCount();
 
@@ -320,6 +384,9 @@ void MomEqWCompNewton<dim>::m_applyBC()
         if(!onFS)
             continue;
 
+        if(!pSolver->isElementActive(facet.getElementIndex()))
+            continue;
+
         const Element& element = facet.getElement();
         GradNmatType<dim> gradNe = m_pMatBuilder->getGradN(element);
         BmatType<dim> Be = m_pMatBuilder->getB(gradNe);
@@ -341,6 +408,9 @@ void MomEqWCompNewton<dim>::m_applyBC()
     #pragma omp parallel for default(shared) schedule(dynamic)
     for (std::size_t n = 0 ; n < nodesCount ; ++n)
     {
+        if(!pSolver->isNodeActive(n))
+            continue;
+
         int threadIndex = omp_get_thread_num();
         const Node& node = m_pMesh->getNode(n);
 
@@ -1,11 +1,14 @@
 #include "Problem.hpp"
 
+#include <algorithm>
+
 #include "Solver.hpp"
+#include "../../utility/Reduction.hpp"
 #include "../../extractors/Extractors.hpp"
 
 
-ProbWCompNewton::ProbWCompNewton(std::string luaFilePath) :
-Problem(luaFilePath)
+ProbWCompNewton::ProbWCompNewton(std::string luaFilePath, std::string restartFile) :
+Problem(luaFilePath, restartFile)
 {
     if(m_id != "WCompNewtonNoT" && m_id != "BoussinesqWC")
         throw std::runtime_error("the ProbWCompNewton does not know id " + m_id);
@@ -77,150 +80,50 @@ std::vector<std::string> ProbWCompNewton::getWrittableDataName() const
     return writtableDataName;
 }
 
-std::vector<double> ProbWCompNewton::getWrittableData(const std::string& name, std::size_t nodeIndex) const
+WrittableField ProbWCompNewton::resolveWrittableField(const std::string& name) const
 {
-    const Node& node = m_pMesh->getNode(nodeIndex);
+    std::vector<std::string> statesName;
 
-    bool error = false;
+    if(m_pMesh->getDim() == 2)
+        statesName = {"u", "v", "p", "rho", "ax", "ay"};
+    else
+        statesName = {"u", "v", "w", "p", "rho", "ax", "ay", "az"};
 
-    if(m_id == "WCompNewtonNoT")
-    {
-        if(name == "u")
-            return {node.getState(0)};
-        else if(name == "v")
-            return {node.getState(1)};
-        else
-        {
-            if(m_pMesh->getDim() == 2)
-            {
-                if(name == "p")
-                    return {node.getState(2)};
-                else if(name == "rho")
-                    return {node.getState(3)};
-                else if(name == "ax")
-                    return {node.getState(4)};
-                else if(name == "ay")
-                    return {node.getState(5)};
-                else if(name == "ke")
-                    return {0.5*(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1))};
-                else if(name == "magV")
-                    return {std::sqrt(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1))};
-                else if(name == "velocity")
-                    return {node.getState(0), node.getState(1), 0};
-                else if(name == "prevRho" && m_pSolver->getID() == "CDS_FIC")
-                    return {node.getState(6)};
-                else
-                    error = true;
+    if(m_id == "BoussinesqWC")
+        statesName.push_back("T");
 
-            }
-            else
-            {
-                if(name == "w")
-                    return {node.getState(2)};
-                else if(name == "p")
-                    return {node.getState(3)};
-                else if(name == "rho")
-                    return {node.getState(4)};
-                else if(name == "ax")
-                    return {node.getState(5)};
-                else if(name == "ay")
-                    return {node.getState(6)};
-                else if(name == "ay")
-                    return {node.getState(7)};
-                else if(name == "ke")
-                    return {0.5*(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1) + node.getState(2)*node.getState(2))};
-                else if(name == "magV")
-                    return {std::sqrt(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1) + node.getState(2)*node.getState(2))};
-                else if(name == "velocity")
-                    return {node.getState(0), node.getState(1), node.getState(2)};
-                else if(name == "prevRho" && m_pSolver->getID() == "CDS_FIC")
-                    return {node.getState(8)};
-                else
-                    error = true;
-            }
-        }
-    }
-    else if(m_id == "BoussinesqWC")
-    {
-        if(name == "u")
-            return {node.getState(0)};
-        else if(name == "v")
-            return {node.getState(1)};
-        else
-        {
-            if(m_pMesh->getDim() == 2)
-            {
-                if(name == "p")
-                    return {node.getState(2)};
-                else if(name == "rho")
-                    return {node.getState(3)};
-                else if(name == "ax")
-                    return {node.getState(4)};
-                else if(name == "ay")
-                    return {node.getState(5)};
-                else if(name == "T")
-                    return {node.getState(6)};
-                else if(name == "ke")
-                    return {0.5*(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1))};
-                else if(name == "magV")
-                    return {std::sqrt(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1))};
-                else if(name == "velocity")
-                    return {node.getState(0), node.getState(1), 0};
-                else if(name == "prevRho" && m_pSolver->getID() == "CDS_FIC")
-                    return {node.getState(7)};
-                else
-                    error = true;
+    if(m_pSolver->getID() == "CDS_FIC")
+        statesName.push_back("prevRho");
 
-            }
-            else
-            {
-                if(name == "w")
-                    return {node.getState(2)};
-                else if(name == "p")
-                    return {node.getState(3)};
-                else if(name == "rho")
-                    return {node.getState(4)};
-                else if(name == "ax")
-                    return {node.getState(5)};
-                else if(name == "ay")
-                    return {node.getState(6)};
-                else if(name == "ay")
-                    return {node.getState(7)};
-                else if(name == "T")
-                    return {node.getState(8)};
-                else if(name == "ke")
-                    return {0.5*(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1) + node.getState(2)*node.getState(2))};
-                else if(name == "magV")
-                    return {std::sqrt(node.getState(0)*node.getState(0) + node.getState(1)*node.getState(1) + node.getState(2)*node.getState(2))};
-                else if(name == "velocity")
-                    return {node.getState(0), node.getState(1), node.getState(2)};
-                else if(name == "prevRho" && m_pSolver->getID() == "CDS_FIC")
-                    return {node.getState(9)};
-                else
-                    error = true;
-            }
-        }
-    }
+    auto it = std::find(statesName.begin(), statesName.end(), name);
+    if(it != statesName.end())
+        return {WrittableField::Kind::State, static_cast<unsigned int>(it - statesName.begin()), 1};
 
-    if(error)
-        throw std::runtime_error("The data " + name + " cannot be extract from problem " + getID());
+    if(name == "ke")
+        return {WrittableField::Kind::KineticEnergy, 0, 1};
+    else if(name == "magV")
+        return {WrittableField::Kind::VelocityMagnitude, 0, 1};
+    else if(name == "velocity")
+        return {WrittableField::Kind::Velocity, 0, 3};
 
-    return {}; //silence waring
+    throw std::runtime_error("The data " + name + " cannot be extract from problem " + getID());
 }
 
 std::vector<std::string> ProbWCompNewton::getGlobalWrittableDataName() const
 {
-    return {"mass"};
+    std::vector<std::string> globalDataName = {"mass"};
+
+    std::vector<std::string> diagnosticsName = getDiagnosticsName();
+    globalDataName.insert(globalDataName.end(), diagnosticsName.begin(), diagnosticsName.end());
+
+    return globalDataName;
 }
 
 double ProbWCompNewton::getGlobalWrittableData(const std::string& name) const
 {
     if(name == "mass")
     {
-        double mass = 0;
-
-        for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
-        {
+        return parallelSum(m_pMesh->getElementsCount(), [&](std::size_t elm){
             const Element& element = m_pMesh->getElement(elm);
 
             double volume = element.getSize();
@@ -234,11 +137,9 @@ double ProbWCompNewton::getGlobalWrittableData(const std::string& name) const
 
             middleRho /= static_cast<double>(m_pMesh->getNodesPerElm());
 
-            mass += middleRho*volume;
-        }
-
-        return mass;
+            return middleRho*volume;
+        });
     }
     else
-        throw std::runtime_error("The global data " + name + " cannot be extract from problem " + getID());
+        return Problem::getGlobalWrittableData(name);
 }
@@ -21,7 +21,7 @@
 class SIMULATION_API ProbWCompNewton : public Problem
 {
     public:
-        ProbWCompNewton(std::string luaFilePath);
+        ProbWCompNewton(std::string luaFilePath, std::string restartFile = "");
         ProbWCompNewton(const ProbWCompNewton& problem)             = delete;
         ProbWCompNewton& operator=(const ProbWCompNewton& problem)  = delete;
         ProbWCompNewton(ProbWCompNewton&& problem)                  = delete;
@@ -31,10 +31,12 @@ class SIMULATION_API ProbWCompNewton : public Problem
         void displayParams() const override;
 
         std::vector<std::string> getWrittableDataName() const override;
-        std::vector<double> getWrittableData(const std::string& name, std::size_t nodeIndex) const override;
         std::vector<std::string> getGlobalWrittableDataName() const override;
         double getGlobalWrittableData(const std::string& name) const override;
 
+    protected:
+        WrittableField resolveWrittableField(const std::string& name) const override;
+
     private:
 
 };
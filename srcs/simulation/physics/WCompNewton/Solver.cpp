@@ -150,6 +150,21 @@ Solver(pProblem, pMesh, problemParams)
 
     m_securityCoeff = m_solverParams[0].checkAndGet<double>("securityCoeff");
 
+    if(m_solverParams[0].doesVarExist("maxDTLevel"))
+        m_maxDTLevel = m_solverParams[0].checkAndGet<unsigned int>("maxDTLevel");
+    else
+        m_maxDTLevel = 0;
+
+    if(m_maxDTLevel > 0 && !m_adaptDT)
+        throw std::runtime_error("the local time stepping (maxDTLevel > 0) requires adaptDT to be true!");
+
+    //The time step strides are unsigned int powers of two
+    if(m_maxDTLevel >= 31)
+        throw std::runtime_error("the maximum time step level (maxDTLevel) should be lower than 31!");
+
+    m_cycleLength = 1;
+    m_subStep = 0;
+
     m_timeStep = m_initialDT;
 
     //Should we compute the normals and the curvature ?
@@ -173,7 +188,8 @@ void SolverWCompNewton::displayParams() const
 {
     std::cout << "Maximum dt: " << m_maxDT << "\n"
               << "Initial dt: " << m_initialDT << "\n"
-              << "Security coeff: " << m_securityCoeff << std::endl;
+              << "Security coeff: " << m_securityCoeff << "\n"
+              << "Maximum time step level: " << m_maxDTLevel << std::endl;
 
     for(auto& pEquation : m_pEquations)
         pEquation->displayParams();
@@ -184,6 +200,61 @@ std::size_t SolverWCompNewton::getAdditionalStateCount() const
     return 0; //Change this
 }
 
+std::vector<double> SolverWCompNewton::getCheckpointData() const
+{
+    std::vector<double> data = Solver::getCheckpointData();
+    data.push_back(m_subStep);
+    data.push_back(m_cycleLength);
+    data.insert(data.end(), m_nodesStride.begin(), m_nodesStride.end());
+
+    return data;
+}
+
+void SolverWCompNewton::setCheckpointData(const std::vector<double>& data)
+{
+    Solver::setCheckpointData(data);
+
+    if(data.size() <= 2)
+        return;
+
+    if(data.size() < 4)
+        throw std::runtime_error("the checkpoint does not contain the local time stepping state!");
+
+    const std::size_t stridesCount = data.size() - 4;
+    if(stridesCount != 0 && stridesCount != m_pMesh->getNodesCount())
+        throw std::runtime_error("the checkpoint does not contain the time step stride of every node: " +
+                                 std::to_string(stridesCount) + " vs " + std::to_string(m_pMesh->getNodesCount()) + "!");
+
+    //The active nodes and elements of the sub-step are computed back from the strides (see m_setActiveSet)
+    m_subStep = static_cast<unsigned int>(data[2]);
+    m_cycleLength = static_cast<unsigned int>(data[3]);
+    m_nodesStride.resize(stridesCount);
+    for(std::size_t n = 0 ; n < stridesCount ; ++n)
+        m_nodesStride[n] = static_cast<unsigned int>(data[4 + n]);
+
+    if(m_cycleLength == 0 || m_subStep >= m_cycleLength)
+        throw std::runtime_error("invalid local time stepping state in the checkpoint!");
+}
+
+Eigen::VectorXd SolverWCompNewton::getNodesTimeStep(unsigned int statesCount) const
+{
+    const std::size_t nodesCount = m_pMesh->getNodesCount();
+    if(m_maxDTLevel == 0)
+        return Eigen::VectorXd::Constant(static_cast<Eigen::Index>(statesCount*nodesCount), m_timeStep);
+
+    Eigen::VectorXd qDT(statesCount*nodesCount);
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+    {
+        double nodeDT = getNodeTimeStep(n);
+        for(unsigned int s = 0 ; s < statesCount ; ++s)
+            qDT[n + s*nodesCount] = nodeDT;
+    }
+
+    return qDT;
+}
+
 bool SolverWCompNewton::solveOneTimeStep()
 {
     return m_solveFunc();
@@ -193,12 +264,21 @@ void SolverWCompNewton::computeNextDT()
 {
     if(m_adaptDT)
     {
+        //The levels can only change once every node reached the end of the cycle
+        if(m_maxDTLevel > 0 && m_subStep != 0)
+            return;
+
         bool heat = false;
         if(m_pProblem->getID() == "BoussinesqWC")
             heat = true;
 
         m_timeStep = std::numeric_limits<double>::max();
         m_remeshTimeStep = std::numeric_limits<double>::max();
+
+        std::vector<double> elementsDT;
+        if(m_maxDTLevel > 0)
+            elementsDT.resize(m_pMesh->getElementsCount());
+
         #pragma omp parallel for reduction(min:m_timeStep)
         for(std::size_t elm = 0 ; elm < m_pMesh->getElementsCount() ; ++elm)
         {
@@ -221,7 +301,11 @@ void SolverWCompNewton::computeNextDT()
                 maxSquaredSpeedFluidPressureVN = std::max(maxSquaredSpeedFluidPressureVN, 4*alpha*alpha/(he*he));
                 maxSquaredSpeedFluid = std::max(maxSquaredSpeedFluid, u2);
             }
-            m_timeStep = std::min(m_timeStep, m_securityCoeff*m_securityCoeff*he*he/maxSquaredSpeedFluidPressureVN);
+            double elementDT2 = m_securityCoeff*m_securityCoeff*he*he/maxSquaredSpeedFluidPressureVN;
+            if(m_maxDTLevel > 0)
+                elementsDT[elm] = std::sqrt(elementDT2);
+
+            m_timeStep = std::min(m_timeStep, elementDT2);
             m_remeshTimeStep = std::max(m_remeshTimeStep, he*he/maxSquaredSpeedFluid);
         }
 
@@ -230,91 +314,237 @@ void SolverWCompNewton::computeNextDT()
 
         if(std::isnan(m_timeStep) || std::isnan(m_remeshTimeStep))
             throw std::runtime_error("NaN time step!");
+
+        if(m_maxDTLevel > 0)
+            m_computeLevels(elementsDT);
     }
 }
 
+void SolverWCompNewton::m_computeLevels(const std::vector<double>& elementsDT)
+{
+    const std::size_t elementsCount = m_pMesh->getElementsCount();
+    const unsigned int maxStride = 1u << m_maxDTLevel;
+
+    //Each element takes the largest power-of-two multiple of the smallest time step it allows
+    std::vector<unsigned int> elementsStride(elementsCount);
+    unsigned int cycleLength = 1;
+
+    #pragma omp parallel for default(shared) reduction(max:cycleLength)
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+    {
+        const double allowedDT = std::min(elementsDT[elm], m_maxDT);
+
+        unsigned int stride = 1;
+        while(stride < maxStride && 2*stride*m_timeStep <= allowedDT)
+            stride *= 2;
+
+        elementsStride[elm] = stride;
+        cycleLength = std::max(cycleLength, stride);
+    }
+
+    //A node is updated at the rate of its most restrictive element (free nodes follow the cycle)
+    m_cycleLength = cycleLength;
+    m_nodesStride.assign(m_pMesh->getNodesCount(), m_cycleLength);
+
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+    {
+        const Element& element = m_pMesh->getElement(elm);
+        for(unsigned short n = 0 ; n < m_pMesh->getNodesPerElm() ; ++n)
+        {
+            unsigned int& nodeStride = m_nodesStride[element.getNodeIndex(n)];
+            nodeStride = std::min(nodeStride, elementsStride[elm]);
+        }
+    }
+
+    if(m_pProblem->isOutputVerbose())
+    {
+        std::vector<std::size_t> nodesPerLevel(m_maxDTLevel + 1, 0);
+        for(unsigned int stride : m_nodesStride)
+        {
+            unsigned int level = 0;
+            while((1u << level) < stride)
+                ++level;
+            nodesPerLevel[level]++;
+        }
+
+        std::cout << "Local time stepping: cycle of " << m_cycleLength << " sub-steps, nodes per level:";
+        for(std::size_t count : nodesPerLevel)
+            std::cout << " " << count;
+        std::cout << std::endl;
+    }
+}
+
+void SolverWCompNewton::m_setActiveSet()
+{
+    const std::size_t nodesCount = m_pMesh->getNodesCount();
+    const std::size_t elementsCount = m_pMesh->getElementsCount();
+
+    //No level information for this mesh yet: everybody takes the global time step
+    if(m_nodesStride.size() != nodesCount)
+    {
+        m_nodesStride.assign(nodesCount, 1);
+        m_cycleLength = 1;
+        m_subStep = 0;
+    }
+
+    m_activeNodes.resize(nodesCount);
+    m_activeElements.resize(elementsCount);
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t n = 0 ; n < nodesCount ; ++n)
+        m_activeNodes[n] = (m_subStep%m_nodesStride[n] == 0);
+
+    #pragma omp parallel for default(shared)
+    for(std::size_t elm = 0 ; elm < elementsCount ; ++elm)
+    {
+        const Element& element = m_pMesh->getElement(elm);
+
+        char active = 0;
+        for(unsigned short n = 0 ; n < m_pMesh->getNodesPerElm() ; ++n)
+            active |= m_activeNodes[element.getNodeIndex(n)];
+
+        m_activeElements[elm] = active;
+    }
+}
+
+void SolverWCompNewton::m_advanceSubStep()
+{
+    m_subStep = (m_subStep + 1)%m_cycleLength;
+}
+
 bool SolverWCompNewton::m_solveWCompNewtonNoT()
 {
-    m_clock.start();
+    PROFILE_TIMER(updateSolutionsTimer, "Update solutions");
     unsigned int dim = m_pMesh->getDim();
     Eigen::VectorXd qVPrev = getQFromNodesStates(m_pMesh, 0, dim - 1);           //The precedent speed.
     Eigen::VectorXd qAccPrev = getQFromNodesStates(m_pMesh, dim + 2, 2*dim + 1);  //The precedent acceleration.
-    m_accumalatedTimes["Update solutions"] += m_clock.end();
+    //With a global time step, every node and element is active and the time step is a scalar
+    Eigen::VectorXd qDT;
+    if(isLocalTimeStepping())
+    {
+        m_setActiveSet();
+        qDT = getNodesTimeStep(dim);
+    }
+    updateSolutionsTimer.stop();
 
-    m_clock.start();
-    m_pEquations[0]->preCompute();
-    m_accumalatedTimes["Solving continuity eq"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Solving continuity eq");
+        m_pEquations[0]->preCompute();
+    }
 
-    m_clock.start();
-    Eigen::VectorXd qV1half = qVPrev + 0.5*m_timeStep*qAccPrev;
+    {
+        PROFILE_SCOPE("Update solutions");
+        Eigen::VectorXd qV1half;
+        Eigen::VectorXd deltaPos;
+        if(isLocalTimeStepping())
+        {
+            qV1half = qVPrev + 0.5*qDT.cwiseProduct(qAccPrev);
+            deltaPos = qV1half.cwiseProduct(qDT);
+        }
+        else
+        {
+            qV1half = qVPrev + 0.5*m_timeStep*qAccPrev;
+            deltaPos = m_timeStep*qV1half;
+        }
 
-    setNodesStatesfromQ(m_pMesh, qV1half, 0, dim - 1);
-    Eigen::VectorXd deltaPos = qV1half*m_timeStep;
-    m_pMesh->updateNodesPosition(deltaPos);
-    m_accumalatedTimes["Update solutions"] += m_clock.end();
+        setNodesStatesfromQ(m_pMesh, qV1half, 0, dim - 1);
+        m_pMesh->updateNodesPosition(deltaPos);
+    }
 
-    m_clock.start();
-    m_pEquations[0]->solve();
-    m_accumalatedTimes["Solving continuity eq"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Solving continuity eq");
+        m_pEquations[0]->solve();
+    }
 
-    m_clock.start();
-    m_pEquations[1]->solve();
-    m_accumalatedTimes["Solving momentum eq"] += m_clock.end();
+    {
+        PROFILE_SCOPE("Solving momentum eq");
+        m_pEquations[1]->solve();
+    }
 
-    m_clock.start();
-    m_pProblem->updateTime(m_timeStep);
-    if(m_pProblem->getCurrentSimTime() > m_nextTimeToRemesh)
     {
-        m_pMesh->remesh(m_pProblem->isOutputVerbose());
-        m_nextTimeToRemesh += m_maxDT;
-        for(auto& pMeshSmoother: m_pMeshSmoothers)
-            pMeshSmoother->smooth(m_pProblem->isOutputVerbose());
+        PROFILE_SCOPE("Remeshing");
+        m_pProblem->updateTime(m_timeStep);
+        m_advanceSubStep();
+
+        //Remeshing renumbers the nodes, so it has to wait for the end of the cycle
+        if(m_subStep == 0 && m_pProblem->getCurrentSimTime() > m_nextTimeToRemesh)
+        {
+            m_pMesh->remesh(m_pProblem->isOutputVerbose());
+            m_nextTimeToRemesh += m_maxDT;
+            for(auto& pMeshSmoother: m_pMeshSmoothers)
+                pMeshSmoother->smooth(m_pProblem->isOutputVerbose());
+        }
     }
-    m_accumalatedTimes["Remeshing"] += m_clock.end();
 
     return true;
 }
 
 bool SolverWCompNewton::m_solveBoussinesqWC()
 {
-    m_clock.start();
+    PROFILE_TIMER(updateSolutionsTimer, "Update solutions");
     unsigned int dim = m_pMesh->getDim();
     Eigen::VectorXd qVPrev = getQFromNodesStates(m_pMesh, 0, dim - 1);           //The precedent speed.
     Eigen::VectorXd qAccPrev = getQFromNodesStates(m_pMesh, dim + 2, 2*dim + 1);  //The precedent acceleration.
-    m_accumalatedTimes["Update solutions"] += m_clock.end();
-
-    m_clock.start();
-    m_pEquations[0]->preCompute();
-    m_accumalatedTimes["Solving continuity eq"] += m_clock.end();
-
-    m_clock.start();
-    Eigen::VectorXd qV1half = qVPrev + 0.5*m_timeStep*qAccPrev;
-
-    setNodesStatesfromQ(m_pMesh, qV1half, 0, dim - 1);
-    Eigen::VectorXd deltaPos = qV1half*m_timeStep;
-    m_pMesh->updateNodesPosition(std::vector<double> (deltaPos.data(), deltaPos.data() + deltaPos.cols()*deltaPos.rows()));
-    m_accumalatedTimes["Update solutions"] += m_clock.end();
-
-    m_clock.start();
-    m_pEquations[2]->solve();
-    m_accumalatedTimes["Solving heat eq"] += m_clock.end();
-    m_clock.start();
-    m_pEquations[0]->solve();
-    m_accumalatedTimes["Solving continuity eq"] += m_clock.end();
-    m_clock.start();
-    m_pEquations[1]->solve();
-    m_accumalatedTimes["Solving momentum eq"] += m_clock.end();
-
-    m_clock.start();
-    m_pProblem->updateTime(m_timeStep);
-    if(m_pProblem->getCurrentSimTime() > m_nextTimeToRemesh)
+    //With a global time step, every node and element is active and the time step is a scalar
+    Eigen::VectorXd qDT;
+    if(isLocalTimeStepping())
+    {
+        m_setActiveSet();
+        qDT = getNodesTimeStep(dim);
+    }
+    updateSolutionsTimer.stop();
+
+    {
+        PROFILE_SCOPE("Solving continuity eq");
+        m_pEquations[0]->preCompute();
+    }
+
     {
-        m_pMesh->remesh(m_pProblem->isOutputVerbose());
-        m_nextTimeToRemesh += m_maxDT;
-        for(auto& pMeshSmoother: m_pMeshSmoothers)
-            pMeshSmoother->smooth(m_pProblem->isOutputVerbose());
+        PROFILE_SCOPE("Update solutions");
+        Eigen::VectorXd qV1half;
+        Eigen::VectorXd deltaPos;
+        if(isLocalTimeStepping())
+        {
+            qV1half = qVPrev + 0.5*qDT.cwiseProduct(qAccPrev);
+            deltaPos = qV1half.cwiseProduct(qDT);
+        }
+        else
+        {
+            qV1half = qVPrev + 0.5*m_timeStep*qAccPrev;
+            deltaPos = m_timeStep*qV1half;
+        }
+
+        setNodesStatesfromQ(m_pMesh, qV1half, 0, dim - 1);
+        m_pMesh->updateNodesPosition(std::vector<double> (deltaPos.data(), deltaPos.data() + deltaPos.cols()*deltaPos.rows()));
+    }
+
+    {
+        PROFILE_SCOPE("Solving heat eq");
+        m_pEquations[2]->solve();
+    }
+    {
+        PROFILE_SCOPE("Solving continuity eq");
+        m_pEquations[0]->solve();
+    }
+    {
+        PROFILE_SCOPE("Solving momentum eq");
+        m_pEquations[1]->solve();
+    }
+
+    {
+        PROFILE_SCOPE("Remeshing");
+        m_pProblem->updateTime(m_timeStep);
+        m_advanceSubStep();
+
+        //Remeshing renumbers the nodes, so it has to wait for the end of the cycle
+        if(m_subStep == 0 && m_pProblem->getCurrentSimTime() > m_nextTimeToRemesh)
+        {
+            m_pMesh->remesh(m_pProblem->isOutputVerbose());
+            m_nextTimeToRemesh += m_maxDT;
+            for(auto& pMeshSmoother: m_pMeshSmoothers)
+                pMeshSmoother->smooth(m_pProblem->isOutputVerbose());
+        }
     }
-    m_accumalatedTimes["Remeshing"] += m_clock.end();
 
     return true;
 }
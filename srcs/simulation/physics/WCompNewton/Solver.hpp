@@ -2,6 +2,8 @@
 #ifndef SOLVERWCOMPNEWTON_HPP_INCLUDED
 #define SOLVERWCOMPNEWTON_HPP_INCLUDED
 
+#include <Eigen/Dense>
+
 #include "../../Solver.hpp"
 
 class SIMULATION_API SolverWCompNewton: public Solver
@@ -20,12 +22,49 @@ class SIMULATION_API SolverWCompNewton: public Solver
         void computeNextDT() override;
         std::size_t getAdditionalStateCount() const override;
 
+        /// \return The base solver state followed by the local time stepping state (sub-step, cycle length and
+        ///         time step stride of each node), so that a checkpoint taken inside a cycle resumes it.
+        std::vector<double> getCheckpointData() const override;
+        void setCheckpointData(const std::vector<double>& data) override;
+
+        /// \return Is the local (multi-rate) time stepping enabled ?
+        inline bool isLocalTimeStepping() const noexcept;
+
+        /// \param elm The index of the element.
+        /// \return Does the element contribute to the current sub-step (at least one of its nodes is active) ?
+        inline bool isElementActive(std::size_t elm) const noexcept;
+
+        /// \param n The index of the node.
+        /// \return Is the node updated during the current sub-step ?
+        inline bool isNodeActive(std::size_t n) const noexcept;
+
+        /// \param n The index of the node.
+        /// \return The time step of the node for the current sub-step (0 if the node is not active).
+        inline double getNodeTimeStep(std::size_t n) const noexcept;
+
+        /// \param statesCount The number of states the vector spans (e.g. dim for the velocity).
+        /// \return A vector with the same layout as getQFromNodesStates holding the time step of each node.
+        Eigen::VectorXd getNodesTimeStep(unsigned int statesCount) const;
+
     protected:
         double m_securityCoeff;
 
+        unsigned int m_maxDTLevel;              /**< Number of power-of-two time step levels (0 means a global time step). */
+        unsigned int m_cycleLength;             /**< Number of sub-steps after which all the nodes are synchronized. */
+        unsigned int m_subStep;                 /**< Current sub-step inside the cycle. */
+        std::vector<unsigned int> m_nodesStride;  /**< Number of sub-steps covered by one step of each node. */
+        std::vector<char> m_activeNodes;          /**< Is the node updated during the current sub-step ? */
+        std::vector<char> m_activeElements;       /**< Is the element assembled during the current sub-step ? */
+
+        void m_computeLevels(const std::vector<double>& elementsDT);
+        void m_setActiveSet();
+        void m_advanceSubStep();
+
         std::function<bool()> m_solveFunc;
         bool m_solveWCompNewtonNoT();
         bool m_solveBoussinesqWC();
 };
 
+#include "Solver.inl"
+
 #endif // SOLVERWCOMPNEWTON_HPP_INCLUDED
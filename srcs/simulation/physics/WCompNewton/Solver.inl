@@ -0,0 +1,24 @@
+#include "Solver.hpp"
+
+inline bool SolverWCompNewton::isLocalTimeStepping() const noexcept
+{
+    return m_maxDTLevel > 0;
+}
+
+inline bool SolverWCompNewton::isElementActive(std::size_t elm) const noexcept
+{
+    return m_maxDTLevel == 0 || m_activeElements[elm] != 0;
+}
+
+inline bool SolverWCompNewton::isNodeActive(std::size_t n) const noexcept
+{
+    return m_maxDTLevel == 0 || m_activeNodes[n] != 0;
+}
+
+inline double SolverWCompNewton::getNodeTimeStep(std::size_t n) const noexcept
+{
+    if(m_maxDTLevel == 0)
+        return m_timeStep;
+
+    return (m_activeNodes[n] != 0) ? m_nodesStride[n]*m_timeStep : 0;
+}
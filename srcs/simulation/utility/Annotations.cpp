@@ -0,0 +1,107 @@
+#include "Annotations.hpp"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+#if defined(PFEM_USE_ITT)
+    #include <ittnotify.h>
+#endif
+
+#if defined(PFEM_USE_SDT)
+    #include <sys/sdt.h>
+#endif
+
+#if defined(PFEM_USE_ITT) || defined(PFEM_USE_SDT)
+    #define PFEM_HAS_ANNOTATIONS
+#endif
+
+#if defined(PFEM_HAS_ANNOTATIONS)
+/// Maximum number of annotated regions (the handles are stored in fixed arrays, read without locking).
+static constexpr std::size_t maxRegions = 4096;
+
+struct AnnotationsState
+{
+    std::mutex mutex;
+    std::deque<std::string> names;                                  /**< Storage of the names (never moved). */
+    std::array<std::atomic<const char*>, maxRegions> pNames = {};   /**< Name of each region. */
+#if defined(PFEM_USE_ITT)
+    __itt_domain* pDomain = __itt_domain_create("PFEM");
+    std::array<std::atomic<__itt_string_handle*>, maxRegions> pHandles = {};
+#endif
+};
+
+static AnnotationsState& getState()
+{
+    static AnnotationsState state;
+    return state;
+}
+#endif
+
+void Annotations::setRegionName(std::size_t region, const std::string& name)
+{
+#if defined(PFEM_HAS_ANNOTATIONS)
+    if(region >= maxRegions)
+        return;
+
+    AnnotationsState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if(state.pNames[region].load(std::memory_order_relaxed) != nullptr)
+        return;
+
+    state.names.push_back(name);
+#if defined(PFEM_USE_ITT)
+    state.pHandles[region].store(__itt_string_handle_create(state.names.back().c_str()), std::memory_order_release);
+#endif
+    state.pNames[region].store(state.names.back().c_str(), std::memory_order_release);
+#else
+    static_cast<void>(region);
+    static_cast<void>(name);
+#endif
+}
+
+void Annotations::begin(std::size_t region) noexcept
+{
+#if defined(PFEM_HAS_ANNOTATIONS)
+    AnnotationsState& state = getState();
+
+    //Unnamed regions are still begun, so that every end has its begin
+    const char* pName = (region < maxRegions) ? state.pNames[region].load(std::memory_order_acquire) : nullptr;
+
+#if defined(PFEM_USE_ITT)
+    __itt_string_handle* pHandle = (region < maxRegions) ? state.pHandles[region].load(std::memory_order_acquire) :
+                                                           nullptr;
+    __itt_task_begin(state.pDomain, __itt_null, __itt_null, pHandle);
+#endif
+
+#if defined(PFEM_USE_SDT)
+    DTRACE_PROBE1(pfem, region_begin, pName != nullptr ? pName : "");
+#endif
+
+    static_cast<void>(pName);
+#else
+    static_cast<void>(region);
+#endif
+}
+
+void Annotations::end() noexcept
+{
+#if defined(PFEM_USE_ITT)
+    __itt_task_end(getState().pDomain);
+#endif
+
+#if defined(PFEM_USE_SDT)
+    DTRACE_PROBE(pfem, region_end);
+#endif
+}
+
+bool Annotations::isEnabled() noexcept
+{
+#if defined(PFEM_HAS_ANNOTATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
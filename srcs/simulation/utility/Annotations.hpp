@@ -0,0 +1,46 @@
+#pragma once
+#ifndef ANNOTATIONS_HPP_INCLUDED
+#define ANNOTATIONS_HPP_INCLUDED
+
+#include <string>
+
+#include "../simulation_defines.h"
+
+/**
+ * \class Annotations
+ * \brief Markers of the profiler regions for external profilers, so that their samples can be attributed
+ *        to the remeshing, assembly, factorization, solve, boundary conditions or extraction.
+ *
+ * Every region of the Profiler is annotated (the region ids are the ones of the Profiler). The markers are
+ * ITT tasks for Intel VTune if PFEM was built with USE_ITT, and static probes (sdt_pfem:region_begin and
+ * sdt_pfem:region_end) for perf if it was built with USE_SDT; the functions do nothing otherwise.
+ */
+class SIMULATION_API Annotations
+{
+    public:
+        Annotations()                                       = delete;
+        Annotations(const Annotations& annotations)         = delete;
+        Annotations& operator=(const Annotations& annotations) = delete;
+        Annotations(Annotations&& annotations)              = delete;
+        Annotations& operator=(Annotations&& annotations)   = delete;
+        ~Annotations()                                      = delete;
+
+        /// \brief Name a region before it is entered (regions beyond the maximum number of regions are not
+        ///        annotated).
+        /// \param region The id of the region.
+        /// \param name The name of the region.
+        static void setRegionName(std::size_t region, const std::string& name);
+
+        /// \brief Mark the start of a region on the calling thread.
+        /// \param region The id of the region.
+        static void begin(std::size_t region) noexcept;
+
+        /// \brief Mark the end of the last region started on the calling thread (regions should end in
+        ///        reverse order).
+        static void end() noexcept;
+
+        /// \return Are the regions annotated (is PFEM built with an annotation backend) ?
+        static bool isEnabled() noexcept;
+};
+
+#endif // ANNOTATIONS_HPP_INCLUDED
@@ -0,0 +1,70 @@
+#include "Memory.hpp"
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__APPLE__) && defined(__MACH__)
+    #include <mach/mach.h>
+    #include <sys/resource.h>
+#elif defined(__linux__) || defined(__unix__)
+    #include <cstdio>
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+std::size_t getCurrentRSS()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return static_cast<std::size_t>(counters.WorkingSetSize);
+#elif defined(__APPLE__) && defined(__MACH__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+
+    return static_cast<std::size_t>(info.resident_size);
+#elif defined(__linux__)
+    //Second field of statm: resident pages
+    std::FILE* pFile = std::fopen("/proc/self/statm", "r");
+    if(pFile == nullptr)
+        return 0;
+
+    std::size_t size = 0, resident = 0;
+    const int read = std::fscanf(pFile, "%zu %zu", &size, &resident);
+    std::fclose(pFile);
+    if(read != 2)
+        return 0;
+
+    return resident*static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+std::size_t getPeakRSS()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return static_cast<std::size_t>(counters.PeakWorkingSetSize);
+#elif (defined(__APPLE__) && defined(__MACH__)) || defined(__linux__) || defined(__unix__)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    #if defined(__APPLE__) && defined(__MACH__)
+        //Bytes on macOS, kilobytes elsewhere
+        return static_cast<std::size_t>(usage.ru_maxrss);
+    #else
+        return static_cast<std::size_t>(usage.ru_maxrss)*1024;
+    #endif
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,121 @@
+#pragma once
+#ifndef MEMORY_HPP_INCLUDED
+#define MEMORY_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include "../simulation_defines.h"
+
+/**
+ * \struct MemoryUsage
+ * \brief Memory allocated by each subsystem of a problem, in bytes.
+ */
+struct MemoryUsage
+{
+    std::size_t mesh = 0;           /**< Nodes, elements, facets, saved states and geometry cache. */
+    std::size_t triangulation = 0;  /**< CGAL structures of the last triangulation. */
+    std::size_t matrices = 0;       /**< Matrices, vectors and per element caches of the equations. */
+    std::size_t factorizations = 0; /**< Factors of the direct sparse solvers. */
+    std::size_t assembly = 0;       /**< Assembly buffers (triplets) of the last assembly. */
+    std::size_t extractors = 0;     /**< Buffers and snapshots of the extractors. */
+
+    /// \return The sum over the subsystems.
+    std::size_t getTotal() const noexcept
+    {
+        return mesh + triangulation + matrices + factorizations + assembly + extractors;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) noexcept
+    {
+        mesh += other.mesh;
+        triangulation += other.triangulation;
+        matrices += other.matrices;
+        factorizations += other.factorizations;
+        assembly += other.assembly;
+        extractors += other.extractors;
+        return *this;
+    }
+
+    /// \brief Keep the largest value of each subsystem (high-water mark).
+    void keepMax(const MemoryUsage& other) noexcept
+    {
+        mesh = std::max(mesh, other.mesh);
+        triangulation = std::max(triangulation, other.triangulation);
+        matrices = std::max(matrices, other.matrices);
+        factorizations = std::max(factorizations, other.factorizations);
+        assembly = std::max(assembly, other.assembly);
+        extractors = std::max(extractors, other.extractors);
+    }
+};
+
+/// \return The memory allocated by a vector, in bytes.
+template<typename T, typename Alloc>
+inline std::size_t getMemorySize(const std::vector<T, Alloc>& vec) noexcept
+{
+    return vec.capacity()*sizeof(T);
+}
+
+/// \return The memory allocated by a vector of vectors, in bytes.
+template<typename T, typename Alloc>
+inline std::size_t getMemorySize(const std::vector<std::vector<T>, Alloc>& vec) noexcept
+{
+    std::size_t memory = vec.capacity()*sizeof(std::vector<T>);
+    for(const auto& inner : vec)
+        memory += getMemorySize(inner);
+
+    return memory;
+}
+
+/// \return The memory allocated by a dense matrix or vector, in bytes.
+template<typename Derived>
+inline std::size_t getMemorySize(const Eigen::PlainObjectBase<Derived>& mat) noexcept
+{
+    return static_cast<std::size_t>(mat.size())*sizeof(typename Derived::Scalar);
+}
+
+/// \return The memory allocated by a diagonal matrix, in bytes.
+template<typename Scalar, int Size>
+inline std::size_t getMemorySize(const Eigen::DiagonalMatrix<Scalar, Size>& mat) noexcept
+{
+    return getMemorySize(mat.diagonal());
+}
+
+/// \return The memory allocated by a sparse matrix, in bytes.
+template<typename Scalar, int Options, typename StorageIndex>
+inline std::size_t getMemorySize(const Eigen::SparseMatrix<Scalar, Options, StorageIndex>& mat) noexcept
+{
+    std::size_t memory = static_cast<std::size_t>(mat.data().allocatedSize())*(sizeof(Scalar) + sizeof(StorageIndex)) +
+                         static_cast<std::size_t>(mat.outerSize() + 1)*sizeof(StorageIndex);
+    if(!mat.isCompressed())
+        memory += static_cast<std::size_t>(mat.outerSize())*sizeof(StorageIndex);
+
+    return memory;
+}
+
+/// \return The memory allocated by the factors of a sparse solver, in bytes (0 if unknown for this solver).
+template<typename Solver>
+inline std::size_t getFactorizationMemorySize(const Solver& /** solver **/) noexcept
+{
+    return 0;
+}
+
+/// \return The memory allocated by the L and U factors of a SparseLU solver (fill-in included), in bytes
+///         (the solver should have successfully factorized a matrix).
+template<typename MatrixType, typename OrderingType>
+inline std::size_t getFactorizationMemorySize(const Eigen::SparseLU<MatrixType, OrderingType>& solver) noexcept
+{
+    return static_cast<std::size_t>(solver.nnzL() + solver.nnzU())*
+           (sizeof(typename MatrixType::Scalar) + sizeof(typename MatrixType::StorageIndex));
+}
+
+/// \return The resident set size of the process in bytes (0 if it cannot be queried on this platform).
+SIMULATION_API std::size_t getCurrentRSS();
+
+/// \return The highest resident set size reached by the process in bytes (0 if it cannot be queried).
+SIMULATION_API std::size_t getPeakRSS();
+
+#endif // MEMORY_HPP_INCLUDED
@@ -0,0 +1,176 @@
+#include "PerfCounters.hpp"
+
+#include <mutex>
+#include <vector>
+
+#if defined(PFEM_USE_PERF_COUNTERS) && defined(__linux__)
+    #define PFEM_HAS_PERF_COUNTERS
+    #include <cstdlib>
+    #include <cstring>
+    #include <dirent.h>
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#if defined(PFEM_HAS_PERF_COUNTERS)
+struct PerfCountersState
+{
+    std::mutex mutex;
+    std::vector<std::array<int, PerfCounters::CountersCount>> threadsFd; /**< Counters of each thread. */
+    bool isOpen = false;
+};
+
+static PerfCountersState& getState()
+{
+    static PerfCountersState state;
+    return state;
+}
+
+/// \return The file descriptor of the counter, or -1 if it cannot be opened.
+static int openCounter(pid_t tid, std::uint64_t config)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.inherit = 1;           //Threads created afterwards are counted too
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+static void closeThreadCounters(const std::array<int, PerfCounters::CountersCount>& fds)
+{
+    for(int fd : fds)
+    {
+        if(fd >= 0)
+            ::close(fd);
+    }
+}
+#endif
+
+bool PerfCounters::open()
+{
+#if defined(PFEM_HAS_PERF_COUNTERS)
+    PerfCountersState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if(state.isOpen)
+        return true;
+
+    static const std::array<std::uint64_t, CountersCount> configs = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    //The threads which already exist (OpenMP pool, writer threads) are not covered by inheritance
+    DIR* pDir = opendir("/proc/self/task");
+    if(pDir == nullptr)
+        return false;
+
+    const pid_t mainTid = static_cast<pid_t>(syscall(SYS_gettid));
+    bool mainThreadOpen = false;
+
+    while(dirent* pEntry = readdir(pDir))
+    {
+        if(pEntry->d_name[0] == '.')
+            continue;
+
+        const pid_t tid = static_cast<pid_t>(std::strtol(pEntry->d_name, nullptr, 10));
+
+        std::array<int, CountersCount> fds;
+        bool ok = true;
+        for(std::size_t counter = 0 ; counter < CountersCount ; ++counter)
+        {
+            fds[counter] = ok ? openCounter(tid, configs[counter]) : -1;
+            ok = ok && fds[counter] >= 0;
+        }
+
+        //A thread may have exited in the meantime
+        if(!ok)
+        {
+            closeThreadCounters(fds);
+            continue;
+        }
+
+        if(tid == mainTid)
+            mainThreadOpen = true;
+
+        state.threadsFd.push_back(fds);
+    }
+
+    closedir(pDir);
+
+    if(!mainThreadOpen)
+    {
+        for(const auto& fds : state.threadsFd)
+            closeThreadCounters(fds);
+
+        state.threadsFd.clear();
+        return false;
+    }
+
+    state.isOpen = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PerfCounters::close()
+{
+#if defined(PFEM_HAS_PERF_COUNTERS)
+    PerfCountersState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    for(const auto& fds : state.threadsFd)
+        closeThreadCounters(fds);
+
+    state.threadsFd.clear();
+    state.isOpen = false;
+#endif
+}
+
+bool PerfCounters::isOpen() noexcept
+{
+#if defined(PFEM_HAS_PERF_COUNTERS)
+    return getState().isOpen;
+#else
+    return false;
+#endif
+}
+
+PerfCounters::Values PerfCounters::read() noexcept
+{
+    Values values;
+    values.fill(0);
+
+#if defined(PFEM_HAS_PERF_COUNTERS)
+    const PerfCountersState& state = getState();
+    for(const auto& fds : state.threadsFd)
+    {
+        for(std::size_t counter = 0 ; counter < CountersCount ; ++counter)
+        {
+            //Value, time enabled and time running (less than enabled if the counter was multiplexed)
+            std::uint64_t data[3];
+            if(::read(fds[counter], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0)
+                continue;
+
+            values[counter] += (data[1] == data[2]) ? data[0] :
+                static_cast<std::uint64_t>(static_cast<double>(data[0])*static_cast<double>(data[1])/static_cast<double>(data[2]));
+        }
+    }
+#endif
+
+    return values;
+}
+
+std::string PerfCounters::getName(std::size_t counter)
+{
+    static const std::array<std::string, CountersCount> names = {"cycles", "instructions", "cacheMisses", "branchMisses"};
+
+    return counter < CountersCount ? names[counter] : "";
+}
@@ -0,0 +1,59 @@
+#pragma once
+#ifndef PERFCOUNTERS_HPP_INCLUDED
+#define PERFCOUNTERS_HPP_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "../simulation_defines.h"
+
+/**
+ * \class PerfCounters
+ * \brief Hardware performance counters of the whole process, read with the Linux perf_event_open interface.
+ *
+ * The counters are opened for every thread of the process and inherited by the threads they create
+ * afterwards (such as the OpenMP threads), so that a read returns the sum over all the threads.
+ * They are only available if PFEM was built with USE_PERF_COUNTERS on Linux.
+ */
+class SIMULATION_API PerfCounters
+{
+    public:
+        PerfCounters()                                      = delete;
+        PerfCounters(const PerfCounters& counters)          = delete;
+        PerfCounters& operator=(const PerfCounters& counters) = delete;
+        PerfCounters(PerfCounters&& counters)               = delete;
+        PerfCounters& operator=(PerfCounters&& counters)    = delete;
+        ~PerfCounters()                                     = delete;
+
+        /// The recorded counters.
+        enum Counter : std::size_t
+        {
+            Cycles = 0,
+            Instructions,
+            CacheMisses,    /**< Last level cache misses. */
+            BranchMisses,
+            CountersCount
+        };
+
+        using Values = std::array<std::uint64_t, CountersCount>;
+
+        /// \brief Open the counters of every thread of the process (does nothing if they are already open).
+        /// \return Could the counters be opened (false if unsupported, or forbidden by perf_event_paranoid) ?
+        static bool open();
+
+        /// \brief Close the counters.
+        static void close();
+
+        /// \return Are the counters open ?
+        static bool isOpen() noexcept;
+
+        /// \return The counters summed over the threads since they were opened (scaled if the counters were
+        ///         multiplexed, 0 if they are not open).
+        static Values read() noexcept;
+
+        /// \return The name of a counter.
+        static std::string getName(std::size_t counter);
+};
+
+#endif // PERFCOUNTERS_HPP_INCLUDED
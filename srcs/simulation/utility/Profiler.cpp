@@ -0,0 +1,534 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <omp.h>
+
+#include "Annotations.hpp"
+#include "Clock.hpp"
+#include "PerfCounters.hpp"
+
+/// Maximum number of trace events recorded per thread (about 24 MB).
+static constexpr std::size_t maxTraceEventsPerThread = 1 << 20;
+
+struct RegionStats
+{
+    std::uint64_t count = 0;
+    std::int64_t total = 0;
+    std::int64_t min = std::numeric_limits<std::int64_t>::max();
+    std::int64_t max = 0;
+    std::uint64_t countedCalls = 0;     /**< Calls for which the hardware counters were recorded. */
+    PerfCounters::Values counters = {}; /**< Hardware counters summed over the counted calls. */
+};
+
+struct TraceEvent
+{
+    std::size_t path;
+    std::int64_t start;
+    std::int64_t duration;
+};
+
+struct ProfilerThreadData
+{
+    std::size_t threadIndex = 0;
+    std::vector<std::size_t> stack;                                             /**< Entered call tree nodes. */
+    std::vector<PerfCounters::Values> countersStack;                            /**< Counters when each node was entered. */
+    std::vector<RegionStats> stats;                                             /**< Indexed by call tree node. */
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> children;     /**< (region, node) of each node. */
+    std::vector<TraceEvent> events;
+    std::uint64_t droppedEvents = 0;
+};
+
+struct ProfilerPath
+{
+    std::size_t parent;
+    std::size_t region;
+    std::vector<std::size_t> children;
+};
+
+struct ProfilerState
+{
+    std::mutex mutex;
+    std::vector<std::string> regionNames;
+    std::map<std::string, std::size_t> regionIds;
+    std::vector<ProfilerPath> paths = {{0, 0, {}}};                             /**< Node 0 is the root. */
+    std::map<std::pair<std::size_t, std::size_t>, std::size_t> pathIds;
+    std::vector<std::unique_ptr<ProfilerThreadData>> threadsData;
+    std::atomic<std::size_t> serialPath{0};                                     /**< Node of the master thread. */
+    std::atomic<bool> tracing{false};
+    std::atomic<bool> counters{false};
+    ClockType::time_point origin = ClockType::now();
+};
+
+static ProfilerState& getState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+static ProfilerThreadData& getThreadData()
+{
+    thread_local ProfilerThreadData* pData = nullptr;
+    if(pData == nullptr)
+    {
+        ProfilerState& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.threadsData.push_back(std::make_unique<ProfilerThreadData>());
+        pData = state.threadsData.back().get();
+        pData->threadIndex = state.threadsData.size() - 1;
+    }
+
+    return *pData;
+}
+
+/// \return The statistics of a call tree node summed over all the threads (the mutex should be locked).
+static RegionStats getMergedStats(const ProfilerState& state, std::size_t path)
+{
+    RegionStats merged;
+    for(const auto& pData : state.threadsData)
+    {
+        if(path >= pData->stats.size() || pData->stats[path].count == 0)
+            continue;
+
+        const RegionStats& stats = pData->stats[path];
+        merged.count += stats.count;
+        merged.total += stats.total;
+        merged.min = std::min(merged.min, stats.min);
+        merged.max = std::max(merged.max, stats.max);
+        merged.countedCalls += stats.countedCalls;
+        for(std::size_t counter = 0 ; counter < PerfCounters::CountersCount ; ++counter)
+            merged.counters[counter] += stats.counters[counter];
+    }
+
+    return merged;
+}
+
+/// \return The number of threads which entered a call tree node (the mutex should be locked).
+static std::size_t getThreadsCount(const ProfilerState& state, std::size_t path)
+{
+    return static_cast<std::size_t>(std::count_if(state.threadsData.begin(), state.threadsData.end(),
+                                                  [path](const std::unique_ptr<ProfilerThreadData>& pData)
+    {
+        return path < pData->stats.size() && pData->stats[path].count != 0;
+    }));
+}
+
+static std::string escapeJSON(const std::string& text)
+{
+    std::string escaped;
+    for(char c : text)
+    {
+        if(c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+static double toSeconds(std::int64_t nanoseconds)
+{
+    return static_cast<double>(nanoseconds)/1000000000.0;
+}
+
+std::size_t Profiler::registerRegion(const std::string& name)
+{
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    auto it = state.regionIds.find(name);
+    if(it != state.regionIds.end())
+        return it->second;
+
+    state.regionNames.push_back(name);
+    state.regionIds[name] = state.regionNames.size() - 1;
+    Annotations::setRegionName(state.regionNames.size() - 1, name);
+    return state.regionNames.size() - 1;
+}
+
+std::size_t Profiler::enter(std::size_t region)
+{
+    ProfilerState& state = getState();
+    ProfilerThreadData& data = getThreadData();
+
+    const std::size_t parent = data.stack.empty() ? state.serialPath.load(std::memory_order_relaxed) :
+                                                    data.stack.back();
+
+    if(parent >= data.children.size())
+        data.children.resize(parent + 1);
+
+    //The child nodes are cached per thread, the shared call tree is only locked for new nodes
+    std::size_t path = 0;
+    auto& children = data.children[parent];
+    auto child = std::find_if(children.begin(), children.end(), [region](const std::pair<std::size_t, std::size_t>& c)
+    {
+        return c.first == region;
+    });
+
+    if(child != children.end())
+        path = child->second;
+    else
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto it = state.pathIds.find({parent, region});
+        if(it != state.pathIds.end())
+            path = it->second;
+        else
+        {
+            path = state.paths.size();
+            state.paths.push_back({parent, region, {}});
+            state.paths[parent].children.push_back(path);
+            state.pathIds[{parent, region}] = path;
+        }
+
+        children.push_back({region, path});
+    }
+
+    if(path >= data.stats.size())
+        data.stats.resize(path + 1);
+
+    data.stack.push_back(path);
+    if(!omp_in_parallel())
+        state.serialPath.store(path, std::memory_order_relaxed);
+
+    //The counters cover all the threads, so they are only read by the regions entered outside of parallel regions
+    if(state.counters.load(std::memory_order_relaxed))
+    {
+        PerfCounters::Values start;
+        start.fill(0);
+        if(!omp_in_parallel())
+            start = PerfCounters::read();
+
+        data.countersStack.push_back(start);
+    }
+
+    Annotations::begin(region);
+
+    return path;
+}
+
+void Profiler::leave(std::size_t path, std::int64_t startTime)
+{
+    const std::int64_t duration = now() - startTime;
+
+    Annotations::end();
+
+    ProfilerState& state = getState();
+    ProfilerThreadData& data = getThreadData();
+
+    bool counters = state.counters.load(std::memory_order_relaxed) && !omp_in_parallel();
+    const PerfCounters::Values end = counters ? PerfCounters::read() : PerfCounters::Values();
+    PerfCounters::Values start = {};
+
+    assert(!data.stack.empty() && "Profiler::leave called without a matching Profiler::enter!");
+
+    //The last entered node, unless timers were stopped out of order
+    auto it = std::find(data.stack.rbegin(), data.stack.rend(), path);
+    if(it != data.stack.rend())
+    {
+        const auto index = std::distance(data.stack.begin(), std::next(it).base());
+        data.stack.erase(data.stack.begin() + index);
+
+        if(static_cast<std::size_t>(index) < data.countersStack.size())
+        {
+            start = data.countersStack[static_cast<std::size_t>(index)];
+            data.countersStack.erase(data.countersStack.begin() + index);
+        }
+        else
+            counters = false;
+    }
+    else
+        counters = false;
+
+    RegionStats& stats = data.stats[path];
+    stats.count++;
+    stats.total += duration;
+    stats.min = std::min(stats.min, duration);
+    stats.max = std::max(stats.max, duration);
+    if(counters)
+    {
+        stats.countedCalls++;
+        for(std::size_t counter = 0 ; counter < PerfCounters::CountersCount ; ++counter)
+            stats.counters[counter] += end[counter] - start[counter];
+    }
+
+    if(!omp_in_parallel())
+        state.serialPath.store(data.stack.empty() ? 0 : data.stack.back(), std::memory_order_relaxed);
+
+    if(state.tracing.load(std::memory_order_relaxed))
+    {
+        if(data.events.size() < maxTraceEventsPerThread)
+            data.events.push_back({path, startTime, duration});
+        else
+            data.droppedEvents++;
+    }
+}
+
+std::int64_t Profiler::now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now() - getState().origin).count();
+}
+
+void Profiler::reset()
+{
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    for(auto& pData : state.threadsData)
+    {
+        std::fill(pData->stats.begin(), pData->stats.end(), RegionStats());
+        pData->events.clear();
+        pData->droppedEvents = 0;
+    }
+}
+
+void Profiler::setTracing(bool tracing)
+{
+    getState().tracing.store(tracing);
+}
+
+bool Profiler::setCounters(bool counters)
+{
+    ProfilerState& state = getState();
+
+    if(counters && !PerfCounters::open())
+        counters = false;
+    else if(!counters)
+        PerfCounters::close();
+
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for(auto& pData : state.threadsData)
+            pData->countersStack.clear();
+    }
+
+    state.counters.store(counters);
+    return counters;
+}
+
+std::vector<std::string> Profiler::getRegionNames()
+{
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    return state.regionNames;
+}
+
+std::vector<double> Profiler::getRegionsTime(bool callingThreadOnly)
+{
+    //Fetched before locking as it may register the calling thread
+    const ProfilerThreadData& callingData = getThreadData();
+
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    std::vector<std::int64_t> totals(state.regionNames.size(), 0);
+    for(const auto& pData : state.threadsData)
+    {
+        if(callingThreadOnly && pData.get() != &callingData)
+            continue;
+
+        for(std::size_t path = 1 ; path < pData->stats.size() ; ++path)
+            totals[state.paths[path].region] += pData->stats[path].total;
+    }
+
+    std::vector<double> times(totals.size());
+    for(std::size_t region = 0 ; region < totals.size() ; ++region)
+        times[region] = toSeconds(totals[region]);
+
+    return times;
+}
+
+void Profiler::writeTextReport(std::ostream& out)
+{
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    out << std::setw(48) << std::left << "Region"
+        << std::setw(10) << std::right << "Calls"
+        << std::setw(8) << std::right << "Threads"
+        << std::setw(13) << std::right << "Total (s)"
+        << std::setw(13) << std::right << "Mean (s)"
+        << std::setw(13) << std::right << "Min (s)"
+        << std::setw(13) << std::right << "Max (s)"
+        << std::setw(10) << std::right << "% parent";
+
+    const bool counters = state.counters.load();
+    if(counters)
+    {
+        out << std::setw(8) << std::right << "IPC"
+            << std::setw(10) << std::right << "LLC MPKI"
+            << std::setw(10) << std::right << "Br MPKI";
+    }
+    out << "\n";
+
+    auto writeNode = [&](std::size_t path, unsigned int depth, double parentTotal, auto& writeChildren) -> void
+    {
+        const RegionStats stats = getMergedStats(state, path);
+        if(stats.count == 0)
+            return;
+
+        const double total = toSeconds(stats.total);
+        out << std::string(2*depth, ' ') << std::setw(48 - static_cast<int>(std::min(2*depth, 40u))) << std::left
+            << state.regionNames[state.paths[path].region]
+            << std::setw(10) << std::right << stats.count
+            << std::setw(8) << std::right << getThreadsCount(state, path)
+            << std::defaultfloat << std::setprecision(6)
+            << std::setw(13) << std::right << total
+            << std::setw(13) << std::right << total/static_cast<double>(stats.count)
+            << std::setw(13) << std::right << toSeconds(stats.min)
+            << std::setw(13) << std::right << toSeconds(stats.max)
+            << std::setw(10) << std::right << std::fixed << std::setprecision(1)
+            << ((parentTotal > 0) ? 100*total/parentTotal : 100.0);
+
+        if(counters)
+        {
+            const double cycles = static_cast<double>(stats.counters[PerfCounters::Cycles]);
+            const double instructions = static_cast<double>(stats.counters[PerfCounters::Instructions]);
+            if(stats.countedCalls == 0 || cycles == 0 || instructions == 0)
+                out << std::setw(8) << std::right << "-" << std::setw(10) << std::right << "-" << std::setw(10) << std::right << "-";
+            else
+            {
+                out << std::setprecision(2)
+                    << std::setw(8) << std::right << instructions/cycles
+                    << std::setw(10) << std::right << 1000*static_cast<double>(stats.counters[PerfCounters::CacheMisses])/instructions
+                    << std::setw(10) << std::right << 1000*static_cast<double>(stats.counters[PerfCounters::BranchMisses])/instructions;
+            }
+        }
+
+        out << std::defaultfloat << "\n";
+
+        writeChildren(path, depth + 1, total, writeChildren);
+    };
+
+    auto writeChildren = [&](std::size_t path, unsigned int depth, double total, auto& self) -> void
+    {
+        for(std::size_t child : state.paths[path].children)
+            writeNode(child, depth, total, self);
+    };
+
+    for(std::size_t child : state.paths[0].children)
+        writeNode(child, 0, 0, writeChildren);
+
+    out << std::flush;
+}
+
+void Profiler::writeJSONReport(const std::string& fileName)
+{
+    std::ofstream file(fileName);
+    if(!file.is_open())
+        throw std::runtime_error("cannot open file to write the profiler report: " + fileName);
+
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    file << std::setprecision(9);
+
+    auto writeNode = [&](std::size_t path, auto& self) -> void
+    {
+        const RegionStats stats = getMergedStats(state, path);
+
+        file << "{\"name\": \"" << escapeJSON(state.regionNames[state.paths[path].region]) << "\""
+             << ", \"calls\": " << stats.count
+             << ", \"total\": " << toSeconds(stats.total)
+             << ", \"mean\": " << ((stats.count == 0) ? 0 : toSeconds(stats.total)/static_cast<double>(stats.count))
+             << ", \"min\": " << ((stats.count == 0) ? 0 : toSeconds(stats.min))
+             << ", \"max\": " << toSeconds(stats.max);
+
+        if(stats.countedCalls != 0)
+        {
+            file << ", \"counters\": {\"calls\": " << stats.countedCalls;
+            for(std::size_t counter = 0 ; counter < PerfCounters::CountersCount ; ++counter)
+                file << ", \"" << PerfCounters::getName(counter) << "\": " << stats.counters[counter];
+            file << "}";
+        }
+
+        file << ", \"threads\": [";
+
+        bool first = true;
+        for(const auto& pData : state.threadsData)
+        {
+            if(path >= pData->stats.size() || pData->stats[path].count == 0)
+                continue;
+
+            file << (first ? "" : ", ") << "{\"thread\": " << pData->threadIndex
+                 << ", \"calls\": " << pData->stats[path].count
+                 << ", \"total\": " << toSeconds(pData->stats[path].total) << "}";
+            first = false;
+        }
+
+        file << "], \"children\": [";
+
+        first = true;
+        for(std::size_t child : state.paths[path].children)
+        {
+            if(getMergedStats(state, child).count == 0)
+                continue;
+
+            file << (first ? "" : ", ");
+            self(child, self);
+            first = false;
+        }
+
+        file << "]}";
+    };
+
+    file << "{\"regions\": [";
+
+    bool first = true;
+    for(std::size_t child : state.paths[0].children)
+    {
+        if(getMergedStats(state, child).count == 0)
+            continue;
+
+        file << (first ? "" : ", ");
+        writeNode(child, writeNode);
+        first = false;
+    }
+
+    file << "]}" << std::endl;
+}
+
+void Profiler::writeChromeTrace(const std::string& fileName)
+{
+    std::ofstream file(fileName);
+    if(!file.is_open())
+        throw std::runtime_error("cannot open file to write the profiler trace: " + fileName);
+
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+
+    bool first = true;
+    for(const auto& pData : state.threadsData)
+    {
+        file << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": "
+             << pData->threadIndex << ", \"args\": {\"name\": \"Thread " << pData->threadIndex << "\"}}";
+        first = false;
+
+        //Timestamps are in microseconds
+        for(const auto& event : pData->events)
+        {
+            file << ",\n{\"name\": \"" << escapeJSON(state.regionNames[state.paths[event.path].region])
+                 << "\", \"cat\": \"pfem\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << pData->threadIndex
+                 << ", \"ts\": " << static_cast<double>(event.start)/1000.0
+                 << ", \"dur\": " << static_cast<double>(event.duration)/1000.0 << "}";
+        }
+
+        if(pData->droppedEvents != 0)
+            std::cerr << "Profiler: " << pData->droppedEvents << " trace events dropped on thread "
+                      << pData->threadIndex << std::endl;
+    }
+
+    file << "\n]}" << std::endl;
+}
@@ -0,0 +1,133 @@
+#pragma once
+#ifndef PROFILER_HPP_INCLUDED
+#define PROFILER_HPP_INCLUDED
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../simulation_defines.h"
+
+/**
+ * \class Profiler
+ * \brief Hierarchical profiler: the time spent in each region is accumulated per thread in a call tree
+ *        (a region is identified by its name and the path of its enclosing regions).
+ *
+ * Regions entered by the OpenMP worker threads are attached to the region in which the master thread was
+ * when the parallel region started. Regions are registered once per call site (see PROFILE_SCOPE). The
+ * regions are also marked for external profilers (see Annotations).
+ */
+class SIMULATION_API Profiler
+{
+    public:
+        Profiler()                                  = delete;
+        Profiler(const Profiler& profiler)          = delete;
+        Profiler& operator=(const Profiler& profiler) = delete;
+        Profiler(Profiler&& profiler)               = delete;
+        Profiler& operator=(Profiler&& profiler)    = delete;
+        ~Profiler()                                 = delete;
+
+        /// \param name The name of the region (regions with the same name share their id).
+        /// \return The id of the region.
+        static std::size_t registerRegion(const std::string& name);
+
+        /// \brief Enter a region on the calling thread.
+        /// \param region The id of the region.
+        /// \return The id of the entered node of the call tree.
+        static std::size_t enter(std::size_t region);
+
+        /// \brief Leave the last entered region of the calling thread.
+        /// \param path The id returned by enter.
+        /// \param startTime The time at which the region was entered (see now).
+        static void leave(std::size_t path, std::int64_t startTime);
+
+        /// \return The time elapsed since the start of the program, in nanoseconds.
+        static std::int64_t now() noexcept;
+
+        /// \brief Clear the accumulated statistics and trace events (no region should be active).
+        static void reset();
+
+        /// \brief Activate or not the recording of every region call (required by writeChromeTrace).
+        static void setTracing(bool tracing);
+
+        /// \brief Activate or not the hardware counters (see PerfCounters) of the regions entered outside of
+        ///        OpenMP parallel regions, which include the work of every thread (no region should be active).
+        /// \return Are the counters recorded (false if they are not available) ?
+        static bool setCounters(bool counters);
+
+        /// \return The names of the registered regions (indexed by region id).
+        static std::vector<std::string> getRegionNames();
+
+        /// \param callingThreadOnly Only account the regions entered by the calling thread (their wall time)
+        ///                          instead of summing the time over all the threads.
+        /// \return The total time spent in each region (indexed by region id) over the threads and call tree
+        ///         nodes, in seconds (the time of a region nested in itself is counted twice).
+        static std::vector<double> getRegionsTime(bool callingThreadOnly = false);
+
+        /// \brief Write the call tree with the calls count, total, mean, min and max times of each region
+        ///        (and the instructions per cycle, cache and branch misses per thousand instructions if the
+        ///        counters are recorded).
+        static void writeTextReport(std::ostream& out);
+
+        /// \brief Write the call tree (with the statistics of each thread) in a JSON file.
+        static void writeJSONReport(const std::string& fileName);
+
+        /// \brief Write the recorded region calls in a Chrome trace file (chrome://tracing, Perfetto).
+        static void writeChromeTrace(const std::string& fileName);
+};
+
+/**
+ * \class ScopedTimer
+ * \brief Time a region of the profiler from its construction to its destruction (or to stop).
+ */
+class ScopedTimer
+{
+    public:
+        explicit ScopedTimer(std::size_t region) :
+        m_path(Profiler::enter(region)),
+        m_startTime(Profiler::now()),
+        m_isRunning(true)
+        {
+        }
+
+        ScopedTimer(const ScopedTimer& timer)               = delete;
+        ScopedTimer& operator=(const ScopedTimer& timer)    = delete;
+        ScopedTimer(ScopedTimer&& timer)                    = delete;
+        ScopedTimer& operator=(ScopedTimer&& timer)         = delete;
+
+        ~ScopedTimer()
+        {
+            stop();
+        }
+
+        /// \brief Stop the timer before the end of the scope (regions should be stopped in reverse order).
+        void stop()
+        {
+            if(m_isRunning)
+            {
+                Profiler::leave(m_path, m_startTime);
+                m_isRunning = false;
+            }
+        }
+
+    private:
+        std::size_t m_path;
+        std::int64_t m_startTime;
+        bool m_isRunning;
+};
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+
+/// \brief Time the enclosing scope as the region name.
+#define PROFILE_SCOPE(name) \
+    static const std::size_t PROFILER_CONCAT(profilerRegion, __LINE__) = Profiler::registerRegion(name); \
+    ScopedTimer PROFILER_CONCAT(profilerTimer, __LINE__)(PROFILER_CONCAT(profilerRegion, __LINE__))
+
+/// \brief Declare a ScopedTimer called timer for the region name, which can be stopped before the end of the scope.
+#define PROFILE_TIMER(timer, name) \
+    static const std::size_t PROFILER_CONCAT(profilerRegion, __LINE__) = Profiler::registerRegion(name); \
+    ScopedTimer timer(PROFILER_CONCAT(profilerRegion, __LINE__))
+
+#endif // PROFILER_HPP_INCLUDED
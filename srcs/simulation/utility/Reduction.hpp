@@ -0,0 +1,126 @@
+#pragma once
+#ifndef REDUCTION_HPP_INCLUDED
+#define REDUCTION_HPP_INCLUDED
+
+#include <cstddef>
+#include <limits>
+
+/**
+ * \struct ArgReduction
+ * \brief Result of an argmin/argmax reduction.
+ */
+struct ArgReduction
+{
+    double value;       /**< The extremal value. */
+    std::size_t index;  /**< The smallest index at which it is reached (count if the range is empty). */
+};
+
+/// \param count The number of items.
+/// \param func Callable returning the value of item i.
+/// \return The sum of the values of the items, computed in parallel.
+template<typename Func>
+inline double parallelSum(std::size_t count, Func&& func)
+{
+    double sum = 0;
+
+    #pragma omp parallel for default(shared) reduction(+:sum)
+    for(std::size_t i = 0 ; i < count ; ++i)
+        sum += func(i);
+
+    return sum;
+}
+
+/// \param count The number of items.
+/// \param func Callable returning the value of item i (return the largest double to skip an item).
+/// \return The minimum of the values of the items, computed in parallel.
+template<typename Func>
+inline double parallelMin(std::size_t count, Func&& func)
+{
+    double minValue = std::numeric_limits<double>::max();
+
+    #pragma omp parallel for default(shared) reduction(min:minValue)
+    for(std::size_t i = 0 ; i < count ; ++i)
+    {
+        const double value = func(i);
+        if(value < minValue)
+            minValue = value;
+    }
+
+    return minValue;
+}
+
+/// \param count The number of items.
+/// \param func Callable returning the value of item i (return the lowest double to skip an item).
+/// \return The maximum of the values of the items, computed in parallel.
+template<typename Func>
+inline double parallelMax(std::size_t count, Func&& func)
+{
+    double maxValue = std::numeric_limits<double>::lowest();
+
+    #pragma omp parallel for default(shared) reduction(max:maxValue)
+    for(std::size_t i = 0 ; i < count ; ++i)
+    {
+        const double value = func(i);
+        if(value > maxValue)
+            maxValue = value;
+    }
+
+    return maxValue;
+}
+
+/// \param count The number of items.
+/// \param initValue The value returned if the range is empty.
+/// \param func Callable returning the value of item i.
+/// \param isBetter Callable returning true if its first argument should replace the second one.
+/// \return The extremal value and the smallest index at which it is reached, computed in parallel.
+template<typename Func, typename Compare>
+inline ArgReduction parallelArgReduce(std::size_t count, double initValue, Func&& func, Compare&& isBetter)
+{
+    ArgReduction result = {initValue, count};
+
+    #pragma omp parallel default(shared)
+    {
+        ArgReduction localResult = {initValue, count};
+
+        #pragma omp for nowait
+        for(std::size_t i = 0 ; i < count ; ++i)
+        {
+            const double value = func(i);
+            if(isBetter(value, localResult.value))
+                localResult = {value, i};
+        }
+
+        //Ties are broken by the index so that the result does not depend on the number of threads
+        #pragma omp critical
+        {
+            if(localResult.index < count &&
+               (isBetter(localResult.value, result.value) ||
+                (!isBetter(result.value, localResult.value) && localResult.index < result.index)))
+                result = localResult;
+        }
+    }
+
+    return result;
+}
+
+/// \param count The number of items.
+/// \param func Callable returning the value of item i.
+/// \return The minimum value and the smallest index at which it is reached.
+template<typename Func>
+inline ArgReduction parallelArgMin(std::size_t count, Func&& func)
+{
+    return parallelArgReduce(count, std::numeric_limits<double>::max(), func,
+                             [](double a, double b){ return a < b; });
+}
+
+/// \param count The number of items.
+/// \param func Callable returning the value of item i.
+/// \return The maximum value and the smallest index at which it is reached.
+template<typename Func>
+inline ArgReduction parallelArgMax(std::size_t count, Func&& func)
+{
+    return parallelArgReduce(count, std::numeric_limits<double>::lowest(), func,
+                             [](double a, double b){ return a > b; });
+}
+
+#endif // REDUCTION_HPP_INCLUDED
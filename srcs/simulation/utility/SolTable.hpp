@@ -92,6 +92,12 @@ class SolTable
             return obj.valid();
         }
 
+        bool isFunction(const std::string& propertyName) const
+        {
+            auto obj = m_tableInternal[propertyName];
+            return obj.get_type() == sol::type::function;
+        }
+
         void for_each(std::function<void(sol::object /*key*/, sol::object /*value*/)> f) const
         {
             return m_tableInternal.for_each(f);